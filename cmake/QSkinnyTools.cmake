@@ -3,12 +3,8 @@
 #           SPDX-License-Identifier: BSD-3-Clause
 ############################################################################
 
-## @param SVG_FILENAME absolute filename to the svg
-## @param QVG_FILENAME absolute filename to the qvg
-function(qsk_svg2qvg SVG_FILENAME QVG_FILENAME)
-    get_filename_component(QVG_FILENAME ${QVG_FILENAME} ABSOLUTE)
-    get_filename_component(SVG_FILENAME ${SVG_FILENAME} ABSOLUTE)
-
+# sets OUT_VAR to the command running svg2qvg, needs to be followed by the arguments
+function(_qsk_svg2qvg_command OUT_VAR)
     if(TARGET Qt6::Svg)
         set(QtSvgTarget Qt6::Svg)
     elseif(TARGET Qt5::Svg)
@@ -37,12 +33,144 @@ function(qsk_svg2qvg SVG_FILENAME QVG_FILENAME)
     else()
         message(FATAL "Unsupported operating system")
     endif()
-    
+
+    set(${OUT_VAR} ${script} ${Svg2QvgLocation} ${QtSvgTargetDirectory} PARENT_SCOPE)
+endfunction()
+
+# sets OUT_SVG_FILES/OUT_NAMES to the svg files/names of a directory or manifest
+function(_qsk_svg2qvg_inputs INPUT OUT_SVG_FILES OUT_NAMES)
+    set(svgFiles)
+    set(names)
+
+    # like svg2qvg the suffix is matched case insensitive
+    set(suffixRegex "\\.[sS][vV][gG]$")
+
+    if(IS_DIRECTORY ${INPUT})
+        file(GLOB_RECURSE allFiles RELATIVE ${INPUT} ${INPUT}/*)
+
+        set(relativeFiles)
+        foreach(relativeFile ${allFiles})
+            if(relativeFile MATCHES "${suffixRegex}")
+                list(APPEND relativeFiles ${relativeFile})
+            endif()
+        endforeach()
+
+        set(baseDirectory ${INPUT})
+    else()
+        # one svg file per line, relative to the manifest, '#' for comments
+        file(STRINGS ${INPUT} relativeFiles)
+        get_filename_component(baseDirectory ${INPUT} DIRECTORY)
+    endif()
+
+    foreach(relativeFile ${relativeFiles})
+        string(STRIP "${relativeFile}" relativeFile)
+        if(relativeFile STREQUAL "" OR relativeFile MATCHES "^#")
+            continue()
+        endif()
+
+        string(REGEX REPLACE "${suffixRegex}" "" name ${relativeFile})
+
+        list(APPEND svgFiles ${baseDirectory}/${relativeFile})
+        list(APPEND names ${name})
+    endforeach()
+
+    set(${OUT_SVG_FILES} ${svgFiles} PARENT_SCOPE)
+    set(${OUT_NAMES} ${names} PARENT_SCOPE)
+endfunction()
+
+## @param SVG_FILENAME absolute filename to the svg
+## @param QVG_FILENAME absolute filename to the qvg
+function(qsk_svg2qvg SVG_FILENAME QVG_FILENAME)
+    get_filename_component(QVG_FILENAME ${QVG_FILENAME} ABSOLUTE)
+    get_filename_component(SVG_FILENAME ${SVG_FILENAME} ABSOLUTE)
+
+    _qsk_svg2qvg_command(svg2qvg)
+
     add_custom_command(
-        COMMAND ${script} ${Svg2QvgLocation} ${SVG_FILENAME} ${QVG_FILENAME} ${QtSvgTargetDirectory}
+        COMMAND ${svg2qvg} ${SVG_FILENAME} ${QVG_FILENAME}
         OUTPUT ${QVG_FILENAME}
         DEPENDS ${SVG_FILENAME}
         COMMENT "Compiling ${SVG_FILENAME} to ${QVG_FILENAME}"        
         VERBATIM)
 endfunction()
 
+## Converting many svg files in one process using a thread pool
+## @param INPUT directory with svg files or a manifest with one svg file per line
+## @param QVG_DIRECTORY directory for the qvg files, keeping the relative paths
+function(qsk_svg2qvg_batch INPUT QVG_DIRECTORY)
+    get_filename_component(INPUT ${INPUT} ABSOLUTE)
+    get_filename_component(QVG_DIRECTORY ${QVG_DIRECTORY} ABSOLUTE)
+
+    _qsk_svg2qvg_command(svg2qvg)
+    _qsk_svg2qvg_inputs(${INPUT} svgFiles names)
+
+    set(dependencies ${svgFiles})
+    if(NOT IS_DIRECTORY ${INPUT})
+        list(APPEND dependencies ${INPUT})
+    endif()
+
+    set(qvgFiles)
+    foreach(name ${names})
+        list(APPEND qvgFiles ${QVG_DIRECTORY}/${name}.qvg)
+    endforeach()
+
+    add_custom_command(
+        COMMAND ${svg2qvg} -o ${QVG_DIRECTORY} ${INPUT}
+        OUTPUT ${qvgFiles}
+        DEPENDS ${dependencies}
+        COMMENT "Compiling the svg files of ${INPUT} to ${QVG_DIRECTORY}"
+        VERBATIM)
+endfunction()
+
+## Converting many svg files into a QskGraphicArchive
+## @param INPUT directory with svg files or a manifest with one svg file per line
+## @param ARCHIVE_FILENAME absolute filename of the archive
+function(qsk_svg2qvg_archive INPUT ARCHIVE_FILENAME)
+    get_filename_component(INPUT ${INPUT} ABSOLUTE)
+    get_filename_component(ARCHIVE_FILENAME ${ARCHIVE_FILENAME} ABSOLUTE)
+
+    _qsk_svg2qvg_command(svg2qvg)
+    _qsk_svg2qvg_inputs(${INPUT} svgFiles names)
+
+    set(dependencies ${svgFiles})
+    if(NOT IS_DIRECTORY ${INPUT})
+        list(APPEND dependencies ${INPUT})
+    endif()
+
+    add_custom_command(
+        COMMAND ${svg2qvg} -a ${ARCHIVE_FILENAME} ${INPUT}
+        OUTPUT ${ARCHIVE_FILENAME}
+        DEPENDS ${dependencies}
+        COMMENT "Compiling the svg files of ${INPUT} to ${ARCHIVE_FILENAME}"
+        VERBATIM)
+endfunction()
+
+## @param SKIN_NAME name of the skin, like "material3"
+## @param COLOR_SCHEME light or dark
+## @param HINTS_FILENAME absolute filename of the precompiled hint table
+## @param DEPENDS targets/files, f.e the plugin of the skin
+function(qsk_skin2hints SKIN_NAME COLOR_SCHEME HINTS_FILENAME)
+    cmake_parse_arguments(PARSE_ARGV 3 arg "" "" "DEPENDS")
+
+    get_filename_component(HINTS_FILENAME ${HINTS_FILENAME} ABSOLUTE)
+
+    if(TARGET skin2hints)
+        set(Skin2HintsLocation $<TARGET_FILE:skin2hints>)
+        set(Skin2HintsTarget skin2hints)
+    else()
+        find_program(Skin2HintsLocation skin2hints REQUIRED)
+    endif()
+
+    # the skins are loaded as plugins. As we don't need to show anything
+    # we can avoid the costs of initializing a platform. Metrics in dp/px
+    # are stored unconverted and get converted, when loading the file
+
+    add_custom_command(
+        COMMAND ${CMAKE_COMMAND} -E env
+            QSK_PLUGIN_PATH=${CMAKE_BINARY_DIR}/plugins QT_QPA_PLATFORM=offscreen
+            ${Skin2HintsLocation} ${SKIN_NAME} ${COLOR_SCHEME} ${HINTS_FILENAME}
+        OUTPUT ${HINTS_FILENAME}
+        DEPENDS ${Skin2HintsTarget} ${arg_DEPENDS}
+        COMMENT "Compiling the ${SKIN_NAME} ( ${COLOR_SCHEME} ) skin to ${HINTS_FILENAME}"
+        VERBATIM)
+endfunction()
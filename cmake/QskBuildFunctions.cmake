@@ -110,6 +110,25 @@ function(qsk_add_example target)
 
 endfunction()
 
+function(qsk_add_test target)
+
+    qsk_add_executable(${target} ${ARGN})
+
+    set_target_properties(${target} PROPERTIES FOLDER tests)
+
+    set_target_properties(${target} PROPERTIES
+        RUNTIME_OUTPUT_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}/../bin )
+
+    target_link_libraries(${target} PRIVATE qskinny qsktestcommon Qt::Test)
+
+    add_test(NAME ${target} COMMAND ${target})
+
+    # the tests do not show any window
+    set_tests_properties(${target} PROPERTIES
+        ENVIRONMENT "QT_QPA_PLATFORM=offscreen")
+
+endfunction()
+
 function(qsk_add_shaders target)
 
     cmake_parse_arguments( arg "" "" "FILES" ${ARGN} )
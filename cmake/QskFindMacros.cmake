@@ -34,6 +34,10 @@ macro(qsk_setup_Qt)
         find_package(Qt${QT_VERSION_MAJOR} REQUIRED COMPONENTS Svg)
     endif()
 
+    if( BUILD_TESTS )
+        find_package(Qt${QT_VERSION_MAJOR} REQUIRED COMPONENTS Test)
+    endif()
+
     if( BUILD_EXAMPLES OR BUILD_PLAYGROUND )
         # On embedded systems you often find optimized Qt installations without
         # Qt/Widgets support. QSkinny itself does not need Qt/Widgets - however
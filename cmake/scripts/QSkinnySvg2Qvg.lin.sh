@@ -1,7 +1,9 @@
 #!/bin/bash
 
+# usage: QSkinnySvg2Qvg.lin.sh svg2qvg qtlibdir [svg2qvg arguments ...]
+
 SVG2QVG=$1
-SVG=$2
-QVG=$3
+QTLIBDIR=$2
+shift 2
 
-LD_LIBRARY_PATH=$4:$LD_LIBRARY_PATH $SVG2QVG $SVG $QVG
\ No newline at end of file
+LD_LIBRARY_PATH=$QTLIBDIR:$LD_LIBRARY_PATH $SVG2QVG "$@"
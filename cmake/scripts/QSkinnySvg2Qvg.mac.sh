@@ -1,10 +1,12 @@
 #!/bin/bash
 
+# usage: QSkinnySvg2Qvg.mac.sh svg2qvg qtlibdir [svg2qvg arguments ...]
+
 SVG2QVG=$1
-SVG=$2
-QVG=$3
+QTLIBDIR=$2
+shift 2
 
-export DYLD_LIBRARY_PATH=$4:$DYLD_LIBRARY_PATH
+export DYLD_LIBRARY_PATH=$QTLIBDIR:$DYLD_LIBRARY_PATH
 otool -L $SVG2QVG
 
-DYLD_LIBRARY_PATH=$4:$DYLD_LIBRARY_PATH $SVG2QVG $SVG $QVG
\ No newline at end of file
+DYLD_LIBRARY_PATH=$QTLIBDIR:$DYLD_LIBRARY_PATH $SVG2QVG "$@"
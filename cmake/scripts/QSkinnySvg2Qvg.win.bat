@@ -1,6 +1,6 @@
+rem usage: QSkinnySvg2Qvg.win.bat svg2qvg qtlibdir [svg2qvg arguments ...]
+
 set SVG2QVG=%1
-set SVG=%2
-set QVG=%3
-set PATH=%4;%PATH%
+set PATH=%2;%PATH%
 
-%SVG2QVG% %SVG% %QVG%
\ No newline at end of file
+%SVG2QVG% %3 %4 %5 %6 %7 %8 %9
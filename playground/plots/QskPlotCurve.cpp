@@ -113,6 +113,17 @@ void QskPlotCurve::transformationChanged( ChangeFlags flags )
          */
     }
 
+    if ( flags & CanvasGeometryChanged )
+    {
+        // the level of detail of MonotonicX curves depends on the canvas size
+        auto data = m_data->curveData.data();
+        if ( data && ( data->hints() & QskPlotCurveData::MonotonicX ) )
+        {
+            markDirty();
+            return;
+        }
+    }
+
     Inherited::transformationChanged( flags );
 }
 
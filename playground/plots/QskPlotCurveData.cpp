@@ -262,6 +262,33 @@ QPointF QskPlotCurveData::interpolatedPoint(
     }
 }
 
+void QskPlotCurveData::yExtrema( qsizetype from, qsizetype to,
+    qsizetype& minIndex, qsizetype& maxIndex ) const
+{
+    minIndex = maxIndex = from;
+
+    auto yMin = pointAt( from ).y();
+    auto yMax = yMin;
+
+    for ( auto i = from + 1; i <= to; i++ )
+    {
+        const auto y = pointAt( i ).y();
+
+        if ( y < yMin )
+        {
+            yMin = y;
+            minIndex = i;
+        }
+        else if ( y > yMax )
+        {
+            yMax = y;
+            maxIndex = i;
+        }
+    }
+}
+
+static const qsizetype qskPyramidBlockSize = 16;
+
 QskPlotCurvePoints::QskPlotCurvePoints( QObject* parent )
     : QskPlotCurveData( parent )
 {
@@ -272,6 +299,7 @@ QskPlotCurvePoints::QskPlotCurvePoints(
     : QskPlotCurveData( parent )
     , m_points( points )
 {
+    updatePyramid();
 }
 
 void QskPlotCurvePoints::setPoints( const QVector< QPointF >& points )
@@ -279,7 +307,110 @@ void QskPlotCurvePoints::setPoints( const QVector< QPointF >& points )
     m_points = points;
     m_boundingRect = QRectF(); // invalidating
 
+    updatePyramid();
+
     Q_EMIT changed();
 }
 
+void QskPlotCurvePoints::updatePyramid()
+{
+    m_pyramid.clear();
+
+    const auto points = m_points.constData();
+    const auto count = m_points.count();
+
+    if ( count < 2 * qskPyramidBlockSize )
+        return;
+
+    {
+        QVector< Extrema > level;
+        level.reserve( count / qskPyramidBlockSize );
+
+        for ( qsizetype i = 0; i + qskPyramidBlockSize <= count; i += qskPyramidBlockSize )
+        {
+            Extrema extrema { i, i };
+
+            for ( auto j = i + 1; j < i + qskPyramidBlockSize; j++ )
+            {
+                if ( points[j].y() < points[ extrema.minIndex ].y() )
+                    extrema.minIndex = j;
+                else if ( points[j].y() > points[ extrema.maxIndex ].y() )
+                    extrema.maxIndex = j;
+            }
+
+            level += extrema;
+        }
+
+        m_pyramid += level;
+    }
+
+    while ( m_pyramid.last().count() >= 4 )
+    {
+        const auto& lower = m_pyramid.last();
+
+        QVector< Extrema > level;
+        level.reserve( lower.count() / 2 );
+
+        for ( qsizetype i = 0; i + 1 < lower.count(); i += 2 )
+        {
+            const auto& e1 = lower[i];
+            const auto& e2 = lower[i + 1];
+
+            const auto minIndex = ( points[ e2.minIndex ].y() < points[ e1.minIndex ].y() )
+                ? e2.minIndex : e1.minIndex;
+
+            const auto maxIndex = ( points[ e2.maxIndex ].y() > points[ e1.maxIndex ].y() )
+                ? e2.maxIndex : e1.maxIndex;
+
+            level += Extrema { minIndex, maxIndex };
+        }
+
+        m_pyramid += level;
+    }
+}
+
+void QskPlotCurvePoints::yExtrema( qsizetype from, qsizetype to,
+    qsizetype& minIndex, qsizetype& maxIndex ) const
+{
+    const auto points = m_points.constData();
+
+    minIndex = maxIndex = from;
+
+    auto update = [&]( qsizetype iMin, qsizetype iMax )
+    {
+        if ( points[ iMin ].y() < points[ minIndex ].y() )
+            minIndex = iMin;
+
+        if ( points[ iMax ].y() > points[ maxIndex ].y() )
+            maxIndex = iMax;
+    };
+
+    auto i = from;
+    while ( i <= to )
+    {
+        // the largest block starting at i, that is inside of the range
+        int level = m_pyramid.count() - 1;
+        qsizetype blockSize = ( level >= 0 ) ? ( qskPyramidBlockSize << level ) : 0;
+
+        while ( level >= 0 && ( ( i % blockSize ) || ( i + blockSize - 1 > to ) ) )
+        {
+            level--;
+            blockSize >>= 1;
+        }
+
+        if ( level >= 0 )
+        {
+            const auto& extrema = m_pyramid[ level ][ i / blockSize ];
+            update( extrema.minIndex, extrema.maxIndex );
+
+            i += blockSize;
+        }
+        else
+        {
+            update( i, i );
+            i++;
+        }
+    }
+}
+
 #include "moc_QskPlotCurveData.cpp"
@@ -51,6 +51,16 @@ class QskPlotCurveData : public QObject
     int upperIndex( Qt::Orientation, qreal value ) const;
     QPointF interpolatedPoint( Qt::Orientation, qreal value ) const;
 
+    /*
+        Indexes of the points with the minimum/maximum y coordinate
+        in [from, to]. Used for decimating curves with MonotonicX, when
+        many points fall into the same pixel column.
+
+        The default implementation iterates over all points.
+     */
+    virtual void yExtrema( qsizetype from, qsizetype to,
+        qsizetype& minIndex, qsizetype& maxIndex ) const;
+
   Q_SIGNALS:
     void changed();
 
@@ -85,8 +95,25 @@ class QskPlotCurvePoints : public QskPlotCurveData
     qsizetype count() const override;
     QPointF pointAt( qsizetype index ) const override;
 
+    void yExtrema( qsizetype from, qsizetype to,
+        qsizetype& minIndex, qsizetype& maxIndex ) const override;
+
   private:
+    void updatePyramid();
+
     QVector< QPointF > m_points;
+
+    /*
+        Extrema of blocks of 16, 32, 64 ... points, so that finding
+        the extrema of a range needs O(log n) lookups only.
+     */
+    struct Extrema
+    {
+        qsizetype minIndex;
+        qsizetype maxIndex;
+    };
+
+    QVector< QVector< Extrema > > m_pyramid;
 };
 
 inline QVector< QPointF > QskPlotCurvePoints::points() const
@@ -6,15 +6,71 @@
 #include "QskPlotCurveSkinlet.h"
 #include "QskPlotCurveData.h"
 #include "QskPlotCurve.h"
+#include "QskPlotView.h"
 
 #include <QskSGNode.h>
 #include <QskVertex.h>
 
 #include <qsggeometry.h>
 #include <qsgvertexcolormaterial.h>
+#include <qquickwindow.h>
+
+#include <cmath>
 
 namespace
 {
+    /*
+        Points of a MonotonicX curve, that fall into the same pixel column
+        are reduced to the first, the last and the points with the
+        minimum/maximum y coordinate. The columns are aligned to multiples
+        of the resolution, so that the result is stable when panning.
+     */
+    void appendDecimatedPoints( const QskPlotCurveData* data,
+        int from, int to, qreal resolution, QVector< QPointF >& points )
+    {
+        int i = from;
+
+        while ( i <= to )
+        {
+            const auto x = data->pointAt( i ).x();
+            const auto columnEnd = ( std::floor( x / resolution ) + 1.0 ) * resolution;
+
+            int j = data->upperIndex( Qt::Horizontal, columnEnd );
+            if ( j < 0 || j > to + 1 )
+                j = to + 1;
+
+            j = qMax( j, i + 1 );
+
+            const int last = j - 1;
+
+            if ( last - i < 2 )
+            {
+                for ( int k = i; k <= last; k++ )
+                    points += data->pointAt( k );
+            }
+            else
+            {
+                qsizetype minIndex, maxIndex;
+                data->yExtrema( i, last, minIndex, maxIndex );
+
+                if ( minIndex > maxIndex )
+                    qSwap( minIndex, maxIndex );
+
+                points += data->pointAt( i );
+
+                if ( minIndex != i && minIndex != last )
+                    points += data->pointAt( minIndex );
+
+                if ( maxIndex != minIndex && maxIndex != last )
+                    points += data->pointAt( maxIndex );
+
+                points += data->pointAt( last );
+            }
+
+            i = j;
+        }
+    }
+
     class CurveNode : public QSGGeometryNode
     {
       public:
@@ -26,7 +82,7 @@ namespace
         }
 
         void updateCurve( const QRectF& scaleRect, const QskPlotCurveData* data,
-            const QColor& color, qreal lineWidth )
+            const QColor& color, qreal lineWidth, qreal resolution )
         {
             m_geometry.setDrawingMode( QSGGeometry::DrawLineStrip );
 
@@ -93,6 +149,30 @@ namespace
                 }
             }
 
+            if ( ( data->hints() & QskPlotCurveData::MonotonicX ) && ( resolution > 0.0 ) )
+            {
+                const auto columns = ( point2.x() - point1.x() ) / resolution;
+
+                if ( to - from > 4 * columns )
+                {
+                    QVector< QPointF > points;
+                    points.reserve( 4 * ( int( columns ) + 2 ) );
+
+                    points += point1;
+                    appendDecimatedPoints( data, from + 1, to - 1, resolution, points );
+                    points += point2;
+
+                    m_geometry.allocate( points.count() );
+
+                    auto p = m_geometry.vertexDataAsColoredPoint2D();
+                    for ( const auto& point : std::as_const( points ) )
+                        p++->set( point.x(), point.y(), c.r, c.g, c.b, c.a );
+
+                    markDirty( QSGNode::DirtyGeometry );
+                    return;
+                }
+            }
+
             m_geometry.allocate( to - from + 1 );
 
             auto p = m_geometry.vertexDataAsColoredPoint2D();
@@ -154,8 +234,25 @@ QSGNode* QskPlotCurveSkinlet::updatePolygonNode(
     if ( lineWidth <= 0.0 )
         return nullptr;
 
+    // the width of a device pixel in plot coordinates
+    qreal resolution = 0.0;
+
+    if ( curveData->hints() & QskPlotCurveData::MonotonicX )
+    {
+        qreal ratio = 1.0;
+        if ( auto view = curve->view() )
+        {
+            if ( auto window = view->window() )
+                ratio = window->effectiveDevicePixelRatio();
+        }
+
+        const auto pixelsPerUnit = qAbs( curve->transformation().m11() ) * ratio;
+        if ( pixelsPerUnit > 0.0 )
+            resolution = 1.0 / pixelsPerUnit;
+    }
+
     auto curveNode = QskSGNode::ensureNode< CurveNode >( node );
-    curveNode->updateCurve( curve->scaleRect(), curveData, color, lineWidth );
+    curveNode->updateCurve( curve->scaleRect(), curveData, color, lineWidth, resolution );
 
     return curveNode;
 }
@@ -73,8 +73,20 @@ static inline qreal qskRoundedDpi( qreal dpi )
     return 640.0; // xxxhdpi
 }   
 
+static inline qreal qskEnvironmentFactor( const char* envName )
+{
+    bool ok;
+    const auto factor = qEnvironmentVariable( envName ).toDouble( &ok );
+
+    return ( ok && factor > 0.0 ) ? factor : -1.0;
+}
+
 qreal qskDpToPixelsFactor()
 {
+    static const qreal envFactor = qskEnvironmentFactor( "QSK_DP_FACTOR" );
+    if ( envFactor > 0.0 )
+        return envFactor;
+
     if ( const auto screen = QGuiApplication::primaryScreen() )
         return qskRoundedDpi( screen->physicalDotsPerInch() ) / 160.0;
 
@@ -83,6 +95,10 @@ qreal qskDpToPixelsFactor()
 
 qreal qskPxToPixelsFactor()
 {
+    static const qreal envFactor = qskEnvironmentFactor( "QSK_PX_FACTOR" );
+    if ( envFactor > 0.0 )
+        return envFactor;
+
     if ( const auto screen = QGuiApplication::primaryScreen() )
         return screen->physicalDotsPerInch() / 96.0;
 
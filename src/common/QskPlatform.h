@@ -28,6 +28,9 @@ QSK_EXPORT const QPlatformTheme* qskPlatformTheme();
     on a medium-density screen ( 160 dpi ). 
 
     One px is equivalent to 1/96th of an inch.
+
+    The factors can be overridden by QSK_DP_FACTOR/QSK_PX_FACTOR,
+    what is f.e used by skin2hints.
  */
 
 QSK_EXPORT qreal qskDpToPixelsFactor();
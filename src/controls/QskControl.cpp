@@ -26,6 +26,9 @@ QSK_SYSTEM_STATE( QskControl, Disabled, QskAspect::FirstSystemState )
 QSK_SYSTEM_STATE( QskControl, Hovered, QskAspect::LastSystemState >> 1 )
 QSK_SYSTEM_STATE( QskControl, Focused, QskAspect::LastSystemState )
 
+// from QskSkinTransition.cpp
+extern void qskUpdateControlIndex( const QskControl*, bool isDestroyed );
+
 static inline void qskSendEventTo( QObject* object, QEvent::Type type )
 {
     QEvent event( type );
@@ -54,11 +57,15 @@ QskControl::QskControl( QQuickItem* parent )
         // inheriting attributes from parent
         QskControlPrivate::resolveLocale( this );
         QskControlPrivate::resolveSection( this );
+
+        qskUpdateControlIndex( this, false );
     }
 }
 
 QskControl::~QskControl()
 {
+    qskUpdateControlIndex( this, true );
+
 #if defined( QT_DEBUG )
     if ( auto w = window() )
     {
@@ -600,7 +607,8 @@ QSizeF QskControl::implicitSizeHint(
     }
     else
     {
-        hint = d_func()->implicitSizeHint( whichHint, constraint );
+        // invalidated by resetImplicitSize()
+        hint = d_func()->cachedImplicitSizeHint( whichHint, constraint );
     }
 
     return hint;
@@ -882,6 +890,11 @@ void QskControl::itemChange( QQuickItem::ItemChange change,
             setSkinStateFlag( Focused, hasActiveFocus() );
             break;
         }
+        case QQuickItem::ItemSceneChange:
+        {
+            qskUpdateControlIndex( this, false );
+            break;
+        }
     }
 
     Inherited::itemChange( change, value );
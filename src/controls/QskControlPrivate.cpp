@@ -118,6 +118,56 @@ void qskInheritSection( QskControl* control, QskAspect::Section section )
     QskObjectTree::traverseDown( control, visitor );
 }
 
+/*
+    Layout engines ask for the same constrained hints several times
+    during one polish cycle: f.e heightForWidth of a word wrapped label.
+    A couple of entries are sufficient to avoid most of the
+    recalculations.
+ */
+class QskControlPrivate::SizeHintCache
+{
+  public:
+    enum { Capacity = 4 };
+
+    class Entry
+    {
+      public:
+        QSizeF constraint;
+        QSizeF hint;
+        Qt::SizeHint which = Qt::MinimumSize;
+    };
+
+    const QSizeF* find( Qt::SizeHint which, const QSizeF& constraint ) const
+    {
+        for ( int i = 0; i < count; i++ )
+        {
+            const auto& entry = entries[ i ];
+
+            if ( ( entry.which == which ) && ( entry.constraint == constraint ) )
+                return &entry.hint;
+        }
+
+        return nullptr;
+    }
+
+    void insert( Qt::SizeHint which, const QSizeF& constraint, const QSizeF& hint )
+    {
+        auto& entry = entries[ next ];
+
+        entry.which = which;
+        entry.constraint = constraint;
+        entry.hint = hint;
+
+        next = ( next + 1 ) % Capacity;
+        count = qMin( count + 1, int( Capacity ) );
+    }
+
+    Entry entries[ Capacity ];
+
+    int count = 0;
+    int next = 0;
+};
+
 /*
     Qt 5.12:
         sizeof( QQuickItemPrivate::ExtraData ) -> 184
@@ -143,6 +193,7 @@ void qskInheritSection( QskControl* control, QskAspect::Section section )
 
 QskControlPrivate::QskControlPrivate()
     : explicitSizeHints( nullptr )
+    , sizeHintCache( nullptr )
     , sizePolicy( QskSizePolicy::Preferred, QskSizePolicy::Preferred )
     , visiblePlacementPolicy( 0 )
     , hiddenPlacementPolicy( 0 )
@@ -157,10 +208,13 @@ QskControlPrivate::QskControlPrivate()
 QskControlPrivate::~QskControlPrivate()
 {
     delete [] explicitSizeHints;
+    delete sizeHintCache;
 }
 
 void QskControlPrivate::layoutConstraintChanged()
 {
+    invalidateSizeHintCache();
+
     if ( !blockLayoutRequestEvents )
     {
         Inherited::layoutConstraintChanged();
@@ -184,9 +238,37 @@ void QskControlPrivate::implicitSizeChanged()
 
 QSizeF QskControlPrivate::implicitSizeHint() const
 {
+    // recalculating the implicit size invalidates all other hints as well
+    invalidateSizeHintCache();
+
     return implicitSizeHint( Qt::PreferredSize, QSizeF() );
 }
 
+QSizeF QskControlPrivate::cachedImplicitSizeHint(
+    Qt::SizeHint which, const QSizeF& constraint ) const
+{
+    if ( sizeHintCache )
+    {
+        if ( auto hint = sizeHintCache->find( which, constraint ) )
+            return *hint;
+    }
+    else
+    {
+        sizeHintCache = new SizeHintCache();
+    }
+
+    const auto hint = implicitSizeHint( which, constraint );
+    sizeHintCache->insert( which, constraint, hint );
+
+    return hint;
+}
+
+void QskControlPrivate::invalidateSizeHintCache() const
+{
+    if ( sizeHintCache )
+        sizeHintCache->count = sizeHintCache->next = 0;
+}
+
 QSizeF QskControlPrivate::implicitSizeHint(
     Qt::SizeHint which, const QSizeF& constraint ) const
 {
@@ -19,22 +19,74 @@ static inline bool qskIsUpdateBlocked( const QQuickItem* item )
             return qskItem->testUpdateFlag( QskItem::DeferredUpdate );
     }
 
-#if 0
+    return false;
+}
+
+static bool qskIsOffscreen( const QQuickItem* item )
+{
+    const auto itemRect = item->mapRectToScene( item->boundingRect() );
+    if ( itemRect.isEmpty() )
+        return false;
+
+    const auto window = item->window();
+    QRectF visibleRect( 0.0, 0.0, window->width(), window->height() );
+
     /*
-        Blocking items, that are outside the window would be easy,
-        but we have not yet found a performant way to send update notifications
-        when an item enters/leaves the window. TODO ...
+        Clipping ancestors - f.e. the viewport of a QskScrollArea -
+        reduce the visible area further.
      */
-    else if ( const auto control = qskControlCast( item ) )
+    for ( auto parent = item->parentItem(); parent; parent = parent->parentItem() )
     {
-        const QRectF itemRect( item->mapToScene( QPointF() ), item->size() );
-        const QRectF sceneRect( 0, 0, item->window()->width(), item->window()->height() );
+        if ( parent->clip() )
+        {
+            visibleRect &= parent->mapRectToScene( parent->clipRect() );
+            if ( visibleRect.isEmpty() )
+                return true;
+        }
+    }
 
-        return !itemRect.intersects( sceneRect );
+    return !itemRect.intersects( visibleRect );
+}
+
+static inline bool qskIsCullable( const QQuickItem* item )
+{
+    auto qskItem = qobject_cast< const QskItem* >( item );
+    if ( qskItem == nullptr
+        || !qskItem->testUpdateFlag( QskItem::DeferredOffscreenUpdate ) )
+    {
+        return false;
     }
-#endif
 
-    return false;
+    /*
+        Only content updates can be postponed. Changes of the transformation,
+        opacity or the children need to be synchronized, as they affect
+        the nodes of the child items, that might be inside of the window.
+     */
+    const auto dirty = QQuickItemPrivate::get( item )->dirtyAttributes;
+    if ( dirty & ~QQuickItemPrivate::ContentUpdateMask )
+        return false;
+
+    return qskIsOffscreen( item );
+}
+
+static inline void qskAppendToDirtyList( QQuickWindow* window, QQuickItem* item )
+{
+    /*
+        Like QQuickItemPrivate::addToDirtyList, but without scheduling
+        another frame, as we are already in the middle of one.
+     */
+    auto d = QQuickItemPrivate::get( item );
+    if ( d->prevDirtyItem )
+        return;
+
+    auto wd = QQuickWindowPrivate::get( window );
+
+    d->nextDirtyItem = wd->dirtyItemList;
+    if ( d->nextDirtyItem )
+        QQuickItemPrivate::get( d->nextDirtyItem )->prevDirtyItem = &d->nextDirtyItem;
+
+    d->prevDirtyItem = &wd->dirtyItemList;
+    wd->dirtyItemList = item;
 }
 
 static inline void qskBlockDirty( QQuickItem* item, bool on )
@@ -97,13 +149,28 @@ void QskDirtyItemFilter::addWindow( QQuickWindow* window )
         window, [ this, window ] { beforeSynchronizing( window ); },
         Qt::DirectConnection );
 
+    m_culledItems.insert( window, QSet< QskItem* >() );
+
     connect( window, &QObject::destroyed,
-        this, [ this, window ] { m_windows.remove( window ); } );
+        this, [ this, window ]
+        {
+            m_windows.remove( window );
+            m_culledItems.remove( window );
+        } );
+}
+
+void QskDirtyItemFilter::removeItem( QskItem* item )
+{
+    for ( auto it = m_culledItems.begin(); it != m_culledItems.end(); ++it )
+        it.value().remove( item );
 }
 
 void QskDirtyItemFilter::beforeSynchronizing( QQuickWindow* window )
 {
+    flushCulledItems( window );
+
     filterDirtyList( window, qskIsUpdateBlocked );
+    cullDirtyList( window );
 
     if ( QQuickWindowPrivate::get( window )->renderer == nullptr )
     {
@@ -137,3 +204,62 @@ void QskDirtyItemFilter::filterDirtyList(
         item = nextItem;
     }
 }
+
+void QskDirtyItemFilter::flushCulledItems( QQuickWindow* window )
+{
+    /*
+        Everything, that might move a culled item into the visible area
+        ( scrolling, resizing the window, changing the geometry of
+        the item or one of its ancestors ) triggers a new frame and
+        we end up here.
+     */
+    auto it = m_culledItems.find( window );
+    if ( it == m_culledItems.end() || it->isEmpty() )
+        return;
+
+    auto& items = it.value();
+    for ( auto itemIt = items.begin(); itemIt != items.end(); )
+    {
+        auto item = *itemIt;
+
+        if ( item->window() != window )
+        {
+            // moved to another window, where it is dirty anyway
+            itemIt = items.erase( itemIt );
+            continue;
+        }
+
+        if ( item->testUpdateFlag( QskItem::DeferredOffscreenUpdate )
+            && qskIsOffscreen( item ) )
+        {
+            ++itemIt;
+            continue;
+        }
+
+        if ( QQuickItemPrivate::get( item )->dirtyAttributes )
+            qskAppendToDirtyList( window, item );
+
+        itemIt = items.erase( itemIt );
+    }
+}
+
+void QskDirtyItemFilter::cullDirtyList( QQuickWindow* window )
+{
+    auto it = m_culledItems.find( window );
+    if ( it == m_culledItems.end() )
+        return;
+
+    auto d = QQuickWindowPrivate::get( window );
+    for ( auto item = d->dirtyItemList; item != nullptr; )
+    {
+        auto nextItem = QQuickItemPrivate::get( item )->nextDirtyItem;
+
+        if ( qskIsCullable( item ) )
+        {
+            QQuickItemPrivate::get( item )->removeFromDirtyList();
+            it->insert( static_cast< QskItem* >( item ) );
+        }
+
+        item = nextItem;
+    }
+}
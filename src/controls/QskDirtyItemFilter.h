@@ -10,9 +10,11 @@
 
 #include <qobject.h>
 #include <qset.h>
+#include <qhash.h>
 
 class QQuickWindow;
 class QQuickItem;
+class QskItem;
 
 class QskDirtyItemFilter : public QObject
 {
@@ -23,6 +25,7 @@ class QskDirtyItemFilter : public QObject
     ~QskDirtyItemFilter() override;
 
     void addWindow( QQuickWindow* window );
+    void removeItem( QskItem* );
 
     static void filterDirtyList( QQuickWindow*,
         bool ( *isBlocked )( const QQuickItem* ) );
@@ -30,7 +33,18 @@ class QskDirtyItemFilter : public QObject
   private:
     void beforeSynchronizing( QQuickWindow* );
 
+    void flushCulledItems( QQuickWindow* );
+    void cullDirtyList( QQuickWindow* );
+
     QSet< QObject* > m_windows;
+
+    /*
+        Items with pending content updates, that have been taken
+        from the dirty list as being outside of the visible area.
+        The sets are only accessed, when the GUI thread is blocked:
+        during synchronizing or from the GUI thread itself.
+     */
+    QHash< const QQuickWindow*, QSet< QskItem* > > m_culledItems;
 };
 
 #endif
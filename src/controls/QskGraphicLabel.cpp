@@ -24,6 +24,8 @@ class QskGraphicLabel::PrivateData
         , mirror( false )
         , isSourceDirty( !sourceUrl.isEmpty() )
         , hasPanel( false )
+        , isAsynchronous( false )
+        , isLoading( false )
     {
     }
 
@@ -34,6 +36,11 @@ class QskGraphicLabel::PrivateData
     bool mirror : 1;
     bool isSourceDirty : 1;
     bool hasPanel : 1;
+    bool isAsynchronous : 1;
+    bool isLoading : 1;
+
+    // identifying the most recent asynchronous load operation
+    quint32 loadId = 0;
 };
 
 QskGraphicLabel::QskGraphicLabel( const QUrl& source, QQuickItem* parent )
@@ -84,6 +91,20 @@ bool QskGraphicLabel::hasPanel() const
     return m_data->hasPanel;
 }
 
+void QskGraphicLabel::setAsynchronous( bool on )
+{
+    if ( on == m_data->isAsynchronous )
+        return;
+
+    m_data->isAsynchronous = on;
+    Q_EMIT asynchronousChanged( on );
+}
+
+bool QskGraphicLabel::isAsynchronous() const
+{
+    return m_data->isAsynchronous;
+}
+
 bool QskGraphicLabel::isEmpty() const
 {
     return m_data->graphic.isNull() && m_data->source.isEmpty();
@@ -106,6 +127,7 @@ void QskGraphicLabel::setSource( const QUrl& url )
 
     m_data->graphic.reset();
     m_data->isSourceDirty = true;
+    m_data->isLoading = false;
     m_data->source = url;
 
     resetImplicitSize();
@@ -137,6 +159,7 @@ void QskGraphicLabel::setGraphic( const QskGraphic& graphic )
 
     // in case we have a sequence setting a source and a graphic later
     m_data->isSourceDirty = false;
+    m_data->isLoading = false;
 
     if ( !m_data->source.isEmpty() )
     {
@@ -255,11 +278,50 @@ QskGraphic QskGraphicLabel::loadSource( const QUrl& url ) const
 void QskGraphicLabel::updateResources()
 {
     if ( !m_data->source.isEmpty() && m_data->isSourceDirty )
-        m_data->graphic = loadSource( m_data->source );
+    {
+        if ( m_data->isAsynchronous )
+            startLoading();
+        else
+            m_data->graphic = loadSource( m_data->source );
+    }
 
     m_data->isSourceDirty = false;
 }
 
+void QskGraphicLabel::startLoading()
+{
+    m_data->isLoading = true;
+
+    const auto loadId = ++m_data->loadId;
+
+    /*
+        The label is the context of the request: the callback is
+        not invoked, when the label has been deleted in the meantime.
+     */
+    Qsk::loadGraphicAsync( m_data->source, this,
+        [ this, loadId ]( const QskGraphic& graphic )
+        { graphicLoaded( loadId, graphic ); } );
+}
+
+void QskGraphicLabel::graphicLoaded( quint32 loadId, const QskGraphic& graphic )
+{
+    if ( !m_data->isLoading || loadId != m_data->loadId )
+        return; // outdated
+
+    m_data->isLoading = false;
+
+    const auto strutSize = graphicStrutSize();
+    const bool keepImplicitSize = ( strutSize.width() >= 0.0 && strutSize.height() >= 0.0 )
+        || ( m_data->graphic.defaultSize() == graphic.defaultSize() );
+
+    m_data->graphic = graphic;
+
+    if ( !keepImplicitSize )
+        resetImplicitSize();
+
+    update();
+}
+
 QSizeF QskGraphicLabel::effectiveSourceSize() const
 {
     const auto strutSize = graphicStrutSize();
@@ -270,13 +332,23 @@ QSizeF QskGraphicLabel::effectiveSourceSize() const
         return strutSize;
     }
 
-    if ( !m_data->source.isEmpty() && m_data->isSourceDirty )
+    if ( !m_data->source.isEmpty() && m_data->isSourceDirty
+        && !m_data->isAsynchronous )
     {
         // we have to load to know about the geometry
         m_data->graphic = loadSource( m_data->source );
         m_data->isSourceDirty = false;
     }
 
+    /*
+        In asynchronous mode loading is started from updateResources
+        and the strut size is the placeholder until the graphic has arrived
+     */
+    if ( ( m_data->isLoading || m_data->isSourceDirty ) && m_data->graphic.isNull() )
+    {
+        return strutSize.expandedTo( QSizeF( 0.0, 0.0 ) );
+    }
+
     QSizeF sz( 0, 0 );
     if ( !m_data->graphic.isEmpty() )
     {
@@ -333,6 +405,9 @@ void QskGraphicLabel::changeEvent( QEvent* event )
         {
             // we might need to reload from a different skin
             m_data->isSourceDirty = true;
+
+            if ( m_data->isAsynchronous )
+                polish();
         }
     }
 
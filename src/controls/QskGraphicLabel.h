@@ -35,6 +35,9 @@ class QSK_EXPORT QskGraphicLabel : public QskControl
     Q_PROPERTY( bool panel READ hasPanel
         WRITE setPanel NOTIFY panelChanged )
 
+    Q_PROPERTY( bool asynchronous READ isAsynchronous
+        WRITE setAsynchronous NOTIFY asynchronousChanged )
+
     using Inherited = QskControl;
 
   public:
@@ -92,6 +95,15 @@ class QSK_EXPORT QskGraphicLabel : public QskControl
     void setPanel( bool );
     bool hasPanel() const;
 
+    /*
+        In asynchronous mode the source is loaded in a worker thread
+        ( see Qsk::loadGraphicAsync ) and the label is laid out according
+        to the graphicStrutSize until the graphic has arrived.
+        loadSource() is not called in this mode.
+     */
+    void setAsynchronous( bool );
+    bool isAsynchronous() const;
+
   Q_SIGNALS:
     void sourceChanged();
     void mirrorChanged();
@@ -100,6 +112,7 @@ class QSK_EXPORT QskGraphicLabel : public QskControl
     void alignmentChanged( Qt::Alignment );
     void fillModeChanged( FillMode );
     void panelChanged( bool );
+    void asynchronousChanged( bool );
 
   public Q_SLOTS:
     void setGraphic( const QskGraphic& );
@@ -112,6 +125,9 @@ class QSK_EXPORT QskGraphicLabel : public QskControl
     virtual QskGraphic loadSource( const QUrl& ) const;
 
   private:
+    void startLoading();
+    void graphicLoaded( quint32 loadId, const QskGraphic& );
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
@@ -52,13 +52,18 @@ static inline void qskApplyUpdateFlags(
     d->applyUpdateFlags( flags );
 }
 
+static inline QskDirtyItemFilter* qskItemFilter()
+{
+    static QskDirtyItemFilter itemFilter;
+    return &itemFilter;
+}
+
 static inline void qskFilterWindow( QQuickWindow* window )
 {
     if ( window == nullptr )
         return;
 
-    static QskDirtyItemFilter itemFilter;
-    itemFilter.addWindow( window );
+    qskItemFilter()->addWindow( window );
 }
 
 namespace
@@ -235,7 +240,7 @@ QskItem::QskItem( QskItemPrivate& dd, QQuickItem* parent )
     setFlag( QQuickItem::ItemHasContents, true );
     Inherited::setActiveFocusOnTab( false );
 
-    if ( dd.updateFlags & QskItem::DeferredUpdate )
+    if ( dd.updateFlags & ( QskItem::DeferredUpdate | QskItem::DeferredOffscreenUpdate ) )
         qskFilterWindow( window() );
 
     qskRegistry->insert( this );
@@ -255,6 +260,9 @@ QskItem::~QskItem()
      */
     d_func()->componentComplete = false;
 
+    if ( d_func()->updateFlags & QskItem::DeferredOffscreenUpdate )
+        qskItemFilter()->removeItem( this );
+
     if ( qskRegistry )
         qskRegistry->remove( this );
 }
@@ -699,6 +707,22 @@ void QskItem::applyUpdateFlag( UpdateFlag flag, bool on )
 
             break;
         }
+        case QskItem::DeferredOffscreenUpdate:
+        {
+            if ( on )
+            {
+                qskFilterWindow( window() );
+            }
+            else
+            {
+                qskItemFilter()->removeItem( this );
+
+                if ( d->dirtyAttributes )
+                    update();
+            }
+
+            break;
+        }
         case QskItem::CleanupOnVisibility:
         {
             if ( on && !isVisible() )
@@ -870,7 +894,9 @@ void QskItem::itemChange( QQuickItem::ItemChange change,
             if ( changeData.window )
             {
                 Q_D( const QskItem );
-                if ( d->updateFlags & QskItem::DeferredUpdate )
+
+                const auto mask = QskItem::DeferredUpdate | QskItem::DeferredOffscreenUpdate;
+                if ( d->updateFlags & mask )
                     qskFilterWindow( changeData.window );
             }
 
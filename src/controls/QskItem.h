@@ -52,6 +52,8 @@ class QSK_EXPORT QskItem : public QQuickItem
         CleanupOnVisibility     =  1 << 3,
 
         PreferRasterForTextures =  1 << 4,
+        DeferredOffscreenUpdate =  1 << 5,
+        PreferDistanceFields    =  1 << 6,
 
         DebugForceBackground    =  1 << 7
     };
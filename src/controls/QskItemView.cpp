@@ -0,0 +1,235 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskItemView.h"
+#include "QskControl.h"
+
+#include <qhash.h>
+#include <qvector.h>
+
+namespace
+{
+    class ContentItem final : public QskControl
+    {
+        using Inherited = QskControl;
+
+      public:
+        ContentItem( const QskItemView* view )
+            : m_view( view )
+        {
+            initSizePolicy( QskSizePolicy::Ignored, QskSizePolicy::Fixed );
+        }
+
+      protected:
+        QSizeF layoutSizeHint( Qt::SizeHint which, const QSizeF& ) const override
+        {
+            if ( which != Qt::PreferredSize )
+                return QSizeF();
+
+            return QSizeF( 0.0, m_view->rowCount() * m_view->rowHeight() );
+        }
+
+      private:
+        const QskItemView* m_view;
+    };
+}
+
+class QskItemView::PrivateData
+{
+  public:
+    ContentItem* contentItem = nullptr;
+
+    QHash< int, QQuickItem* > delegates; // row -> delegate
+    QHash< const QQuickItem*, int > rows; // delegate -> row
+    QVector< QQuickItem* > pool;
+
+    int overscan = 2;
+};
+
+QskItemView::QskItemView( QQuickItem* parent )
+    : Inherited( parent )
+    , m_data( new PrivateData() )
+{
+    m_data->contentItem = new ContentItem( this );
+    setScrolledItem( m_data->contentItem );
+
+    connect( this, &QskScrollBox::scrollPosChanged,
+        this, &QskItemView::updateDelegates );
+}
+
+QskItemView::~QskItemView()
+{
+}
+
+void QskItemView::setOverscan( int overscan )
+{
+    overscan = qMax( overscan, 0 );
+
+    if ( overscan != m_data->overscan )
+    {
+        m_data->overscan = overscan;
+        updateDelegates();
+
+        Q_EMIT overscanChanged( overscan );
+    }
+}
+
+int QskItemView::overscan() const
+{
+    return m_data->overscan;
+}
+
+QQuickItem* QskItemView::delegateAt( int row ) const
+{
+    return m_data->delegates.value( row, nullptr );
+}
+
+int QskItemView::rowOf( const QQuickItem* delegate ) const
+{
+    return m_data->rows.value( delegate, -1 );
+}
+
+int QskItemView::delegateCount() const
+{
+    return m_data->delegates.count() + m_data->pool.count();
+}
+
+void QskItemView::reset()
+{
+    auto& delegates = m_data->delegates;
+
+    for ( auto it = delegates.constBegin(); it != delegates.constEnd(); ++it )
+    {
+        auto delegate = it.value();
+
+        unbindDelegate( delegate, it.key() );
+        delegate->setVisible( false );
+
+        m_data->pool += delegate;
+    }
+
+    delegates.clear();
+    m_data->rows.clear();
+
+    m_data->contentItem->resetImplicitSize();
+    polish();
+}
+
+void QskItemView::updateRows( int from, int to )
+{
+    const auto& delegates = m_data->delegates;
+
+    if ( to - from + 1 > delegates.count() )
+    {
+        for ( auto it = delegates.constBegin(); it != delegates.constEnd(); ++it )
+        {
+            if ( it.key() >= from && it.key() <= to )
+                bindDelegate( it.value(), it.key() );
+        }
+    }
+    else
+    {
+        for ( int row = from; row <= to; row++ )
+        {
+            if ( auto delegate = delegates.value( row, nullptr ) )
+                bindDelegate( delegate, row );
+        }
+    }
+}
+
+void QskItemView::unbindDelegate( QQuickItem*, int )
+{
+}
+
+void QskItemView::updateLayout()
+{
+    Inherited::updateLayout();
+    updateDelegates();
+}
+
+void QskItemView::updateDelegates()
+{
+    const auto contentItem = m_data->contentItem;
+
+    const auto rowCount = this->rowCount();
+    const auto rowHeight = this->rowHeight();
+    const auto viewHeight = viewContentsRect().height();
+
+    int from = 0;
+    int to = -1;
+
+    if ( rowCount > 0 && rowHeight > 0.0 && viewHeight > 0.0 )
+    {
+        const auto y = scrollPos().y();
+
+        from = qMax( int( y / rowHeight ) - m_data->overscan, 0 );
+        to = qMin( int( ( y + viewHeight ) / rowHeight ) + m_data->overscan, rowCount - 1 );
+    }
+
+    auto& delegates = m_data->delegates;
+    auto& pool = m_data->pool;
+
+    // releasing the delegates, that have left the viewport
+
+    for ( auto it = delegates.begin(); it != delegates.end(); )
+    {
+        if ( it.key() < from || it.key() > to )
+        {
+            auto delegate = it.value();
+
+            unbindDelegate( delegate, it.key() );
+            delegate->setVisible( false );
+
+            pool += delegate;
+            m_data->rows.remove( delegate );
+
+            it = delegates.erase( it );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // instantiating the rows, that have entered the viewport
+
+    const auto width = contentItem->width();
+
+    for ( int row = from; row <= to; row++ )
+    {
+        auto& delegate = delegates[ row ];
+
+        if ( delegate == nullptr )
+        {
+            if ( !pool.isEmpty() )
+            {
+                delegate = pool.takeLast();
+            }
+            else
+            {
+                delegate = createDelegate();
+                if ( delegate == nullptr )
+                {
+                    delegates.remove( row );
+                    continue;
+                }
+
+                delegate->setParentItem( contentItem );
+                if ( delegate->parent() == nullptr )
+                    delegate->setParent( contentItem );
+            }
+
+            m_data->rows.insert( delegate, row );
+
+            bindDelegate( delegate, row );
+            delegate->setVisible( true );
+        }
+
+        delegate->setPosition( QPointF( 0.0, row * rowHeight ) );
+        delegate->setSize( QSizeF( width, rowHeight ) );
+    }
+}
+
+#include "moc_QskItemView.cpp"
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_ITEM_VIEW_H
+#define QSK_ITEM_VIEW_H
+
+#include "QskScrollArea.h"
+
+/*
+    QskItemView displays the rows of a model by delegate items, but
+    instantiates only those, that are intersecting the viewport
+    ( + a couple of overscan rows ). Delegates leaving the viewport are
+    not destroyed but kept in a pool, so that they can be bound to
+    other rows later.
+
+    Memory and the costs for scrolling depend on the size
+    of the viewport and not on the number of rows.
+ */
+class QSK_EXPORT QskItemView : public QskScrollArea
+{
+    Q_OBJECT
+
+    Q_PROPERTY( int overscan READ overscan
+        WRITE setOverscan NOTIFY overscanChanged FINAL )
+
+    using Inherited = QskScrollArea;
+
+  public:
+    QskItemView( QQuickItem* parent = nullptr );
+    ~QskItemView() override;
+
+    void setOverscan( int );
+    int overscan() const;
+
+    virtual int rowCount() const = 0;
+    virtual qreal rowHeight() const = 0;
+
+    // nullptr, when the row is not instantiated
+    QQuickItem* delegateAt( int row ) const;
+    int rowOf( const QQuickItem* delegate ) const;
+
+    int delegateCount() const;
+
+  public Q_SLOTS:
+    // to be called when the number of rows has changed
+    void reset();
+
+    // rebinding the delegates of the rows, that are instantiated
+    void updateRows( int from, int to );
+
+  Q_SIGNALS:
+    void overscanChanged( int );
+
+  protected:
+    virtual QQuickItem* createDelegate() = 0;
+
+    virtual void bindDelegate( QQuickItem*, int row ) = 0;
+    virtual void unbindDelegate( QQuickItem*, int row );
+
+    void updateLayout() override;
+
+  private:
+    void updateDelegates();
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
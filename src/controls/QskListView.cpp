@@ -11,6 +11,7 @@
 
 #include <qguiapplication.h>
 #include <qstylehints.h>
+#include <qvector.h>
 
 #include <qmath.h>
 
@@ -28,20 +29,116 @@ static inline int qskRowAt( const QskListView* listView, const QPointF& pos )
     if ( rect.contains( pos ) )
     {
         const auto y = pos.y() - rect.top() + listView->scrollPos().y();
-
-        const int row = y / listView->rowHeight();
-        if ( row >= 0 && row < listView->rowCount() )
-            return row;
+        return listView->rowAtPosition( y );
     }
 
     return -1;
 }
 
+namespace
+{
+    /*
+        A Fenwick tree ( binary indexed tree ) for the row heights, so that
+        finding the position of a row, or the row at a position, and
+        updating the height of a row are O(log n).
+     */
+    class RowHeights
+    {
+      public:
+        void reset( const QskListView* listView )
+        {
+            const int count = qMax( listView->rowCount(), 0 );
+
+            m_heights.resize( count );
+            m_tree.fill( 0.0, count + 1 );
+
+            for ( int i = 1; i <= count; i++ )
+            {
+                const auto h = listView->rowHeightAt( i - 1 );
+
+                m_heights[ i - 1 ] = h;
+                m_tree[ i ] += h;
+
+                const int j = i + ( i & -i );
+                if ( j <= count )
+                    m_tree[ j ] += m_tree[ i ];
+            }
+        }
+
+        void clear()
+        {
+            m_heights.clear();
+            m_tree.clear();
+        }
+
+        inline int count() const
+        {
+            return m_heights.count();
+        }
+
+        inline qreal heightAt( int row ) const
+        {
+            return m_heights[ row ];
+        }
+
+        void setHeightAt( int row, qreal height )
+        {
+            const auto delta = height - m_heights[ row ];
+            if ( delta == 0.0 )
+                return;
+
+            m_heights[ row ] = height;
+
+            for ( int i = row + 1; i < m_tree.count(); i += i & -i )
+                m_tree[ i ] += delta;
+        }
+
+        // the accumulated height of all rows before row
+        qreal position( int row ) const
+        {
+            qreal pos = 0.0;
+            for ( int i = row; i > 0; i -= i & -i )
+                pos += m_tree[ i ];
+
+            return pos;
+        }
+
+        // the row containing y, count() for positions below the last row
+        int rowAt( qreal y ) const
+        {
+            const int n = count();
+
+            int mask = 1;
+            while ( ( mask << 1 ) <= n )
+                mask <<= 1;
+
+            int row = 0;
+
+            for ( ; mask > 0; mask >>= 1 )
+            {
+                const int i = row + mask;
+                if ( i <= n && m_tree[ i ] <= y )
+                {
+                    row = i;
+                    y -= m_tree[ i ];
+                }
+            }
+
+            return row;
+        }
+
+      private:
+        QVector< qreal > m_heights;
+        QVector< qreal > m_tree;
+    };
+}
+
 class QskListView::PrivateData
 {
   public:
     PrivateData()
         : preferredWidthFromColumns( false )
+        , variableRowHeights( false )
         , selectionMode( QskListView::SingleSelection )
     {
     }
@@ -90,8 +187,11 @@ class QskListView::PrivateData
      */
 
     bool preferredWidthFromColumns : 1;
+    bool variableRowHeights : 1;
     SelectionMode selectionMode : 4;
 
+    RowHeights rowHeights;
+
     int hoveredRow = -1;
     int pressedRow = -1;
     int selectedRow = -1;
@@ -126,6 +226,74 @@ bool QskListView::preferredWidthFromColumns() const
     return m_data->preferredWidthFromColumns;
 }
 
+void QskListView::setVariableRowHeights( bool on )
+{
+    if ( on != m_data->variableRowHeights )
+    {
+        m_data->variableRowHeights = on;
+
+        if ( !on )
+            m_data->rowHeights.clear();
+
+        updateScrollableSize();
+        update();
+
+        Q_EMIT variableRowHeightsChanged( on );
+    }
+}
+
+bool QskListView::hasVariableRowHeights() const
+{
+    return m_data->variableRowHeights;
+}
+
+qreal QskListView::rowHeightAt( int ) const
+{
+    return rowHeight();
+}
+
+qreal QskListView::effectiveRowHeight( int row ) const
+{
+    const auto& rowHeights = m_data->rowHeights;
+
+    if ( m_data->variableRowHeights && row >= 0 && row < rowHeights.count() )
+        return rowHeights.heightAt( row );
+
+    return rowHeight();
+}
+
+qreal QskListView::rowPosition( int row ) const
+{
+    if ( m_data->variableRowHeights )
+    {
+        const auto& rowHeights = m_data->rowHeights;
+        return rowHeights.position( qBound( 0, row, rowHeights.count() ) );
+    }
+
+    return row * rowHeight();
+}
+
+int QskListView::rowAtPosition( qreal y ) const
+{
+    if ( y < 0.0 )
+        return -1;
+
+    int row = -1;
+
+    if ( m_data->variableRowHeights )
+    {
+        row = m_data->rowHeights.rowAt( y );
+    }
+    else
+    {
+        const auto h = rowHeight();
+        if ( h > 0.0 )
+            row = y / h;
+    }
+
+    return ( row < rowCount() ) ? row : -1;
+}
+
 void QskListView::setTextOptions( const QskTextOptions& textOptions )
 {
     if ( setTextOptionsHint( Text, textOptions ) )
@@ -281,7 +449,9 @@ void QskListView::keyPressEvent( QKeyEvent* event )
     {
         auto pos = scrollPos();
 
-        const qreal rowPos = row * rowHeight();
+        const qreal rowPos = rowPosition( row );
+        const qreal rowHeight = effectiveRowHeight( row );
+
         if ( rowPos < scrollPos().y() )
         {
             pos.setY( rowPos );
@@ -291,9 +461,9 @@ void QskListView::keyPressEvent( QKeyEvent* event )
             const QRectF vr = viewContentsRect();
 
             const double scrolledBottom = scrollPos().y() + vr.height();
-            if ( rowPos + rowHeight() > scrolledBottom )
+            if ( rowPos + rowHeight > scrolledBottom )
             {
-                const double y = rowPos + rowHeight() - vr.height();
+                const double y = rowPos + rowHeight - vr.height();
                 pos.setY( y );
             }
         }
@@ -398,19 +568,29 @@ QskAspect::States QskListView::rowStates( int row ) const
 
 #ifndef QT_NO_WHEELEVENT
 
-static qreal qskAlignedToRows( const qreal y0, qreal dy,
-    qreal rowHeight, qreal viewHeight )
+static qreal qskAlignedToRows( const QskListView* listView,
+    const qreal y0, qreal dy, qreal viewHeight )
 {
     qreal y = y0 - dy;
 
     if ( dy > 0 )
     {
-        y = qFloor( y / rowHeight ) * rowHeight;
+        const auto row = listView->rowAtPosition( y );
+        if ( row >= 0 )
+            y = listView->rowPosition( row );
     }
     else
     {
         y += viewHeight;
-        y = qCeil( y / rowHeight ) * rowHeight;
+
+        const auto row = listView->rowAtPosition( y );
+        if ( row >= 0 )
+        {
+            const auto rowPos = listView->rowPosition( row );
+            if ( y > rowPos )
+                y = rowPos + listView->effectiveRowHeight( row );
+        }
+
         y -= viewHeight;
     }
 
@@ -457,7 +637,7 @@ QPointF QskListView::scrollOffset( const QWheelEvent* event ) const
         dy *= offset.y(); // multiplied by the wheelsteps
 
         // aligning rows that enter the view
-        dy = qskAlignedToRows( y0, dy, rowHeight, viewHeight );
+        dy = qskAlignedToRows( this, y0, dy, viewHeight );
 
         offset.setY( y0 - dy );
     }
@@ -471,7 +651,10 @@ QPointF QskListView::scrollOffset( const QWheelEvent* event ) const
 
 void QskListView::updateScrollableSize()
 {
-    const double h = rowCount() * rowHeight();
+    if ( m_data->variableRowHeights )
+        m_data->rowHeights.reset( this );
+
+    const double h = rowPosition( rowCount() );
 
     qreal w = 0.0;
     for ( int col = 0; col < columnCount(); col++ )
@@ -488,6 +671,32 @@ void QskListView::updateScrollableSize()
     }
 }
 
+void QskListView::updateRowHeights( int from, int to )
+{
+    if ( !m_data->variableRowHeights )
+        return;
+
+    auto& rowHeights = m_data->rowHeights;
+
+    if ( rowHeights.count() != rowCount() )
+    {
+        // rows have been inserted/removed
+        updateScrollableSize();
+        return;
+    }
+
+    from = qMax( from, 0 );
+    to = qMin( to, rowHeights.count() - 1 );
+
+    for ( int row = from; row <= to; row++ )
+        rowHeights.setHeightAt( row, rowHeightAt( row ) );
+
+    const QSizeF sz = scrollableSize();
+    setScrollableSize( QSizeF( sz.width(), rowHeights.position( rowHeights.count() ) ) );
+
+    update();
+}
+
 void QskListView::componentComplete()
 {
     Inherited::componentComplete();
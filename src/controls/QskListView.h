@@ -26,6 +26,9 @@ class QSK_EXPORT QskListView : public QskScrollView
     Q_PROPERTY( bool preferredWidthFromColumns READ preferredWidthFromColumns
         WRITE setPreferredWidthFromColumns NOTIFY preferredWidthFromColumnsChanged() )
 
+    Q_PROPERTY( bool variableRowHeights READ hasVariableRowHeights
+        WRITE setVariableRowHeights NOTIFY variableRowHeightsChanged FINAL )
+
     using Inherited = QskScrollView;
 
   public:
@@ -46,6 +49,9 @@ class QSK_EXPORT QskListView : public QskScrollView
     void setPreferredWidthFromColumns( bool );
     bool preferredWidthFromColumns() const;
 
+    void setVariableRowHeights( bool );
+    bool hasVariableRowHeights() const;
+
     void setSelectionMode( SelectionMode );
     SelectionMode selectionMode() const;
 
@@ -62,6 +68,17 @@ class QSK_EXPORT QskListView : public QskScrollView
     virtual qreal columnWidth( int col ) const = 0;
     virtual qreal rowHeight() const = 0;
 
+    /*
+        The height of a specific row, when having variableRowHeights.
+        The values are cached and need to be updated by updateRowHeights()
+        or updateScrollableSize(), when being changed.
+     */
+    virtual qreal rowHeightAt( int row ) const;
+
+    qreal effectiveRowHeight( int row ) const;
+    qreal rowPosition( int row ) const;
+    int rowAtPosition( qreal y ) const;
+
     Q_INVOKABLE virtual QVariant valueAt( int row, int col ) const = 0;
 
     QRectF focusIndicatorRect() const override;
@@ -74,6 +91,7 @@ class QSK_EXPORT QskListView : public QskScrollView
 
     void selectionModeChanged();
     void preferredWidthFromColumnsChanged();
+    void variableRowHeightsChanged( bool );
     void textOptionsChanged();
 
   protected:
@@ -95,6 +113,7 @@ class QSK_EXPORT QskListView : public QskScrollView
 #endif
 
     void updateScrollableSize();
+    void updateRowHeights( int from, int to );
 
     void componentComplete() override;
 
@@ -110,15 +110,19 @@ namespace
             setMatrix( QTransform::fromTranslate( -scrollPos.x(), -scrollPos.y() ) );
 
             m_clipRect = listView->viewContentsRect();
-            m_rowHeight = listView->rowHeight();
 
-            m_rowMin = qFloor( scrollPos.y() / m_rowHeight );
+            m_rowMin = listView->rowAtPosition( scrollPos.y() );
+            m_rowMax = listView->rowAtPosition( scrollPos.y() + m_clipRect.height() - 10e-6 );
 
-            const auto rowMax = ( scrollPos.y() + m_clipRect.height() ) / m_rowHeight;
-            m_rowMax = qFloor( rowMax - 10e-6 );
-
-            if ( m_rowMax >= listView->rowCount() )
+            if ( m_rowMin < 0 )
+            {
+                m_rowMin = 0;
+                m_rowMax = -1;
+            }
+            else if ( m_rowMax < 0 )
+            {
                 m_rowMax = listView->rowCount() - 1;
+            }
         }
 
         QRectF clipRect() const { return m_clipRect; }
@@ -127,8 +131,6 @@ namespace
         int rowMax() const { return m_rowMax; }
         int rowCount() const { return m_rowMax - m_rowMin + 1; }
 
-        int rowHeight() const { return m_rowHeight; }
-
         QSGNode* backgroundNode() { return &m_backgroundNode; }
         ForegroundNode* foregroundNode() { return &m_foregroundNode; }
 
@@ -136,7 +138,6 @@ namespace
         // caching some calculations to speed things up
 
         QRectF m_clipRect;
-        qreal m_rowHeight;
 
         int m_rowMin, m_rowMax;
 
@@ -255,8 +256,7 @@ void QskListViewSkinlet::updateForegroundNodes(
     // finally putting the nodes into their position
     auto node = foregroundNode->firstChild();
 
-    const auto rowHeight = listView->rowHeight();
-    auto y = clipRect.top() + rowMin * rowHeight;
+    auto y = clipRect.top() + listView->rowPosition( rowMin );
 
     for ( int row = rowMin; row <= rowMax; row++ )
     {
@@ -274,7 +274,7 @@ void QskListViewSkinlet::updateForegroundNodes(
             x += listView->columnWidth( col );
         }
 
-        y += rowHeight;
+        y += listView->effectiveRowHeight( row );
     }
 }
 
@@ -286,7 +286,7 @@ void QskListViewSkinlet::updateVisibleForegroundNodes(
 
     for ( int row = rowMin; row <= rowMax; row++ )
     {
-        const auto h = listView->rowHeight() - ( margins.top() + margins.bottom() );
+        const auto h = listView->effectiveRowHeight( row ) - ( margins.top() + margins.bottom() );
 
         for ( int col = 0; col < listView->columnCount(); col++ )
         {
@@ -485,9 +485,9 @@ QRectF QskListViewSkinlet::sampleRect( const QskSkinnable* skinnable,
         const auto clipRect = node ? node->clipRect() : listView->viewContentsRect();
 
         const auto w = clipRect.width();
-        const auto h = listView->rowHeight();
+        const auto h = listView->effectiveRowHeight( index );
         const auto x = clipRect.left() + listView->scrollPos().x();
-        const auto y = clipRect.top() + index * h;
+        const auto y = clipRect.top() + listView->rowPosition( index );
 
         return QRectF( x, y, w, h );
     }
@@ -495,4 +495,26 @@ QRectF QskListViewSkinlet::sampleRect( const QskSkinnable* skinnable,
     return Inherited::sampleRect( skinnable, contentsRect, subControl, index );
 }
 
+int QskListViewSkinlet::sampleIndexAt( const QskSkinnable* skinnable,
+    const QRectF& contentsRect, QskAspect::Subcontrol subControl, const QPointF& pos ) const
+{
+    using Q = QskListView;
+
+    const auto listView = static_cast< const QskListView* >( skinnable );
+
+    if ( subControl == Q::Cell )
+    {
+        auto node = qskListViewNode( listView );
+        const auto clipRect = node ? node->clipRect() : listView->viewContentsRect();
+
+        const auto x = pos.x() - listView->scrollPos().x();
+        if ( x < clipRect.left() || x >= clipRect.right() )
+            return -1;
+
+        return listView->rowAtPosition( pos.y() - clipRect.top() );
+    }
+
+    return Inherited::sampleIndexAt( skinnable, contentsRect, subControl, pos );
+}
+
 #include "moc_QskListViewSkinlet.cpp"
@@ -11,6 +11,7 @@
 class QskListView;
 
 class QMarginsF;
+class QPointF;
 class QSizeF;
 class QRectF;
 class QSGTransformNode;
@@ -39,6 +40,9 @@ class QSK_EXPORT QskListViewSkinlet : public QskScrollViewSkinlet
     QRectF sampleRect( const QskSkinnable*,
         const QRectF&, QskAspect::Subcontrol, int index ) const override;
 
+    int sampleIndexAt( const QskSkinnable*, const QRectF&,
+        QskAspect::Subcontrol, const QPointF& ) const override;
+
     QskAspect::States sampleStates( const QskSkinnable*,
         QskAspect::Subcontrol, int index ) const override;
 
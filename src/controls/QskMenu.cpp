@@ -17,6 +17,7 @@
 #include <qvector.h>
 #include <qvariant.h>
 #include <qeventloop.h>
+#include <qquickwindow.h>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
@@ -54,6 +55,8 @@ class QskMenu::PrivateData
     int triggeredIndex = -1;
     int currentIndex = -1;
 
+    qreal scrollPosition = 0.0;
+
     bool wrapping = true;
     bool isPressed = false;
 };
@@ -205,6 +208,9 @@ void QskMenu::setOptions( const QStringList& options )
 void QskMenu::setOptions( const QVector< QskLabelData >& options )
 {
     m_data->options = options;
+    m_data->separators.clear();
+    m_data->actions.clear();
+    m_data->scrollPosition = 0.0;
 
     for ( int i = 0; i < options.count(); i++ )
     {
@@ -283,11 +289,51 @@ void QskMenu::setCurrentIndex( int index )
         m_data->currentIndex = index;
         update();
 
+        if ( index >= 0 )
+            ensureVisible( index );
+
         Q_EMIT currentIndexChanged( index );
         Q_EMIT focusIndicatorRectChanged();
     }
 }
 
+qreal QskMenu::scrollPosition() const
+{
+    return m_data->scrollPosition;
+}
+
+void QskMenu::setScrollPosition( qreal pos )
+{
+    const auto maxPos = sizeConstraint().height() - height();
+    pos = qBound( 0.0, pos, qMax( maxPos, 0.0 ) );
+
+    if ( pos != m_data->scrollPosition )
+    {
+        m_data->scrollPosition = pos;
+        update();
+
+        Q_EMIT scrollPositionChanged( pos );
+        Q_EMIT focusIndicatorRectChanged();
+    }
+}
+
+void QskMenu::ensureVisible( int index )
+{
+    if ( height() <= 0.0 )
+        return; // not laid out yet, see aboutToShow
+
+    const auto rect = cellRect( index );
+    if ( rect.isEmpty() )
+        return;
+
+    const auto viewRect = subControlContentsRect( Panel );
+
+    if ( rect.top() < viewRect.top() )
+        setScrollPosition( m_data->scrollPosition - ( viewRect.top() - rect.top() ) );
+    else if ( rect.bottom() > viewRect.bottom() )
+        setScrollPosition( m_data->scrollPosition + ( rect.bottom() - viewRect.bottom() ) );
+}
+
 QString QskMenu::currentText() const
 {
     return optionAt( m_data->currentIndex ).text();
@@ -512,13 +558,28 @@ void QskMenu::mouseReleaseEvent( QMouseEvent* event )
 
 void QskMenu::aboutToShow()
 {
-    setSize( sizeConstraint() );
+    auto size = sizeConstraint();
+
+    if ( const auto w = window() )
+    {
+        // limited to the window, the remaining options can be scrolled
+
+        const auto maxHeight = w->height() - m_data->origin.y();
+        if ( maxHeight > 0.0 && size.height() > maxHeight )
+            size.setHeight( maxHeight );
+    }
+
+    setSize( size );
 
     if ( m_data->currentIndex < 0 )
     {
         if ( !m_data->actions.isEmpty() )
             setCurrentIndex( m_data->actions.first() );
     }
+    else
+    {
+        ensureVisible( m_data->currentIndex );
+    }
 
     Inherited::aboutToShow();
 }
@@ -32,6 +32,9 @@ class QSK_EXPORT QskMenu : public QskPopup
     Q_PROPERTY( int currentIndex READ currentIndex
         WRITE setCurrentIndex NOTIFY currentIndexChanged )
 
+    Q_PROPERTY( qreal scrollPosition READ scrollPosition
+        WRITE setScrollPosition NOTIFY scrollPositionChanged )
+
     Q_PROPERTY( int triggeredIndex READ triggeredIndex NOTIFY triggered )
 
     Q_PROPERTY( QString triggeredText READ triggeredText NOTIFY triggered )
@@ -77,6 +80,12 @@ class QSK_EXPORT QskMenu : public QskPopup
 
     QString currentText() const;
 
+    /*
+        When the options do not fit into the window the menu
+        can be scrolled and only the visible options are rendered.
+     */
+    qreal scrollPosition() const;
+
     int triggeredIndex() const;
     QString triggeredText() const;
 
@@ -99,6 +108,7 @@ class QSK_EXPORT QskMenu : public QskPopup
 
     void triggered( int index );
     void currentIndexChanged( int );
+    void scrollPositionChanged( qreal );
 
     void optionsChanged();
 
@@ -106,6 +116,9 @@ class QSK_EXPORT QskMenu : public QskPopup
     void setCurrentIndex( int );
     void clear();
 
+    void setScrollPosition( qreal );
+    void ensureVisible( int index );
+
   protected:
     void keyPressEvent( QKeyEvent* ) override;
     void keyReleaseEvent( QKeyEvent* ) override;
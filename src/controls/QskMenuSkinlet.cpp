@@ -17,6 +17,7 @@
 #include "QskSGNode.h"
 
 #include <qfontmetrics.h>
+#include <qhash.h>
 #include <qmath.h>
 
 static inline int qskActionIndex( const QskMenu* menu, int optionIndex )
@@ -32,6 +33,41 @@ static inline int qskActionIndex( const QskMenu* menu, int optionIndex )
     return it - actions.constBegin();
 }
 
+/*
+    Segments and separators are interleaved. The position of sample i
+    of one type depends on the number of samples of the other type
+    in front of it: i * height + ( indexes[i] - i ) * otherHeight.
+    So we can find the sample at a position by a binary search.
+ */
+static int qskSampleAt( const QVector< int >& indexes,
+    qreal y, qreal height, qreal otherHeight )
+{
+    // the last sample, that starts at or above y
+
+    int index = -1;
+
+    int from = 0;
+    int to = indexes.count() - 1;
+
+    while ( from <= to )
+    {
+        const int mid = ( from + to ) / 2;
+        const qreal top = mid * height + ( indexes[ mid ] - mid ) * otherHeight;
+
+        if ( top <= y )
+        {
+            index = mid;
+            from = mid + 1;
+        }
+        else
+        {
+            to = mid - 1;
+        }
+    }
+
+    return index;
+}
+
 static inline qreal qskPaddedSeparatorHeight( const QskMenu* menu )
 {
     using Q = QskMenu;
@@ -45,18 +81,30 @@ static inline qreal qskPaddedSeparatorHeight( const QskMenu* menu )
 class QskMenuSkinlet::PrivateData
 {
   public:
+    ~PrivateData()
+    {
+        for ( const auto& metrics : std::as_const( m_metrics ) )
+        {
+            QObject::disconnect( metrics.optionsConnection );
+            QObject::disconnect( metrics.destroyedConnection );
+        }
+    }
+
     class CacheGuard
     {
       public:
         CacheGuard( PrivateData* data )
-            : m_data( data )
+            : m_data( data->m_isCaching ? nullptr : data )
         {
-            m_data->enableCache( true );
+            // nested guards must not disable the cache of the outer one
+            if ( m_data )
+                m_data->enableCache( true );
         }
 
         ~CacheGuard()
         {
-            m_data->enableCache( false );
+            if ( m_data )
+                m_data->enableCache( false );
         }
 
       private:
@@ -129,41 +177,62 @@ class QskMenuSkinlet::PrivateData
 
         const auto h = qMax( hint.height(), textHeight );
 
-        qreal maxW = 0.0;
+        return qMax( hint.width(), maximumGraphicRatio( menu ) * h );
+    }
 
+    qreal textWidthInternal( const QskMenu* menu ) const
+    {
+        const auto font = menu->effectiveFont( QskMenu::Text );
         const auto options = menu->options();
-        for ( auto& option : options )
+
+        auto& metrics = menuMetrics( menu, options.count() );
+
+        if ( font != metrics.font )
         {
-            const auto graphic = option.icon().graphic();
-            if ( !graphic.isNull() )
+            metrics.font = font;
+            metrics.textWidth = 0.0;
+            metrics.measuredTexts = 0;
+        }
+
+        if ( metrics.measuredTexts < options.count() )
+        {
+            const QFontMetricsF fm( font );
+
+            for ( int i = metrics.measuredTexts; i < options.count(); i++ )
             {
-                const auto w = graphic.widthForHeight( h );
-                if( w > maxW )
-                    maxW = w;
+                const auto& text = options[ i ].text();
+                if ( !text.isEmpty() )
+                {
+                    metrics.textWidth = qMax( metrics.textWidth,
+                        qskHorizontalAdvance( fm, text ) );
+                }
             }
+
+            metrics.measuredTexts = options.count();
         }
 
-        return qMax( hint.width(), maxW );
+        return metrics.textWidth;
     }
 
-    qreal textWidthInternal( const QskMenu* menu ) const
+    qreal maximumGraphicRatio( const QskMenu* menu ) const
     {
-        const QFontMetricsF fm( menu->effectiveFont( QskMenu::Text ) );
+        const auto options = menu->options();
 
-        auto maxWidth = 0.0;
+        auto& metrics = menuMetrics( menu, options.count() );
 
-        const auto options = menu->options();
-        for ( auto& option : options )
+        for ( int i = metrics.measuredGraphics; i < options.count(); i++ )
         {
-            if( !option.text().isEmpty() )
+            const auto graphic = options[ i ].icon().graphic();
+            if ( !graphic.isNull() )
             {
-                const auto w = qskHorizontalAdvance( fm, option.text() );
-                if( w > maxWidth )
-                    maxWidth = w;
+                metrics.graphicRatio = qMax( metrics.graphicRatio,
+                    graphic.widthForHeight( 1.0 ) );
             }
         }
 
-        return maxWidth;
+        metrics.measuredGraphics = options.count();
+
+        return metrics.graphicRatio;
     }
 
     qreal segmentWidthInternal( const QskMenu* menu ) const
@@ -198,7 +267,59 @@ class QskMenuSkinlet::PrivateData
         return h;
     }
 
-    bool m_isCaching;
+    /*
+        The maximum widths of the texts/icons of a menu. Appended options
+        are measured incrementally, all other modifications of the
+        options invalidate the metrics.
+     */
+    struct Metrics
+    {
+        void reset()
+        {
+            textWidth = graphicRatio = 0.0;
+            measuredTexts = measuredGraphics = 0;
+        }
+
+        QFont font;
+        qreal textWidth = 0.0;
+        int measuredTexts = 0;
+
+        qreal graphicRatio = 0.0; // width / height
+        int measuredGraphics = 0;
+
+        QMetaObject::Connection optionsConnection;
+        QMetaObject::Connection destroyedConnection;
+    };
+
+    Metrics& menuMetrics( const QskMenu* menu, int optionsCount ) const
+    {
+        auto it = m_metrics.find( menu );
+        if ( it == m_metrics.end() )
+        {
+            it = m_metrics.insert( menu, Metrics() );
+
+            /*
+                optionsChanged is not emitted before the menu is completed,
+                but then options are usually appended only.
+             */
+            it->optionsConnection = QObject::connect( menu, &QskMenu::optionsChanged,
+                [ this, menu ]() { m_metrics[ menu ].reset(); } );
+
+            it->destroyedConnection = QObject::connect( menu, &QObject::destroyed,
+                [ this, menu ]() { m_metrics.remove( menu ); } );
+        }
+
+        auto& metrics = it.value();
+
+        if ( optionsCount < qMax( metrics.measuredTexts, metrics.measuredGraphics ) )
+            metrics.reset();
+
+        return metrics;
+    }
+
+    bool m_isCaching = false;
+
+    mutable QHash< const QskMenu*, Metrics > m_metrics;
 
     mutable qreal m_graphicWidth = -1.0;
     mutable qreal m_textWidth = -1.0;
@@ -322,7 +443,7 @@ QRectF QskMenuSkinlet::sampleRect(
             dy += n * qskPaddedSeparatorHeight( menu );
 
         const auto r = menu->subControlContentsRect( Q::Panel );
-        return QRectF( r.x(), r.y() + dy, r.width(), h );
+        return QRectF( r.x(), r.y() + dy - menu->scrollPosition(), r.width(), h );
     }
 
     if ( subControl == QskMenu::Icon || subControl == QskMenu::Text )
@@ -367,7 +488,7 @@ QRectF QskMenuSkinlet::sampleRect(
             y += n * m_data->segmentHeight( menu );
 
         const auto r = menu->subControlContentsRect( Q::Panel );
-        return QRectF( r.left(), y, r.width(), h );
+        return QRectF( r.left(), r.top() + y - menu->scrollPosition(), r.width(), h );
     }
 
     return Inherited::sampleRect(
@@ -378,7 +499,32 @@ int QskMenuSkinlet::sampleIndexAt(
     const QskSkinnable* skinnable, const QRectF& contentsRect,
     QskAspect::Subcontrol subControl, const QPointF& pos ) const
 {
+    using Q = QskMenu;
+
     const PrivateData::CacheGuard guard( m_data.get() );
+
+    if ( subControl == Q::Segment )
+    {
+        const auto menu = static_cast< const QskMenu* >( skinnable );
+
+        const auto r = menu->subControlContentsRect( Q::Panel );
+        if ( !r.contains( pos ) )
+            return -1; // scrolled out
+
+        const auto y = pos.y() - r.top() + menu->scrollPosition();
+
+        const auto index = qskSampleAt( menu->actions(), y,
+            m_data->segmentHeight( menu ), qskPaddedSeparatorHeight( menu ) );
+
+        if ( index >= 0 )
+        {
+            if ( sampleRect( skinnable, contentsRect, subControl, index ).contains( pos ) )
+                return index;
+        }
+
+        return -1;
+    }
+
     return Inherited::sampleIndexAt( skinnable, contentsRect, subControl, pos );
 }
 
@@ -474,8 +620,8 @@ QSGNode* QskMenuSkinlet::updateContentsNode(
 QSGNode* QskMenuSkinlet::updateMenuNode(
     const QskSkinnable* skinnable, QSGNode* contentsNode ) const
 {
-    enum { Panel, Segment, Cursor, Icon, Text, Separator };
-    static QVector< quint8 > roles = { Panel, Separator, Segment, Cursor, Icon, Text };
+    enum { Panel, Viewport };
+    static QVector< quint8 > roles = { Panel, Viewport };
 
     if ( contentsNode == nullptr )
         contentsNode = new QSGNode();
@@ -486,44 +632,102 @@ QSGNode* QskMenuSkinlet::updateMenuNode(
 
         QSGNode* newNode = nullptr;
 
+        if ( role == Panel )
+            newNode = updateBoxNode( skinnable, oldNode, QskMenu::Panel );
+        else
+            newNode = updateViewportNode( skinnable, oldNode );
+
+        QskSGNode::replaceChildNode( roles, role, contentsNode, oldNode, newNode );
+    }
+
+    return contentsNode;
+}
+
+QSGNode* QskMenuSkinlet::updateViewportNode(
+    const QskSkinnable* skinnable, QSGNode* viewportNode ) const
+{
+    using Q = QskMenu;
+
+    enum { Segment, Cursor, Icon, Text, Separator };
+    static QVector< quint8 > roles = { Separator, Segment, Cursor, Icon, Text };
+
+    const auto menu = static_cast< const QskMenu* >( skinnable );
+
+    const bool isClipping = viewportNode
+        && ( viewportNode->type() == QSGNode::ClipNodeType );
+
+    if ( menu->sizeConstraint().height() > menu->height() )
+    {
+        // scrollable: clipping the options at the panel
+        viewportNode = updateBoxClipNode( menu,
+            isClipping ? viewportNode : nullptr, Q::Panel );
+
+        if ( viewportNode == nullptr )
+            return nullptr;
+    }
+    else if ( viewportNode == nullptr || isClipping )
+    {
+        viewportNode = new QSGNode();
+    }
+
+    /*
+        Creating nodes for the visible options only, so that the costs
+        depend on the height of the menu and not on the number of options.
+     */
+    const auto segmentHeight = m_data->segmentHeight( menu );
+    const auto separatorHeight = qskPaddedSeparatorHeight( menu );
+
+    const auto y1 = menu->scrollPosition();
+    const auto y2 = y1 + menu->subControlContentsRect( Q::Panel ).height();
+
+    const auto actions = menu->actions();
+    const auto separators = menu->separators();
+
+    const auto from = qskSampleAt( actions, y1, segmentHeight, separatorHeight );
+    const auto to = qskSampleAt( actions, y2, segmentHeight, separatorHeight );
+
+    for ( const auto role : roles )
+    {
+        auto oldNode = QskSGNode::findChildNode( viewportNode, role );
+
+        QSGNode* newNode = nullptr;
+
         switch( role )
         {
-            case Panel:
-            {
-                newNode = updateBoxNode( skinnable, oldNode, QskMenu::Panel );
-                break;
-            }
             case Segment:
             {
-                newNode = updateSeriesNode( skinnable, QskMenu::Segment, oldNode );
+                newNode = updateSeriesNode( skinnable, Q::Segment, from, to, oldNode );
                 break;
             }
             case Cursor:
             {
-                newNode = updateBoxNode( skinnable, oldNode, QskMenu::Cursor );
+                newNode = updateBoxNode( skinnable, oldNode, Q::Cursor );
                 break;
             }
             case Icon:
             {
-                newNode = updateSeriesNode( skinnable, QskMenu::Icon, oldNode );
+                newNode = updateSeriesNode( skinnable, Q::Icon, from, to, oldNode );
                 break;
             }
             case Text:
             {
-                newNode = updateSeriesNode( skinnable, QskMenu::Text, oldNode );
+                newNode = updateSeriesNode( skinnable, Q::Text, from, to, oldNode );
                 break;
             }
             case Separator:
             {
-                newNode = updateSeriesNode( skinnable, QskMenu::Separator, oldNode );
+                newNode = updateSeriesNode( skinnable, Q::Separator,
+                    qskSampleAt( separators, y1, separatorHeight, segmentHeight ),
+                    qskSampleAt( separators, y2, separatorHeight, segmentHeight ),
+                    oldNode );
                 break;
             }
         }
 
-        QskSGNode::replaceChildNode( roles, role, contentsNode, oldNode, newNode );
+        QskSGNode::replaceChildNode( roles, role, viewportNode, oldNode, newNode );
     }
 
-    return contentsNode;
+    return viewportNode;
 }
 
 QSGNode* QskMenuSkinlet::updateSampleNode( const QskSkinnable* skinnable,
@@ -61,6 +61,7 @@ class QSK_EXPORT QskMenuSkinlet : public QskPopupSkinlet
 
   private:
     QRectF cursorRect( const QskSkinnable*, const QRectF&, int index ) const;
+    QSGNode* updateViewportNode( const QskSkinnable*, QSGNode* ) const;
 
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
@@ -29,6 +29,12 @@ namespace
         if ( !hasEnvironment( "QSK_PREFER_FBO_PAINTING" ) )
             flags |= QskItem::PreferRasterForTextures;
 
+        if ( hasEnvironment( "QSK_DEFERRED_OFFSCREEN_UPDATE" ) )
+            flags |= QskItem::DeferredOffscreenUpdate;
+
+        if ( hasEnvironment( "QSK_PREFER_DISTANCE_FIELDS" ) )
+            flags |= QskItem::PreferDistanceFields;
+
         if ( hasEnvironment( "QSK_FORCE_BACKGROUND" ) )
             flags |= QskItem::DebugForceBackground;
 
@@ -16,6 +16,7 @@
 #include "QskFontRole.h"
 
 #include "QskSkinHintTable.h"
+#include "QskSkinHintTableIO.h"
 #include "QskSkinManager.h"
 #include "QskSkinTransition.h"
 
@@ -444,6 +445,26 @@ bool QskSkin::hasGraphicProvider() const
     return m_data->graphicProviders.size() > 0;
 }
 
+bool QskSkin::loadHintTable( const QString& fileName )
+{
+    /*
+        Replacing the hint table by a precompiled one ( see skin2hints ),
+        what is significantly faster than running thousands of
+        QskSkinHintTableEditor calls. Metrics, that have been specified
+        in dp/px, are converted with the factors of the primary screen.
+
+        Fonts, graphic filters and graphic providers are not part
+        of the file and have to be set up by the skin.
+     */
+
+    QskSkinHintTable hintTable;
+    if ( !QskSkinHintTableIO::read( fileName, hintTable ) )
+        return false;
+
+    m_data->hintTable = hintTable;
+    return true;
+}
+
 void QskSkin::clearHints()
 {
     m_data->hintTable.clear();
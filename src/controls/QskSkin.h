@@ -91,6 +91,8 @@ class QSK_EXPORT QskSkin : public QObject
     void clearHints();
     virtual void initHints() = 0;
 
+    bool loadHintTable( const QString& fileName );
+
     void setupFontTable( const QString& family, bool italic = false );
     void completeFontTable();
 
@@ -5,136 +5,740 @@
 
 #include "QskSkinHintTable.h"
 #include "QskAnimationHint.h"
+#include "QskMargins.h"
 
+#include <qatomic.h>
+#include <qcolor.h>
+#include <qmutex.h>
+#include <qsize.h>
+#include <qvector.h>
+
+#include <atomic>
 #include <limits>
 
 const QVariant QskSkinHintTable::invalidHint;
 
-inline const QVariant* qskResolvedHint( QskAspect aspect,
-    const QHash< QskAspect, QVariant >& hints, QskAspect* resolvedAspect )
+static inline int qskBucket( quint64 key, int mask )
 {
-    auto a = aspect;
+    /*
+        The bits of an aspect are not well distributed: most of
+        the time we have small subcontrol/type/primitive values
+        and only a couple of state bits. So we need to mix the bits
+        ( fibonacci hashing ) before masking.
+     */
+    key ^= key >> 32;
+    return static_cast< int >( ( key * Q_UINT64_C( 0x9E3779B97F4A7C15 ) ) >> 32 ) & mask;
+}
 
-    Q_FOREVER
+namespace
+{
+    class ResolutionCache
     {
-        auto it = hints.constFind( aspect );
-        if ( it != hints.constEnd() )
+      public:
+        /*
+            Memoized results of resolving aspects: fully qualified aspect
+            -> index of the resolved hint ( or a miss ). The cache is direct mapped,
+            colliding aspects simply replace each other.
+
+            Lookups might happen concurrently from the scene graph thread
+            ( updatePaintNode ) or from worker threads, so each slot is
+            guarded by a sequence counter ( seqlock ): readers never block
+            and writers give up, when a slot is already being written.
+         */
+
+        ResolutionCache( int hintCount )
         {
-            if ( resolvedAspect )
-                *resolvedAspect = aspect;
+            int size = 64;
+            while ( size < 2 * hintCount && size < 4096 )
+                size *= 2;
 
-            return &it.value();
+            m_mask = size - 1;
+            m_slots = new Slot[ size ];
         }
 
-#if 1
+        ~ResolutionCache()
+        {
+            delete [] m_slots;
+        }
+
+        inline bool find( quint64 key, int& index ) const
+        {
+            const auto& slot = m_slots[ qskBucket( key, m_mask ) ];
+
+            const auto sequence = slot.sequence.load( std::memory_order_acquire );
+            if ( sequence & 1 )
+                return false;
+
+            const auto k = slot.key.load( std::memory_order_relaxed );
+            const auto value = slot.value.load( std::memory_order_relaxed );
+
+            std::atomic_thread_fence( std::memory_order_acquire );
+
+            if ( slot.sequence.load( std::memory_order_relaxed ) != sequence )
+                return false;
+
+            if ( value == 0 || k != key )
+                return false;
+
+            index = value - 2;
+            return true;
+        }
+
+        inline void insert( quint64 key, int index )
+        {
+            auto& slot = m_slots[ qskBucket( key, m_mask ) ];
+
+            auto sequence = slot.sequence.load( std::memory_order_relaxed );
+            if ( ( sequence & 1 ) || !slot.sequence.compare_exchange_strong(
+                sequence, sequence + 1, std::memory_order_relaxed ) )
+            {
+                return; // another thread is writing to the slot
+            }
+
+            std::atomic_thread_fence( std::memory_order_release );
+
+            slot.key.store( key, std::memory_order_relaxed );
+            slot.value.store( index + 2, std::memory_order_relaxed );
+
+            slot.sequence.store( sequence + 2, std::memory_order_release );
+        }
+
+      private:
+        struct Slot
+        {
+            std::atomic< quint32 > sequence { 0 };
+            std::atomic< quint64 > key { 0 };
+
+            // 0: empty, 1: miss, otherwise index + 2
+            std::atomic< int > value { 0 };
+        };
+
+        int m_mask;
+        Slot* m_slots;
+    };
+}
+
+template< typename T >
+static inline int qskTakeLast( QVector< T >& values, int index )
+{
+    // moving the last value into the gap, returning its previous position
+
+    const int last = values.size() - 1;
+    if ( index != last )
+        values[ index ] = values.at( last );
+
+    values.removeLast();
+    return last;
+}
+
+class QskSkinHintTable::PrivateData : public QSharedData
+{
+  public:
+    enum InsertStatus
+    {
+        Modified,
+        Inserted
+    };
+
+    enum SlotType : quint8
+    {
+        VariantSlot,
+
+        MetricSlot,
+        ColorSlot,
+        SizeSlot,
+        MarginsSlot
+    };
+
+    struct Slot
+    {
+        SlotType type;
+        int index; // into the array of values for type
+    };
+
+    PrivateData()
+    {
+        buckets.fill( -1, 16 );
+    }
+
+    PrivateData( const PrivateData& other )
+        : QSharedData( other )
+        , buckets( other.buckets )
+        , aspects( other.aspects )
+        , valueSlots( other.valueSlots )
+        , metrics( other.metrics )
+        , colors( other.colors )
+        , sizes( other.sizes )
+        , margins( other.margins )
+        , variants( other.variants )
+    {
+        // boxedValues/hashTable/resolutionCache are rebuilt on demand
+    }
+
+    ~PrivateData()
+    {
+        qDeleteAll( boxedValues );
+        delete hashTable.loadRelaxed();
+        delete resolutionCache.loadRelaxed();
+    }
+
+    inline int count() const
+    {
+        return aspects.size();
+    }
+
+    inline QskAspect aspectAt( int index ) const
+    {
+        return aspects.at( index );
+    }
+
+    inline int bucketOf( QskAspect aspect ) const
+    {
         /*
-            We intend to remove the obscure mechanism of resolving a hint
-            by dropping the state bits ony by one in the future. Instead we
-            will have methods in QskSkinHintTableEditor, that allow
-            to set combinations of states in one call.
+            The position of the bucket referring to aspect - or the
+            empty bucket, where it would be inserted. As the load factor
+            is kept below 0.5 the probe sequences are short and we always
+            find an empty bucket.
          */
-        if ( const auto topState = aspect.topState() )
+
+        const int mask = buckets.size() - 1;
+
+        const auto b = buckets.constData();
+        const auto a = aspects.constData();
+
+        auto pos = qskBucket( aspect.value(), mask );
+
+        while ( ( b[ pos ] >= 0 ) && ( a[ b[ pos ] ] != aspect ) )
+            pos = ( pos + 1 ) & mask;
+
+        return pos;
+    }
+
+    inline int indexAt( int pos ) const
+    {
+        // -1 for an empty bucket
+        return buckets.constData()[ pos ];
+    }
+
+    inline int indexOf( QskAspect aspect ) const
+    {
+        return indexAt( bucketOf( aspect ) );
+    }
+
+    QVariant valueAt( int index ) const
+    {
+        const auto slot = valueSlots.at( index );
+
+        switch ( slot.type )
         {
-            aspect.clearState( topState );
-            continue;
+            case MetricSlot:
+                return QVariant::fromValue( metrics.at( slot.index ) );
+
+            case ColorSlot:
+                return QVariant::fromValue( QColor::fromRgba( colors.at( slot.index ) ) );
+
+            case SizeSlot:
+                return QVariant::fromValue( sizes.at( slot.index ) );
+
+            case MarginsSlot:
+                return QVariant::fromValue( margins.at( slot.index ) );
+
+            default:
+                return variants.at( slot.index );
         }
-#else
-        if ( aspect.hasState() )
+    }
+
+    const QVariant* variantAt( int index ) const
+    {
+        /*
+            The API returns references to QVariants, but the values are
+            stored in arrays, that get reallocated, when inserting or
+            removing hints. So we box the requested hints one by one
+            into QVariants, that live until the hint is removed.
+            Lookups might happen from different threads, so the
+            boxed values are protected by a mutex.
+         */
+
+        const auto aspect = aspects.at( index );
+
+        QMutexLocker locker( &mutex );
+
+        auto& value = boxedValues[ aspect ];
+        if ( value == nullptr )
+            value = new QVariant( valueAt( index ) );
+
+        return value;
+    }
+
+    inline bool isEqual( int index, const QVariant& value ) const
+    {
+        return valueAt( index ) == value;
+    }
+
+    /*
+        pos is the bucket returned from bucketOf( aspect ), and
+        the value of an existing hint is expected to differ.
+     */
+    InsertStatus insert( int pos, QskAspect aspect, const QVariant& value )
+    {
+        InsertStatus status;
+
+        int index = buckets.at( pos );
+        if ( index >= 0 )
         {
-            aspect.clearStates();
-            continue;
+            releaseSlot( valueSlots.at( index ) );
+            valueSlots[ index ] = storeValue( value );
+
+            // the resolution does not change, when modifying a hint
+            status = Modified;
+        }
+        else
+        {
+            index = aspects.size();
+            buckets[ pos ] = index;
+
+            aspects += aspect;
+            valueSlots += storeValue( value );
+
+            if ( 2 * aspects.size() > buckets.size() )
+                rehash( 2 * buckets.size() );
+
+            resetResolutionCache();
+            status = Inserted;
+        }
+
+        // updating in place, so that references to them remain valid
+
+        if ( auto boxedValue = boxedValues.value( aspect, nullptr ) )
+            *boxedValue = valueAt( index );
+
+        if ( auto hash = hashTable.loadRelaxed() )
+            hash->insert( aspect, valueAt( index ) );
+
+        return status;
+    }
+
+    bool remove( QskAspect aspect, QVariant* value = nullptr )
+    {
+        auto pos = bucketOf( aspect );
+
+        const int index = buckets.at( pos );
+        if ( index < 0 )
+            return false;
+
+        if ( value )
+            *value = valueAt( index );
+
+        /*
+            Backward shift deletion: entries, that have been displaced
+            from their home bucket, are moved into the gap, so that
+            all probe sequences remain unbroken without needing tombstones.
+         */
+
+        const int mask = buckets.size() - 1;
+
+        for ( int next = ( pos + 1 ) & mask;
+            buckets.at( next ) >= 0; next = ( next + 1 ) & mask )
+        {
+            const auto home = qskBucket( aspects.at( buckets.at( next ) ).value(), mask );
+
+            const bool isInPlace = ( pos < next )
+                ? ( pos < home && home <= next ) : ( pos < home || home <= next );
+
+            if ( !isInPlace )
+            {
+                buckets[ pos ] = buckets.at( next );
+                pos = next;
+            }
         }
+
+        buckets[ pos ] = -1;
+
+        releaseSlot( valueSlots.at( index ) );
+
+        // keeping the arrays dense by moving the last entry into the gap
+
+        const int last = aspects.size() - 1;
+        if ( index != last )
+        {
+            buckets[ bucketOf( aspects.at( last ) ) ] = index;
+
+            aspects[ index ] = aspects.at( last );
+            valueSlots[ index ] = valueSlots.at( last );
+        }
+
+        aspects.removeLast();
+        valueSlots.removeLast();
+
+        delete boxedValues.take( aspect );
+
+        if ( auto hash = hashTable.loadRelaxed() )
+            hash->remove( aspect );
+
+        resetResolutionCache();
+
+        return true;
+    }
+
+    int resolve( QskAspect aspect ) const
+    {
+        auto a = aspect;
+
+        Q_FOREVER
+        {
+            const auto index = indexOf( aspect );
+            if ( index >= 0 )
+                return index;
+
+#if 1
+            /*
+                We intend to remove the obscure mechanism of resolving a hint
+                by dropping the state bits ony by one in the future. Instead we
+                will have methods in QskSkinHintTableEditor, that allow
+                to set combinations of states in one call.
+             */
+            if ( const auto topState = aspect.topState() )
+            {
+                aspect.clearState( topState );
+                continue;
+            }
+#else
+            if ( aspect.hasState() )
+            {
+                aspect.clearStates();
+                continue;
+            }
 #endif
 
-        if ( aspect.variation() )
+            if ( aspect.variation() )
+            {
+                // clear the variation bits and restart
+                aspect = a;
+                aspect.setVariation( QskAspect::NoVariation );
+
+                continue;
+            }
+
+            if ( aspect.section() != QskAspect::Body )
+            {
+                // try to resolve from QskAspect::Body
+
+                a.setSection( QskAspect::Body );
+                aspect = a;
+
+                continue;
+            }
+
+            return -1;
+        }
+    }
+
+    int cachedResolve( QskAspect aspect ) const
+    {
+        /*
+            The local tables of the controls usually have a few hints only,
+            where resolving is a couple of probes into a small index.
+            So we create a cache for larger tables - like the one of the skin -
+            only.
+         */
+        if ( count() < 32 )
+            return resolve( aspect );
+
+        // created on demand and published atomically
+
+        auto cache = resolutionCache.loadAcquire();
+        if ( cache == nullptr )
         {
-            // clear the variation bits and restart
-            aspect = a;
-            aspect.setVariation( QskAspect::NoVariation );
+            auto newCache = new ResolutionCache( count() );
 
-            continue;
+            if ( resolutionCache.testAndSetOrdered( nullptr, newCache, cache ) )
+                cache = newCache;
+            else
+                delete newCache;
         }
 
-        if ( aspect.section() != QskAspect::Body )
+        int index;
+        if ( !cache->find( aspect.value(), index ) )
         {
-            // try to resolve from QskAspect::Body
+            index = resolve( aspect );
+            cache->insert( aspect.value(), index );
+        }
+
+        return index;
+    }
 
-            a.setSection( QskAspect::Body );
-            aspect = a;
+    const QHash< QskAspect, QVariant >& hash() const
+    {
+        // published atomically, see cachedResolve()
 
-            continue;
+        auto hash = hashTable.loadAcquire();
+        if ( hash == nullptr )
+        {
+            auto newHash = new QHash< QskAspect, QVariant >();
+            newHash->reserve( count() );
+
+            for ( int i = 0; i < count(); i++ )
+                newHash->insert( aspects.at( i ), valueAt( i ) );
+
+            if ( hashTable.testAndSetOrdered( nullptr, newHash, hash ) )
+                hash = newHash;
+            else
+                delete newHash;
         }
 
-        return nullptr;
+        return *hash;
     }
-}
+
+  private:
+    static SlotType slotType( const QVariant& value )
+    {
+        const auto type = value.userType();
+
+        if ( type == qMetaTypeId< qreal >() )
+            return MetricSlot;
+
+        if ( type == qMetaTypeId< QSizeF >() )
+            return SizeSlot;
+
+        if ( type == qMetaTypeId< QskMargins >() )
+            return MarginsSlot;
+
+        if ( type == qMetaTypeId< QColor >() )
+        {
+            // colors, that can't be restored from a QRgb, f.e. HSV colors
+            const auto color = value.value< QColor >();
+            if ( QColor::fromRgba( color.rgba() ) == color )
+                return ColorSlot;
+        }
+
+        return VariantSlot;
+    }
+
+    Slot storeValue( const QVariant& value )
+    {
+        Slot slot;
+        slot.type = slotType( value );
+
+        switch ( slot.type )
+        {
+            case MetricSlot:
+            {
+                slot.index = metrics.size();
+                metrics += value.value< qreal >();
+                break;
+            }
+            case ColorSlot:
+            {
+                slot.index = colors.size();
+                colors += value.value< QColor >().rgba();
+                break;
+            }
+            case SizeSlot:
+            {
+                slot.index = sizes.size();
+                sizes += value.value< QSizeF >();
+                break;
+            }
+            case MarginsSlot:
+            {
+                slot.index = margins.size();
+                margins += value.value< QskMargins >();
+                break;
+            }
+            default:
+            {
+                slot.index = variants.size();
+                variants += value;
+            }
+        }
+
+        return slot;
+    }
+
+    void releaseSlot( const Slot slot )
+    {
+        int moved;
+
+        switch ( slot.type )
+        {
+            case MetricSlot:
+                moved = qskTakeLast( metrics, slot.index );
+                break;
+
+            case ColorSlot:
+                moved = qskTakeLast( colors, slot.index );
+                break;
+
+            case SizeSlot:
+                moved = qskTakeLast( sizes, slot.index );
+                break;
+
+            case MarginsSlot:
+                moved = qskTakeLast( margins, slot.index );
+                break;
+
+            default:
+                moved = qskTakeLast( variants, slot.index );
+        }
+
+        if ( moved != slot.index )
+        {
+            /*
+                Finding the slot of the value, that has been moved
+                into the gap. Removing hints is rare, so we can
+                live with a linear search.
+             */
+            for ( auto& s : valueSlots )
+            {
+                if ( s.type == slot.type && s.index == moved )
+                {
+                    s.index = slot.index;
+                    break;
+                }
+            }
+        }
+    }
+
+    void rehash( int size )
+    {
+        buckets.fill( -1, size );
+
+        const int mask = size - 1;
+
+        for ( int i = 0; i < aspects.size(); i++ )
+        {
+            auto pos = qskBucket( aspects.at( i ).value(), mask );
+            while ( buckets.at( pos ) >= 0 )
+                pos = ( pos + 1 ) & mask;
+
+            buckets[ pos ] = i;
+        }
+    }
+
+    inline void resetResolutionCache()
+    {
+        // modifications never happen concurrently to lookups
+        delete resolutionCache.fetchAndStoreRelaxed( nullptr );
+    }
+
+    // size is a power of 2, -1 for empty buckets, otherwise an index
+    QVector< int > buckets;
+
+    // dense arrays, in order of insertion ( modulo removals )
+    QVector< QskAspect > aspects;
+    QVector< Slot > valueSlots;
+
+    // the typed slots
+    QVector< qreal > metrics;
+    QVector< QRgb > colors;
+    QVector< QSizeF > sizes;
+    QVector< QskMargins > margins;
+
+    // anything else
+    QVector< QVariant > variants;
+
+    /*
+        QVariants for the hint() API, a QHash for the hints() API
+        and the resolution cache. All of them are only created on demand.
+        The boxed values and the QHash are updated, when modifying the
+        table, while the resolution cache gets dropped, when inserting
+        or removing hints.
+     */
+    mutable QMutex mutex;
+    mutable QHash< QskAspect, QVariant* > boxedValues;
+    mutable QAtomicPointer< QHash< QskAspect, QVariant > > hashTable;
+    mutable QAtomicPointer< ResolutionCache > resolutionCache;
+};
 
 QskSkinHintTable::QskSkinHintTable()
 {
 }
 
 QskSkinHintTable::QskSkinHintTable( const QskSkinHintTable& other )
-    : m_animatorCount( other.m_animatorCount )
+    : m_data( other.m_data )
+    , m_animatorCount( other.m_animatorCount )
     , m_states( other.m_states )
 {
-    if ( other.m_hints )
-    {
-        /*
-            A previous implementation was using STL containers - however:
-
-            according to https://tessil.github.io/2016/08/29/benchmark-hopscotch-map.html
-            QHash does slightly faster lookups than std::unordered_map in the category
-            "Random full reads: execution time (integers)", that is the most relevant one
-            in our use case.  
-
-            Considering, that the "copy on write" strategy of QHash makes the implementation
-            of copy/assignment operators much easier ( needed in QskSkinTransition ) we prefer
-            using the Qt container over the STL counterparts.
-         */
-        m_hints = new QHash< QskAspect, QVariant >( *other.m_hints );
-    }
 }
 
 QskSkinHintTable::~QskSkinHintTable()
 {
-    delete m_hints;
 }
 
 QskSkinHintTable& QskSkinHintTable::operator=( const QskSkinHintTable& other )
 {
+    m_data = other.m_data;
+
     m_animatorCount = ( other.m_animatorCount );
     m_states = other.m_states;
 
-    delete m_hints;
-    m_hints = nullptr;
-
-    if ( other.m_hints )
-        m_hints = new QHash< QskAspect, QVariant >( *other.m_hints );
-
     return *this;
 }
 
 const QHash< QskAspect, QVariant >& QskSkinHintTable::hints() const
 {
-    if ( m_hints )
-        return *m_hints;
+    if ( m_data )
+        return m_data->hash();
+
+    static const QHash< QskAspect, QVariant > noHints;
+    return noHints;
+}
+
+const QVariant& QskSkinHintTable::hint( QskAspect aspect ) const
+{
+    if ( m_data )
+    {
+        const auto index = m_data->indexOf( aspect );
+        if ( index >= 0 )
+            return *m_data->variantAt( index );
+    }
+
+    return invalidHint;
+}
+
+QVariant QskSkinHintTable::hintValue( QskAspect aspect ) const
+{
+    if ( m_data )
+    {
+        const auto index = m_data->indexOf( aspect );
+        if ( index >= 0 )
+            return m_data->valueAt( index );
+    }
 
-    static QHash< QskAspect, QVariant > dummyHints;
-    return dummyHints;
+    return QVariant();
+}
+
+bool QskSkinHintTable::hasHint( QskAspect aspect ) const
+{
+    return m_data && ( m_data->indexOf( aspect ) >= 0 );
+}
+
+bool QskSkinHintTable::isSharedWith( const QskSkinHintTable& other ) const
+{
+    return m_data.constData() == other.m_data.constData();
 }
 
 #define QSK_ASSERT_COUNTER( x ) Q_ASSERT( x < std::numeric_limits< decltype( x ) >::max() )
 
 bool QskSkinHintTable::setHint( QskAspect aspect, const QVariant& skinHint )
 {
-    if ( m_hints == nullptr )
-        m_hints = new QHash< QskAspect, QVariant >();
+    if ( !m_data )
+        m_data = QExplicitlySharedDataPointer< PrivateData >( new PrivateData() );
+
+    const auto pos = m_data->bucketOf( aspect );
 
-    auto it = m_hints->find( aspect );
-    if ( it == m_hints->end() )
+    const auto index = m_data->indexAt( pos );
+    if ( index >= 0 && m_data->isEqual( index, skinHint ) )
     {
-        m_hints->insert( aspect, skinHint );
+        // no need to detach a shared table for setting the same value again
+        return false;
+    }
+
+    // a detached copy has the same buckets
+    m_data.detach();
 
+    if ( m_data->insert( pos, aspect, skinHint ) == PrivateData::Inserted )
+    {
         if ( aspect.isAnimator() )
         {
             m_animatorCount++;
@@ -142,114 +746,115 @@ bool QskSkinHintTable::setHint( QskAspect aspect, const QVariant& skinHint )
         }
 
         m_states |= aspect.states();
-
-        return true;
     }
 
-    if ( it.value() != skinHint )
-    {
-        it.value() = skinHint;
-        return true;
-    }
-
-    return false;
+    return true;
 }
 
 #undef QSK_ASSERT_COUNTER
 
 bool QskSkinHintTable::removeHint( QskAspect aspect )
 {
-    if ( m_hints == nullptr )
+    if ( !hasHint( aspect ) )
         return false;
 
-    const bool erased = m_hints->remove( aspect );
-
-    if ( erased )
-    {
-        if ( aspect.isAnimator() )
-            m_animatorCount--;
-
-        // how to clear m_states ? TODO ...
-
-        if ( m_hints->empty() )
-        {
-            delete m_hints;
-            m_hints = nullptr;
-        }
-    }
-
-    return erased;
+    takeHint( aspect );
+    return true;
 }
 
 QVariant QskSkinHintTable::takeHint( QskAspect aspect )
 {
-    if ( m_hints )
-    {
-        auto it = m_hints->find( aspect );
-        if ( it != m_hints->end() )
-        {
-            const auto value = it.value();
-            m_hints->erase( it );
+    QVariant value;
 
-            if ( aspect.isAnimator() )
-                m_animatorCount--;
+    if ( hasHint( aspect ) )
+    {
+        m_data.detach();
+        m_data->remove( aspect, &value );
 
-            // how to clear m_states ? TODO ...
+        if ( aspect.isAnimator() )
+            m_animatorCount--;
 
-            if ( m_hints->empty() )
-            {
-                delete m_hints;
-                m_hints = nullptr;
-            }
+        // how to clear m_states ? TODO ...
 
-            return value;
-        }
+        if ( m_data->count() == 0 )
+            m_data.reset();
     }
 
-    return QVariant();
+    return value;
 }
 
 void QskSkinHintTable::clear()
 {
-    delete m_hints;
-    m_hints = nullptr;
+    m_data.reset();
 
     m_animatorCount = 0;
     m_states = QskAspect::NoState;
 }
 
+int QskSkinHintTable::resolvedIndex( QskAspect aspect ) const
+{
+    aspect &= m_states;
+    return m_data->cachedResolve( aspect );
+}
+
 const QVariant* QskSkinHintTable::resolvedHint(
     QskAspect aspect, QskAspect* resolvedAspect ) const
 {
-    if ( m_hints != nullptr )
-        return qskResolvedHint( aspect & m_states, *m_hints, resolvedAspect );
+    if ( !m_data )
+        return nullptr;
+
+    const auto index = resolvedIndex( aspect );
+    if ( index < 0 )
+        return nullptr;
 
-    return nullptr;
+    if ( resolvedAspect )
+        *resolvedAspect = m_data->aspectAt( index );
+
+    return m_data->variantAt( index );
 }
 
-QskAspect QskSkinHintTable::resolvedAspect( QskAspect aspect ) const
+QVariant QskSkinHintTable::resolvedValue(
+    QskAspect aspect, QskAspect* resolvedAspect, bool* ok ) const
 {
-    QskAspect a;
+    const auto index = m_data ? resolvedIndex( aspect ) : -1;
 
-    if ( m_hints != nullptr )
-        qskResolvedHint( aspect & m_states, *m_hints, &a );
+    if ( ok )
+        *ok = ( index >= 0 );
 
-    return a;
+    if ( index < 0 )
+        return QVariant();
+
+    if ( resolvedAspect )
+        *resolvedAspect = m_data->aspectAt( index );
+
+    return m_data->valueAt( index );
+}
+
+QskAspect QskSkinHintTable::resolvedAspect( QskAspect aspect ) const
+{
+    if ( m_data )
+    {
+        const auto index = resolvedIndex( aspect );
+        if ( index >= 0 )
+            return m_data->aspectAt( index );
+    }
+
+    return QskAspect();
 }
 
 QskAspect QskSkinHintTable::resolvedAnimator(
     QskAspect aspect, QskAnimationHint& hint ) const
 {
-    if ( m_hints && m_animatorCount > 0 )
+    if ( m_data && m_animatorCount > 0 )
     {
         aspect &= m_states;
 
         Q_FOREVER
         {
-            auto it = m_hints->find( aspect );
-            if ( it != m_hints->cend() )
+            const auto index = m_data->indexOf( aspect );
+            if ( index >= 0 )
             {
-                hint = it.value().value< QskAnimationHint >();
+                hint = m_data->valueAt( index ).value< QskAnimationHint >();
                 return aspect;
             }
 
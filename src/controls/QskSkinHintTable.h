@@ -10,6 +10,7 @@
 
 #include <qvariant.h>
 #include <qhash.h>
+#include <qshareddata.h>
 
 class QskAnimationHint;
 
@@ -26,6 +27,13 @@ class QSK_EXPORT QskSkinHintTable
     QskAnimationHint animation( QskAspect ) const;
 
     bool setHint( QskAspect, const QVariant& );
+
+    /*
+        The returned reference remains valid until the hint gets removed
+        or the table gets destroyed or detached. Modifying the hint updates
+        the referenced value. As the values are stored in typed arrays,
+        the requested hints need to be boxed into QVariants.
+     */
     const QVariant& hint( QskAspect ) const;
 
     template< typename T > bool setHint( QskAspect, const T& );
@@ -36,6 +44,11 @@ class QSK_EXPORT QskSkinHintTable
 
     bool hasHint( QskAspect ) const;
 
+    /*
+        The hash is built on the first call and updated, when modifying the
+        table. The reference remains valid until the table gets destroyed
+        or detached.
+     */
     const QHash< QskAspect, QVariant >& hints() const;
 
     bool hasAnimators() const;
@@ -45,9 +58,18 @@ class QSK_EXPORT QskSkinHintTable
 
     void clear();
 
+    // the lifetime of the returned value is the same as for hint()
     const QVariant* resolvedHint( QskAspect,
         QskAspect* resolvedAspect = nullptr ) const;
 
+    /*
+        The same as resolvedHint(), but returning a copy. Unlike resolvedHint()
+        it does not need to box the value into a QVariant, that is kept
+        inside of the table.
+     */
+    QVariant resolvedValue( QskAspect, QskAspect* resolvedAspect = nullptr,
+        bool* ok = nullptr ) const;
+
     QskAspect resolvedAspect( QskAspect ) const;
 
     QskAspect resolvedAnimator(
@@ -55,11 +77,24 @@ class QSK_EXPORT QskSkinHintTable
 
     bool isResolutionMatching( QskAspect, QskAspect ) const;
 
+    bool isSharedWith( const QskSkinHintTable& ) const;
+
   private:
+    int resolvedIndex( QskAspect ) const;
+    QVariant hintValue( QskAspect ) const;
 
     static const QVariant invalidHint;
 
-    QHash< QskAspect, QVariant >* m_hints = nullptr;
+    /*
+        Flat, implicitly shared storage: an open addressing index
+        keyed on QskAspect::value() into dense arrays of aspects/values.
+        Metrics, colors, sizes and margins are stored in typed slots,
+        only other hints are stored as QVariant.
+        Copying a table ( f.e in QskSkinTransition ) is a reference count
+        increment only.
+     */
+    class PrivateData;
+    QExplicitlySharedDataPointer< PrivateData > m_data;
 
     unsigned short m_animatorCount = 0;
     QskAspect::States m_states;
@@ -67,7 +102,7 @@ class QSK_EXPORT QskSkinHintTable
 
 inline bool QskSkinHintTable::hasHints() const
 {
-    return m_hints != nullptr;
+    return m_data.constData() != nullptr;
 }
 
 inline QskAspect::States QskSkinHintTable::states() const
@@ -80,23 +115,6 @@ inline bool QskSkinHintTable::hasAnimators() const
     return m_animatorCount > 0;
 }
 
-inline bool QskSkinHintTable::hasHint( QskAspect aspect ) const
-{
-    return m_hints && m_hints->contains( aspect );
-}
-
-inline const QVariant& QskSkinHintTable::hint( QskAspect aspect ) const
-{
-    if ( m_hints != nullptr )
-    {
-        auto it = m_hints->constFind( aspect );
-        if ( it != m_hints->constEnd() )
-            return it.value();
-    }
-
-    return invalidHint;
-}
-
 template< typename T >
 inline bool QskSkinHintTable::setHint( QskAspect aspect, const T& hint )
 {
@@ -106,7 +124,7 @@ inline bool QskSkinHintTable::setHint( QskAspect aspect, const T& hint )
 template< typename T >
 inline T QskSkinHintTable::hint( QskAspect aspect ) const
 {
-    return hint( aspect ).value< T >();
+    return hintValue( aspect ).value< T >();
 }
 
 #endif
@@ -330,7 +330,7 @@ inline void QskSkinHintTableEditor::setHint(
 template< typename T >
 inline T QskSkinHintTableEditor::hint( QskAspect aspect ) const
 {
-    return hint( aspect ).value< T >();
+    return m_table->hint< T >( aspect );
 }
 
 inline const QVariant& QskSkinHintTableEditor::hint( QskAspect aspect ) const
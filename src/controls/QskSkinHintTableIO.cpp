@@ -0,0 +1,991 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskSkinHintTableIO.h"
+#include "QskSkinHintTable.h"
+
+#include "QskAnimationHint.h"
+#include "QskArcMetrics.h"
+#include "QskBoxBorderColors.h"
+#include "QskBoxBorderMetrics.h"
+#include "QskBoxShapeMetrics.h"
+#include "QskFontRole.h"
+#include "QskGradient.h"
+#include "QskGradientDirection.h"
+#include "QskGraduationMetrics.h"
+#include "QskGraphic.h"
+#include "QskGraphicIO.h"
+#include "QskMargins.h"
+#include "QskPlatform.h"
+#include "QskShadowMetrics.h"
+#include "QskStippleMetrics.h"
+#include "QskTextOptions.h"
+
+#include <qbuffer.h>
+#include <qdatastream.h>
+#include <qdebug.h>
+#include <qfile.h>
+#include <qhash.h>
+#include <qvector.h>
+
+#include <algorithm>
+#include <cstring>
+
+static const char qskMagicNumber[] = "QSKH";
+static const quint32 qskFormatVersion = 1;
+
+// see QskGraphicIO
+static const int qskDataStreamVersion = QDataStream::Qt_5_15;
+
+namespace
+{
+    enum ValueType : quint8
+    {
+        InvalidValue,
+
+        BuiltinValue, // streamable by QVariant
+        EnumValue,
+
+        MarginsValue,
+        BoxShapeValue,
+        BoxBorderMetricsValue,
+        BoxBorderColorsValue,
+        GradientValue,
+        ShadowMetricsValue,
+        ArcMetricsValue,
+        StippleMetricsValue,
+        GraduationMetricsValue,
+        AnimationValue,
+        FontRoleValue,
+        TextOptionsValue,
+        GraphicValue
+    };
+}
+
+static inline bool qskIsEnum( int type )
+{
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    const auto flags = QMetaType( type ).flags();
+#else
+    const auto flags = QMetaType::typeFlags( type );
+#endif
+
+    return flags.testFlag( QMetaType::IsEnumeration );
+}
+
+static inline QByteArray qskTypeName( int type )
+{
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    return QMetaType( type ).name();
+#else
+    return QMetaType::typeName( type );
+#endif
+}
+
+static inline QVariant qskEnumValue( const QByteArray& typeName, qint64 value )
+{
+    QVariant v( static_cast< int >( value ) );
+
+#if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
+    const auto metaType = QMetaType::fromName( typeName );
+    if ( metaType.isValid() )
+        v.convert( metaType );
+#else
+    const int type = QMetaType::type( typeName.constData() );
+    if ( type != QMetaType::UnknownType )
+        v.convert( type );
+#endif
+
+    /*
+        When not being able to restore the enum type we return the
+        value as int. As QVariant::value< Enum >() does the conversion
+        this is good enough for hints.
+     */
+
+    return v;
+}
+
+static void qskWriteGradient( QDataStream& s, const QskGradient& gradient )
+{
+    s << static_cast< quint8 >( gradient.type() );
+
+    switch ( gradient.type() )
+    {
+        case QskGradient::Linear:
+        {
+            const auto dir = gradient.linearDirection();
+            s << dir.x1() << dir.y1() << dir.x2() << dir.y2();
+
+            break;
+        }
+        case QskGradient::Radial:
+        {
+            const auto dir = gradient.radialDirection();
+            s << dir.x() << dir.y() << dir.radiusX() << dir.radiusY();
+
+            break;
+        }
+        case QskGradient::Conic:
+        {
+            const auto dir = gradient.conicDirection();
+            s << dir.x() << dir.y() << dir.startAngle()
+                << dir.spanAngle() << dir.aspectRatio();
+
+            break;
+        }
+        default:
+            break;
+    }
+
+    const auto& stops = gradient.stops();
+
+    s << static_cast< quint32 >( stops.size() );
+    for ( const auto& stop : stops )
+        s << stop.position() << stop.color();
+
+    s << static_cast< quint8 >( gradient.spreadMode() );
+    s << static_cast< quint8 >( gradient.stretchMode() );
+}
+
+static QskGradient qskReadGradient( QDataStream& s )
+{
+    QskGradient gradient;
+
+    quint8 type;
+    s >> type;
+
+    switch ( type )
+    {
+        case QskGradient::Linear:
+        {
+            qreal x1, y1, x2, y2;
+            s >> x1 >> y1 >> x2 >> y2;
+
+            gradient.setLinearDirection( x1, y1, x2, y2 );
+            break;
+        }
+        case QskGradient::Radial:
+        {
+            qreal x, y, radiusX, radiusY;
+            s >> x >> y >> radiusX >> radiusY;
+
+            gradient.setRadialDirection( x, y, radiusX, radiusY );
+            break;
+        }
+        case QskGradient::Conic:
+        {
+            qreal x, y, startAngle, spanAngle, aspectRatio;
+            s >> x >> y >> startAngle >> spanAngle >> aspectRatio;
+
+            gradient.setConicDirection( x, y, startAngle, spanAngle, aspectRatio );
+            break;
+        }
+        default:
+            break;
+    }
+
+    quint32 count;
+    s >> count;
+
+    QskGradientStops stops;
+    stops.reserve( count );
+
+    for ( quint32 i = 0; i < count; i++ )
+    {
+        qreal position;
+        QColor color;
+
+        s >> position >> color;
+        stops += QskGradientStop( position, color );
+    }
+
+    gradient.setStops( stops );
+
+    quint8 spreadMode, stretchMode;
+    s >> spreadMode >> stretchMode;
+
+    gradient.setSpreadMode( static_cast< QskGradient::SpreadMode >( spreadMode ) );
+    gradient.setStretchMode( static_cast< QskGradient::StretchMode >( stretchMode ) );
+
+    return gradient;
+}
+
+static bool qskWriteValue( QDataStream& s, const QVariant& value )
+{
+    const int type = value.userType();
+
+    if ( !value.isValid() )
+    {
+        s << static_cast< quint8 >( InvalidValue );
+    }
+    else if ( type == qMetaTypeId< QskMargins >() )
+    {
+        const auto margins = value.value< QskMargins >();
+
+        s << static_cast< quint8 >( MarginsValue );
+        s << margins.left() << margins.top() << margins.right() << margins.bottom();
+    }
+    else if ( type == qMetaTypeId< QskBoxShapeMetrics >() )
+    {
+        const auto shape = value.value< QskBoxShapeMetrics >();
+
+        s << static_cast< quint8 >( BoxShapeValue );
+        s << shape.topLeft() << shape.topRight()
+            << shape.bottomLeft() << shape.bottomRight();
+        s << static_cast< quint8 >( shape.sizeMode() );
+        s << static_cast< quint8 >( shape.scalingMode() );
+    }
+    else if ( type == qMetaTypeId< QskBoxBorderMetrics >() )
+    {
+        const auto border = value.value< QskBoxBorderMetrics >();
+        const auto& widths = border.widths();
+
+        s << static_cast< quint8 >( BoxBorderMetricsValue );
+        s << widths.left() << widths.top() << widths.right() << widths.bottom();
+        s << static_cast< quint8 >( border.sizeMode() );
+    }
+    else if ( type == qMetaTypeId< QskBoxBorderColors >() )
+    {
+        const auto colors = value.value< QskBoxBorderColors >();
+
+        s << static_cast< quint8 >( BoxBorderColorsValue );
+        qskWriteGradient( s, colors.left() );
+        qskWriteGradient( s, colors.top() );
+        qskWriteGradient( s, colors.right() );
+        qskWriteGradient( s, colors.bottom() );
+    }
+    else if ( type == qMetaTypeId< QskGradient >() )
+    {
+        s << static_cast< quint8 >( GradientValue );
+        qskWriteGradient( s, value.value< QskGradient >() );
+    }
+    else if ( type == qMetaTypeId< QskShadowMetrics >() )
+    {
+        const auto shadow = value.value< QskShadowMetrics >();
+
+        s << static_cast< quint8 >( ShadowMetricsValue );
+        s << shadow.spreadRadius() << shadow.blurRadius() << shadow.offset();
+        s << static_cast< quint8 >( shadow.sizeMode() );
+    }
+    else if ( type == qMetaTypeId< QskArcMetrics >() )
+    {
+        const auto arc = value.value< QskArcMetrics >();
+
+        s << static_cast< quint8 >( ArcMetricsValue );
+        s << arc.startAngle() << arc.spanAngle() << arc.thickness();
+        s << static_cast< quint8 >( arc.sizeMode() );
+    }
+    else if ( type == qMetaTypeId< QskStippleMetrics >() )
+    {
+        const auto stipple = value.value< QskStippleMetrics >();
+
+        s << static_cast< quint8 >( StippleMetricsValue );
+        s << stipple.offset() << stipple.pattern();
+    }
+    else if ( type == qMetaTypeId< QskGraduationMetrics >() )
+    {
+        const auto graduation = value.value< QskGraduationMetrics >();
+
+        s << static_cast< quint8 >( GraduationMetricsValue );
+        s << graduation.minorTickLength() << graduation.mediumTickLength()
+            << graduation.majorTickLength() << graduation.tickWidth();
+    }
+    else if ( type == qMetaTypeId< QskAnimationHint >() )
+    {
+        const auto animation = value.value< QskAnimationHint >();
+
+        s << static_cast< quint8 >( AnimationValue );
+        s << static_cast< quint32 >( animation.duration );
+        s << static_cast< qint32 >( animation.type );
+        s << static_cast< qint32 >( animation.updateFlags );
+    }
+    else if ( type == qMetaTypeId< QskFontRole >() )
+    {
+        const auto fontRole = value.value< QskFontRole >();
+
+        s << static_cast< quint8 >( FontRoleValue );
+        s << static_cast< qint32 >( fontRole.category() );
+        s << static_cast< qint32 >( fontRole.emphasis() );
+    }
+    else if ( type == qMetaTypeId< QskTextOptions >() )
+    {
+        const auto options = value.value< QskTextOptions >();
+
+        s << static_cast< quint8 >( TextOptionsValue );
+        s << static_cast< qint32 >( options.format() );
+        s << static_cast< qint32 >( options.elideMode() );
+        s << static_cast< qint32 >( options.wrapMode() );
+        s << static_cast< qint32 >( options.fontSizeMode() );
+        s << static_cast< qint32 >( options.maximumLineCount() );
+    }
+    else if ( type == qMetaTypeId< QskGraphic >() )
+    {
+        QByteArray data;
+        QskGraphicIO::write( value.value< QskGraphic >(), data );
+
+        s << static_cast< quint8 >( GraphicValue );
+        s << data;
+    }
+    else if ( qskIsEnum( type ) )
+    {
+        s << static_cast< quint8 >( EnumValue );
+        s << qskTypeName( type ) << value.toLongLong();
+    }
+    else if ( type < QMetaType::User )
+    {
+        s << static_cast< quint8 >( BuiltinValue );
+        s << value;
+    }
+    else
+    {
+        qWarning( "QskSkinHintTableIO::write: unsupported type: %s",
+            qskTypeName( type ).constData() );
+
+        return false;
+    }
+
+    return s.status() == QDataStream::Ok;
+}
+
+static bool qskReadValue( QDataStream& s, QVariant& value )
+{
+    quint8 valueType;
+    s >> valueType;
+
+    switch ( valueType )
+    {
+        case InvalidValue:
+        {
+            value = QVariant();
+            break;
+        }
+        case BuiltinValue:
+        {
+            s >> value;
+            break;
+        }
+        case EnumValue:
+        {
+            QByteArray typeName;
+            qint64 v;
+
+            s >> typeName >> v;
+            value = qskEnumValue( typeName, v );
+
+            break;
+        }
+        case MarginsValue:
+        {
+            qreal left, top, right, bottom;
+            s >> left >> top >> right >> bottom;
+
+            value = QVariant::fromValue( QskMargins( left, top, right, bottom ) );
+            break;
+        }
+        case BoxShapeValue:
+        {
+            QSizeF topLeft, topRight, bottomLeft, bottomRight;
+            quint8 sizeMode, scalingMode;
+
+            s >> topLeft >> topRight >> bottomLeft >> bottomRight;
+            s >> sizeMode >> scalingMode;
+
+            QskBoxShapeMetrics shape;
+            shape.setRadius( topLeft, topRight, bottomLeft, bottomRight );
+            shape.setSizeMode( static_cast< Qt::SizeMode >( sizeMode ) );
+            shape.setScalingMode(
+                static_cast< QskBoxShapeMetrics::ScalingMode >( scalingMode ) );
+
+            value = QVariant::fromValue( shape );
+            break;
+        }
+        case BoxBorderMetricsValue:
+        {
+            qreal left, top, right, bottom;
+            quint8 sizeMode;
+
+            s >> left >> top >> right >> bottom >> sizeMode;
+
+            value = QVariant::fromValue( QskBoxBorderMetrics( left, top,
+                right, bottom, static_cast< Qt::SizeMode >( sizeMode ) ) );
+            break;
+        }
+        case BoxBorderColorsValue:
+        {
+            const auto left = qskReadGradient( s );
+            const auto top = qskReadGradient( s );
+            const auto right = qskReadGradient( s );
+            const auto bottom = qskReadGradient( s );
+
+            value = QVariant::fromValue( QskBoxBorderColors( left, top, right, bottom ) );
+            break;
+        }
+        case GradientValue:
+        {
+            value = QVariant::fromValue( qskReadGradient( s ) );
+            break;
+        }
+        case ShadowMetricsValue:
+        {
+            qreal spreadRadius, blurRadius;
+            QPointF offset;
+            quint8 sizeMode;
+
+            s >> spreadRadius >> blurRadius >> offset >> sizeMode;
+
+            value = QVariant::fromValue( QskShadowMetrics( spreadRadius,
+                blurRadius, offset, static_cast< Qt::SizeMode >( sizeMode ) ) );
+            break;
+        }
+        case ArcMetricsValue:
+        {
+            qreal startAngle, spanAngle, thickness;
+            quint8 sizeMode;
+
+            s >> startAngle >> spanAngle >> thickness >> sizeMode;
+
+            value = QVariant::fromValue( QskArcMetrics( startAngle, spanAngle,
+                thickness, static_cast< Qt::SizeMode >( sizeMode ) ) );
+            break;
+        }
+        case StippleMetricsValue:
+        {
+            qreal offset;
+            QVector< qreal > pattern;
+
+            s >> offset >> pattern;
+
+            value = QVariant::fromValue( QskStippleMetrics( pattern, offset ) );
+            break;
+        }
+        case GraduationMetricsValue:
+        {
+            qreal minorTickLength, mediumTickLength, majorTickLength, tickWidth;
+            s >> minorTickLength >> mediumTickLength >> majorTickLength >> tickWidth;
+
+            value = QVariant::fromValue( QskGraduationMetrics( minorTickLength,
+                mediumTickLength, majorTickLength, tickWidth ) );
+            break;
+        }
+        case AnimationValue:
+        {
+            quint32 duration;
+            qint32 type, updateFlags;
+
+            s >> duration >> type >> updateFlags;
+
+            QskAnimationHint animation( duration, static_cast< QEasingCurve::Type >( type ) );
+            animation.updateFlags = QskAnimationHint::UpdateFlags( QFlag( updateFlags ) );
+
+            value = QVariant::fromValue( animation );
+            break;
+        }
+        case FontRoleValue:
+        {
+            qint32 category, emphasis;
+            s >> category >> emphasis;
+
+            value = QVariant::fromValue( QskFontRole(
+                static_cast< QskFontRole::Category >( category ),
+                static_cast< QskFontRole::Emphasis >( emphasis ) ) );
+            break;
+        }
+        case TextOptionsValue:
+        {
+            qint32 format, elideMode, wrapMode, fontSizeMode, maximumLineCount;
+            s >> format >> elideMode >> wrapMode >> fontSizeMode >> maximumLineCount;
+
+            QskTextOptions options;
+            options.setFormat( static_cast< QskTextOptions::TextFormat >( format ) );
+            options.setElideMode( static_cast< Qt::TextElideMode >( elideMode ) );
+            options.setWrapMode( static_cast< QskTextOptions::WrapMode >( wrapMode ) );
+            options.setFontSizeMode(
+                static_cast< QskTextOptions::FontSizeMode >( fontSizeMode ) );
+            options.setMaximumLineCount( maximumLineCount );
+
+            value = QVariant::fromValue( options );
+            break;
+        }
+        case GraphicValue:
+        {
+            QByteArray data;
+            s >> data;
+
+            value = QVariant::fromValue( QskGraphicIO::read( data ) );
+            break;
+        }
+        default:
+        {
+            qWarning( "QskSkinHintTableIO::read: unknown value type: %d", valueType );
+            return false;
+        }
+    }
+
+    return s.status() == QDataStream::Ok;
+}
+
+/*
+    Lengths of a value, that might have been specified in dp/px.
+    Other components - like angles or the size modes - are never
+    scaled and are not included. There are never more than 32 lengths,
+    so that their units can be stored as bit masks.
+ */
+static QVector< qreal > qskLengths( const QVariant& value )
+{
+    const int type = value.userType();
+
+    if ( type == QMetaType::Double || type == QMetaType::Float
+        || type == QMetaType::Int )
+    {
+        return { value.toReal() };
+    }
+
+    if ( type == QMetaType::QSizeF )
+    {
+        const auto size = value.toSizeF();
+        return { size.width(), size.height() };
+    }
+
+    if ( type == QMetaType::QPointF )
+    {
+        const auto pos = value.toPointF();
+        return { pos.x(), pos.y() };
+    }
+
+    if ( type == qMetaTypeId< QskMargins >() )
+    {
+        const auto margins = value.value< QskMargins >();
+        return { margins.left(), margins.top(), margins.right(), margins.bottom() };
+    }
+
+    if ( type == qMetaTypeId< QskBoxShapeMetrics >() )
+    {
+        const auto shape = value.value< QskBoxShapeMetrics >();
+
+        return { shape.topLeft().width(), shape.topLeft().height(),
+            shape.topRight().width(), shape.topRight().height(),
+            shape.bottomLeft().width(), shape.bottomLeft().height(),
+            shape.bottomRight().width(), shape.bottomRight().height() };
+    }
+
+    if ( type == qMetaTypeId< QskBoxBorderMetrics >() )
+    {
+        const auto widths = value.value< QskBoxBorderMetrics >().widths();
+        return { widths.left(), widths.top(), widths.right(), widths.bottom() };
+    }
+
+    if ( type == qMetaTypeId< QskShadowMetrics >() )
+    {
+        const auto shadow = value.value< QskShadowMetrics >();
+
+        return { shadow.spreadRadius(), shadow.blurRadius(),
+            shadow.offset().x(), shadow.offset().y() };
+    }
+
+    if ( type == qMetaTypeId< QskArcMetrics >() )
+        return { value.value< QskArcMetrics >().thickness() };
+
+    if ( type == qMetaTypeId< QskGraduationMetrics >() )
+    {
+        const auto graduation = value.value< QskGraduationMetrics >();
+
+        return { graduation.minorTickLength(), graduation.mediumTickLength(),
+            graduation.majorTickLength(), graduation.tickWidth() };
+    }
+
+    return {};
+}
+
+static QVariant qskWithLengths( const QVariant& value, const QVector< qreal >& l )
+{
+    const int type = value.userType();
+
+    if ( type == QMetaType::Double )
+        return QVariant::fromValue( l[0] );
+
+    if ( type == QMetaType::Float )
+        return QVariant::fromValue( static_cast< float >( l[0] ) );
+
+    if ( type == QMetaType::Int )
+        return QVariant::fromValue( qRound( l[0] ) );
+
+    if ( type == QMetaType::QSizeF )
+        return QVariant::fromValue( QSizeF( l[0], l[1] ) );
+
+    if ( type == QMetaType::QPointF )
+        return QVariant::fromValue( QPointF( l[0], l[1] ) );
+
+    if ( type == qMetaTypeId< QskMargins >() )
+        return QVariant::fromValue( QskMargins( l[0], l[1], l[2], l[3] ) );
+
+    if ( type == qMetaTypeId< QskBoxShapeMetrics >() )
+    {
+        auto shape = value.value< QskBoxShapeMetrics >();
+        shape.setRadius( QSizeF( l[0], l[1] ), QSizeF( l[2], l[3] ),
+            QSizeF( l[4], l[5] ), QSizeF( l[6], l[7] ) );
+
+        return QVariant::fromValue( shape );
+    }
+
+    if ( type == qMetaTypeId< QskBoxBorderMetrics >() )
+    {
+        auto border = value.value< QskBoxBorderMetrics >();
+        border.setWidths( QskMargins( l[0], l[1], l[2], l[3] ) );
+
+        return QVariant::fromValue( border );
+    }
+
+    if ( type == qMetaTypeId< QskShadowMetrics >() )
+    {
+        auto shadow = value.value< QskShadowMetrics >();
+        shadow.setSpreadRadius( l[0] );
+        shadow.setBlurRadius( l[1] );
+        shadow.setOffset( l[2], l[3] );
+
+        return QVariant::fromValue( shadow );
+    }
+
+    if ( type == qMetaTypeId< QskArcMetrics >() )
+    {
+        auto arc = value.value< QskArcMetrics >();
+        arc.setThickness( l[0] );
+
+        return QVariant::fromValue( arc );
+    }
+
+    if ( type == qMetaTypeId< QskGraduationMetrics >() )
+    {
+        return QVariant::fromValue(
+            QskGraduationMetrics( l[0], l[1], l[2], l[3] ) );
+    }
+
+    return value;
+}
+
+static void qskProbeUnits( QskAspect aspect, const QVariant& value,
+    const QVariant& probeValue, quint32& dpLengths, quint32& pxLengths )
+{
+    /*
+        value has been created with dp/px factors of 1.0, probeValue
+        with ProbeDpFactor/ProbePxFactor. Lengths, that have been scaled
+        by one of the factors, are in dp/px.
+     */
+
+    dpLengths = pxLengths = 0;
+
+    const auto lengths = qskLengths( value );
+    if ( lengths.isEmpty() )
+        return;
+
+    const auto probeLengths = qskLengths( probeValue );
+    if ( probeValue.userType() != value.userType()
+        || probeLengths.size() != lengths.size() )
+    {
+        qWarning() << "QskSkinHintTableIO::write: no probe value for" << aspect;
+        return;
+    }
+
+    for ( int i = 0; i < lengths.size(); i++ )
+    {
+        const auto length = lengths[i];
+        const auto probeLength = probeLengths[i];
+
+        if ( qFuzzyCompare( length, probeLength ) )
+            continue;
+
+        const quint32 bit = 1u << i;
+
+        if ( qFuzzyCompare( length * QskSkinHintTableIO::ProbeDpFactor, probeLength ) )
+        {
+            dpLengths |= bit;
+        }
+        else if ( qFuzzyCompare( length * QskSkinHintTableIO::ProbePxFactor, probeLength ) )
+        {
+            pxLengths |= bit;
+        }
+        else
+        {
+            /*
+                Not proportional to dp/px, f.e because of rounding.
+                We store the value for a factor of 1.0.
+             */
+            qWarning() << "QskSkinHintTableIO::write: unknown unit for" << aspect;
+        }
+    }
+}
+
+static QVariant qskConvertedUnits( const QVariant& value,
+    quint32 dpLengths, quint32 pxLengths, qreal dpFactor, qreal pxFactor )
+{
+    auto lengths = qskLengths( value );
+
+    for ( int i = 0; i < lengths.size(); i++ )
+    {
+        const quint32 bit = 1u << i;
+
+        if ( dpLengths & bit )
+            lengths[i] *= dpFactor;
+        else if ( pxLengths & bit )
+            lengths[i] *= pxFactor;
+    }
+
+    return qskWithLengths( value, lengths );
+}
+
+static inline void qskWriteAspect( QDataStream& s,
+    QskAspect aspect, QHash< quint16, quint16 >& subControlIndexes )
+{
+    /*
+        The values for the subcontrols depend on the order of their registration,
+        what might be different in the application. So we store an index into
+        a table of subcontrol names instead.
+     */
+
+    s << subControlIndexes.value( aspect.subControl(), 0 );
+
+    s << static_cast< quint8 >( aspect.section() );
+    s << static_cast< quint8 >( aspect.type() );
+    s << static_cast< quint8 >( aspect.primitive() );
+    s << static_cast< quint8 >( aspect.variation() );
+    s << static_cast< quint8 >( aspect.isAnimator() );
+    s << static_cast< quint16 >( aspect.states() );
+}
+
+static inline bool qskReadAspect( QDataStream& s,
+    const QVector< QskAspect::Subcontrol >& subControls, QskAspect& aspect )
+{
+    quint16 subControlIndex, states;
+    quint8 section, type, primitive, variation, isAnimator;
+
+    s >> subControlIndex >> section >> type
+        >> primitive >> variation >> isAnimator >> states;
+
+    const auto subControl = subControls.value( subControlIndex, QskAspect::NoSubcontrol );
+
+    aspect = QskAspect( subControl );
+    aspect.setSection( static_cast< QskAspect::Section >( section ) );
+    aspect.setPrimitive( static_cast< QskAspect::Type >( type ),
+        static_cast< QskAspect::Primitive >( primitive ) );
+    aspect.setVariation( static_cast< QskAspect::Variation >( variation ) );
+    aspect.setAnimator( isAnimator );
+    aspect.setStates( static_cast< QskAspect::State >( states ) );
+
+    // false, when the subcontrol is unknown in the application
+    return ( subControlIndex == 0 ) || ( subControl != QskAspect::NoSubcontrol );
+}
+
+static bool qskWriteTable( const QskSkinHintTable& table,
+    const QskSkinHintTable* probeTable, QIODevice* dev )
+{
+    if ( dev == nullptr )
+        return false;
+
+    const auto& hints = table.hints();
+
+    // sorted, so that the output is reproducible
+    auto aspects = hints.keys();
+    std::sort( aspects.begin(), aspects.end() );
+
+    QHash< quint16, quint16 > subControlIndexes;
+    QVector< QByteArray > subControlNames;
+
+    for ( const auto aspect : std::as_const( aspects ) )
+    {
+        const auto subControl = aspect.subControl();
+
+        if ( subControl != QskAspect::NoSubcontrol
+            && !subControlIndexes.contains( subControl ) )
+        {
+            subControlNames += QskAspect::subControlName( subControl );
+            subControlIndexes.insert( subControl, subControlNames.size() );
+        }
+    }
+
+    QDataStream stream( dev );
+    stream.setVersion( qskDataStreamVersion );
+    stream.setByteOrder( QDataStream::BigEndian );
+
+    stream.writeRawData( qskMagicNumber, 4 );
+    stream << qskFormatVersion;
+
+    stream << static_cast< quint32 >( subControlNames.size() );
+    for ( const auto& name : std::as_const( subControlNames ) )
+        stream << name;
+
+    stream << static_cast< quint32 >( aspects.size() );
+
+    for ( const auto aspect : std::as_const( aspects ) )
+    {
+        qskWriteAspect( stream, aspect, subControlIndexes );
+
+        const auto& value = hints[ aspect ];
+        if ( !qskWriteValue( stream, value ) )
+            return false;
+
+        quint32 dpLengths = 0;
+        quint32 pxLengths = 0;
+
+        if ( probeTable )
+        {
+            qskProbeUnits( aspect, value, probeTable->hints().value( aspect ),
+                dpLengths, pxLengths );
+        }
+
+        stream << dpLengths << pxLengths;
+    }
+
+    return stream.status() == QDataStream::Ok;
+}
+
+bool QskSkinHintTableIO::read( const QString& fileName, QskSkinHintTable& table )
+{
+    QFile file( fileName );
+    if ( file.open( QIODevice::ReadOnly ) == false )
+    {
+        qWarning( "QskSkinHintTableIO::read can't open %s", qPrintable( fileName ) );
+        return false;
+    }
+
+    return read( &file, table );
+}
+
+bool QskSkinHintTableIO::read( const QByteArray& data, QskSkinHintTable& table )
+{
+    QBuffer buffer;
+    buffer.setData( data );
+
+    return read( &buffer, table );
+}
+
+bool QskSkinHintTableIO::read( QIODevice* dev, QskSkinHintTable& table )
+{
+    if ( dev == nullptr )
+        return false;
+
+    if ( !dev->isOpen() && !dev->open( QIODevice::ReadOnly ) )
+        return false;
+
+    QDataStream stream( dev );
+    stream.setVersion( qskDataStreamVersion );
+    stream.setByteOrder( QDataStream::BigEndian );
+
+    char magicNumber[ 4 ];
+    stream.readRawData( magicNumber, 4 );
+    if ( memcmp( magicNumber, qskMagicNumber, 4 ) != 0 )
+    {
+        qWarning( "QskSkinHintTableIO::read: bad magic number" );
+        return false;
+    }
+
+    quint32 version;
+    stream >> version;
+
+    if ( version != qskFormatVersion )
+    {
+        qWarning( "QskSkinHintTableIO::read: unsupported version: %u", version );
+        return false;
+    }
+
+    QVector< QskAspect::Subcontrol > subControls;
+
+    {
+        QHash< QByteArray, QskAspect::Subcontrol > subControlTable;
+
+        const auto names = QskAspect::subControlNames();
+        for ( int i = 0; i < names.size(); i++ )
+            subControlTable.insert( names[ i ], static_cast< QskAspect::Subcontrol >( i + 1 ) );
+
+        quint32 count;
+        stream >> count;
+
+        subControls.reserve( count + 1 );
+        subControls += QskAspect::NoSubcontrol;
+
+        for ( quint32 i = 0; i < count; i++ )
+        {
+            QByteArray name;
+            stream >> name;
+
+            const auto subControl = subControlTable.value( name, QskAspect::NoSubcontrol );
+            if ( subControl == QskAspect::NoSubcontrol )
+            {
+                qWarning( "QskSkinHintTableIO::read: unknown subcontrol: %s",
+                    name.constData() );
+            }
+
+            subControls += subControl;
+        }
+    }
+
+    quint32 count;
+    stream >> count;
+
+    QskSkinHintTable hintTable;
+    hintTable.reserve( count );
+
+    for ( quint32 i = 0; i < count; i++ )
+    {
+        QskAspect aspect;
+        const bool isValid = qskReadAspect( stream, subControls, aspect );
+
+        QVariant value;
+        if ( !qskReadValue( stream, value ) )
+            return false;
+
+        if ( isValid )
+            hintTable.setHint( aspect, value );
+    }
+
+    if ( stream.status() != QDataStream::Ok )
+        return false;
+
+    table = hintTable;
+    return true;
+}
+
+bool QskSkinHintTableIO::write( const QskSkinHintTable& table, const QString& fileName )
+{
+    QFile file( fileName );
+    if ( file.open( QIODevice::WriteOnly | QIODevice::Truncate ) == false )
+    {
+        qWarning( "QskSkinHintTableIO::write can't open %s", qPrintable( fileName ) );
+        return false;
+    }
+
+    return qskWriteTable( table, nullptr, &file );
+}
+
+bool QskSkinHintTableIO::write( const QskSkinHintTable& table, QByteArray& data )
+{
+    QBuffer buffer( &data );
+    if ( !buffer.open( QIODevice::WriteOnly ) )
+        return false;
+
+    return qskWriteTable( table, nullptr, &buffer );
+}
+
+bool QskSkinHintTableIO::write( const QskSkinHintTable& table, QIODevice* dev )
+{
+    return qskWriteTable( table, nullptr, dev );
+}
+
+bool QskSkinHintTableIO::write( const QskSkinHintTable& table,
+    const QskSkinHintTable& probeTable, const QString& fileName )
+{
+    QFile file( fileName );
+    if ( file.open( QIODevice::WriteOnly | QIODevice::Truncate ) == false )
+    {
+        qWarning( "QskSkinHintTableIO::write can't open %s", qPrintable( fileName ) );
+        return false;
+    }
+
+    return qskWriteTable( table, &probeTable, &file );
+}
+
+bool QskSkinHintTableIO::write( const QskSkinHintTable& table,
+    const QskSkinHintTable& probeTable, QIODevice* dev )
+{
+    return qskWriteTable( table, &probeTable, dev );
+}
@@ -0,0 +1,53 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_SKIN_HINT_TABLE_IO_H
+#define QSK_SKIN_HINT_TABLE_IO_H
+
+#include "QskGlobal.h"
+
+class QskSkinHintTable;
+class QString;
+class QIODevice;
+class QByteArray;
+
+/*
+    A binary format for precompiled hint tables, that can be
+    generated at build time ( see skin2hints and the qsk_skin2hints
+    cmake function ) and loaded without running the code of the skin.
+
+    Lengths, that have been specified in dp/px, are stored unconverted
+    and are converted with qskDpToPixelsFactor()/qskPxToPixelsFactor()
+    when reading the file.
+ */
+namespace QskSkinHintTableIO
+{
+    QSK_EXPORT bool read( const QString& fileName, QskSkinHintTable& );
+    QSK_EXPORT bool read( const QByteArray& data, QskSkinHintTable& );
+    QSK_EXPORT bool read( QIODevice* dev, QskSkinHintTable& );
+
+    // all values are stored as they are
+    QSK_EXPORT bool write( const QskSkinHintTable&, const QString& fileName );
+    QSK_EXPORT bool write( const QskSkinHintTable&, QByteArray& data );
+    QSK_EXPORT bool write( const QskSkinHintTable&, QIODevice* dev );
+
+    /*
+        The units of the lengths are found by comparing two tables of
+        the same skin: table has been created with dp/px factors of 1.0,
+        probeTable with ProbeDpFactor/ProbePxFactor ( see QSK_DP_FACTOR
+        and QSK_PX_FACTOR ). Lengths, that differ by one of these factors,
+        are stored as dp/px.
+     */
+    constexpr qreal ProbeDpFactor = 2.0;
+    constexpr qreal ProbePxFactor = 3.0;
+
+    QSK_EXPORT bool write( const QskSkinHintTable& table,
+        const QskSkinHintTable& probeTable, const QString& fileName );
+
+    QSK_EXPORT bool write( const QskSkinHintTable& table,
+        const QskSkinHintTable& probeTable, QIODevice* dev );
+}
+
+#endif
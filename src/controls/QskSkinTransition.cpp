@@ -19,6 +19,7 @@
 #include <qobject.h>
 #include <qvector.h>
 #include <qhash.h>
+#include <qset.h>
 
 #include <vector>
 
@@ -55,7 +56,170 @@ static QskAspect::State qskSelectedSampleState( const QskControl* control )
 
 static bool qskHasHintTable( const QskSkin* skin, const QskSkinHintTable& hintTable )
 {
-    return skin->hintTable().hints().isSharedWith( hintTable.hints() );
+    return skin->hintTable().isSharedWith( hintTable );
+}
+
+namespace
+{
+    /*
+        A lookup table from the subcontrols to the controls of a window,
+        that are using them. So setting up a transition only needs to look
+        at the controls, that are affected by the differences of the tables.
+
+        The index is built, when running the first transition for a window,
+        and then kept up to date, when controls enter or leave the window or
+        change their subcontrol proxies. As the subcontrols can't be
+        retrieved before a control has been completely constructed,
+        new controls are pending until the next transition.
+     */
+    class ControlIndex
+    {
+      public:
+        ControlIndex( QQuickWindow* );
+
+        void insert( const QskControl* );
+        void remove( const QskControl* );
+
+        void update();
+
+        // all controls
+        QVector< const QskControl* > controls() const;
+
+        // the controls using subControl
+        inline const QSet< const QskControl* >* controls(
+            QskAspect::Subcontrol subControl ) const
+        {
+            const auto it = m_controls.constFind( subControl );
+            return ( it != m_controls.constEnd() ) ? &it.value() : nullptr;
+        }
+
+      private:
+        void insertRecursive( QQuickItem* );
+
+        QSet< const QskControl* > m_pending;
+
+        QHash< const QskControl*, QVector< QskAspect::Subcontrol > > m_subControls;
+        QHash< QskAspect::Subcontrol, QSet< const QskControl* > > m_controls;
+    };
+
+    class ControlIndexTable : public QHash< const QQuickWindow*, ControlIndex* >
+    {
+      public:
+        ~ControlIndexTable()
+        {
+            qDeleteAll( *this );
+        }
+    };
+}
+
+Q_GLOBAL_STATIC( ControlIndexTable, qskControlIndexTable )
+
+ControlIndex::ControlIndex( QQuickWindow* window )
+{
+    insertRecursive( window->contentItem() );
+}
+
+void ControlIndex::insertRecursive( QQuickItem* item )
+{
+    if ( auto control = qskControlCast( item ) )
+        m_pending += control;
+
+    const auto children = item->childItems();
+    for ( auto child : children )
+        insertRecursive( child );
+}
+
+void ControlIndex::insert( const QskControl* control )
+{
+    m_pending += control;
+}
+
+void ControlIndex::remove( const QskControl* control )
+{
+    if ( m_pending.remove( control ) )
+        return;
+
+    const auto it = m_subControls.constFind( control );
+    if ( it == m_subControls.constEnd() )
+        return;
+
+    for ( const auto subControl : it.value() )
+    {
+        auto& controls = m_controls[ subControl ];
+
+        controls.remove( control );
+        if ( controls.isEmpty() )
+            m_controls.remove( subControl );
+    }
+
+    m_subControls.erase( it );
+}
+
+void ControlIndex::update()
+{
+    for ( const auto control : std::as_const( m_pending ) )
+    {
+        const auto subControls = control->subControls();
+
+        for ( const auto subControl : subControls )
+            m_controls[ subControl ] += control;
+
+        m_subControls.insert( control, subControls );
+    }
+
+    m_pending.clear();
+}
+
+QVector< const QskControl* > ControlIndex::controls() const
+{
+    QVector< const QskControl* > controls;
+    controls.reserve( m_subControls.size() );
+
+    for ( auto it = m_subControls.constBegin(); it != m_subControls.constEnd(); ++it )
+        controls += it.key();
+
+    return controls;
+}
+
+static ControlIndex* qskControlIndex( QQuickWindow* window )
+{
+    auto& index = ( *qskControlIndexTable )[ window ];
+
+    if ( index == nullptr )
+    {
+        index = new ControlIndex( window );
+
+        QObject::connect( window, &QObject::destroyed,
+            [ window ]()
+            {
+                if ( qskControlIndexTable.exists() )
+                    delete qskControlIndexTable->take( window );
+            }
+        );
+    }
+
+    index->update();
+    return index;
+}
+
+/*
+    Called from QskControl/QskSkinnable, when the window or the subcontrols
+    of a control might have changed. As long as no transition has been run
+    for a window, there is nothing to do.
+ */
+void qskUpdateControlIndex( const QskControl* control, bool isDestroyed )
+{
+    if ( !qskControlIndexTable.exists() || qskControlIndexTable->isEmpty() )
+        return;
+
+    for ( auto index : std::as_const( *qskControlIndexTable ) )
+        index->remove( control );
+
+    if ( !isDestroyed )
+    {
+        if ( auto index = qskControlIndexTable->value( control->window() ) )
+            index->insert( control );
+    }
 }
 
 static void qskSendStyleEventRecursive( QQuickItem* item )
@@ -68,51 +232,75 @@ static void qskSendStyleEventRecursive( QQuickItem* item )
         qskSendStyleEventRecursive( child );
 }
 
+static inline bool qskIsCandidate(
+    const QskSkinTransition::Type mask, const QskAspect aspect )
+{
+    switch( aspect.type() )
+    {
+        case QskAspect::NoType:
+        {
+            if ( aspect.primitive() == QskAspect::GraphicRole )
+                return mask & QskSkinTransition::Color;
+
+            if ( aspect.primitive() == QskAspect::FontRole )
+                return mask & QskSkinTransition::Metric;
+
+            break;
+        }
+        case QskAspect::Color:
+        {
+            return mask & QskSkinTransition::Color;
+        }
+        case QskAspect::Metric:
+        {
+            return mask & QskSkinTransition::Metric;
+        }
+    }
+
+    return false;
+}
+
+static inline bool qskHasResolvedHint(
+    const QskSkinHintTable& table, QskAspect aspect )
+{
+    // resolvedHint() would box the value into the table
+    bool ok;
+    ( void ) table.resolvedValue( aspect, nullptr, &ok );
+
+    return ok;
+}
+
 static void qskAddCandidates( const QskSkinTransition::Type mask,
-    const QHash< QskAspect, QVariant >& hints, QSet< QskAspect >& candidates )
+    const QHash< QskAspect, QVariant >& hints,
+    const QHash< QskAspect, QVariant >& otherHints, QSet< QskAspect >& candidates )
 {
+    /*
+        Hints are always resolved from entries with the same trunk. So when
+        all entries of a trunk are the same in both tables, the resolved
+        values will be the same for all controls and we can skip it.
+     */
+
     for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
     {
         const auto aspect = it.key().trunk();
 
-        if ( aspect.isAnimator() )
+        if ( aspect.isAnimator() || candidates.contains( aspect ) )
             continue;
 
-        bool isCandidate = false;
-
-        switch( aspect.type() )
-        {
-            case QskAspect::NoType:
-            {
-                if ( aspect.primitive() == QskAspect::GraphicRole )
-                {
-                    isCandidate = mask & QskSkinTransition::Color;
-                }
-                else if ( aspect.primitive() == QskAspect::FontRole )
-                {
-                    isCandidate = mask & QskSkinTransition::Metric;
-                }
-                break;
-            }
-            case QskAspect::Color:
-            {
-                isCandidate = mask & QskSkinTransition::Color;
-                break;
-            }
-            case QskAspect::Metric:
-            {
-                isCandidate = mask & QskSkinTransition::Metric;
-                break;
-            }
-        }
+        if ( !qskIsCandidate( mask, aspect ) )
+            continue;
 
-        if ( isCandidate )
+        const auto otherIt = otherHints.constFind( it.key() );
+        if ( otherIt == otherHints.constEnd() || otherIt.value() != it.value() )
             candidates += aspect;
     }
 }
 
 namespace
 {
+    // the differing aspects of the hint tables, grouped by subcontrol
+    using Candidates = QHash< QskAspect::Subcontrol, QVector< QskAspect > >;
+
     class UpdateInfo
     {
       public:
@@ -169,16 +357,19 @@ namespace
         void addFontSizeAnimators( const QskAnimationHint&,
             const QHash< QskFontRole, QFont >&, const QHash< QskFontRole, QFont >& );
 
-        void addItemAspects( QQuickItem*,
-            const QskAnimationHint&, const QSet< QskAspect >&,
-            const QskSkinHintTable&, const QskSkinHintTable& );
+        void addItemAspects( const QskAnimationHint&, const Candidates&,
+            const QskSkinHintTable&, const QskSkinHintTable&, bool updateAll );
 
         void update();
 
       private:
+        bool isControlRelevant( const QskControl*, const QskSkinHintTable& ) const;
 
-        bool isControlAffected( const QskControl*,
-            const QVector< QskAspect::Subcontrol >&, QskAspect ) const;
+        bool isControlAffected( const QskControl*, QskAspect ) const;
+
+        void addControlAspect( const QskControl*,
+            const QskAnimationHint&, QskAspect,
+            const QskSkinHintTable&, const QskSkinHintTable& );
 
         void addHint( const QskControl*,
             const QskAnimationHint&, QskAspect,
@@ -386,38 +577,23 @@ void WindowAnimator::addFontSizeAnimators(
     }
 }
 
-void WindowAnimator::addItemAspects( QQuickItem* item,
-    const QskAnimationHint& animatorHint, const QSet< QskAspect >& candidates,
-    const QskSkinHintTable& table1, const QskSkinHintTable& table2 )
+void WindowAnimator::addItemAspects(
+    const QskAnimationHint& animatorHint, const Candidates& candidates,
+    const QskSkinHintTable& table1, const QskSkinHintTable& table2,
+    bool updateAll )
 {
-    if ( auto control = qskControlCast( ( const QQuickItem* )item ) )
-    {
-        if ( control->isVisible() && control->isInitiallyPainted() &&
-            qskHasHintTable( control->effectiveSkin(), table2 ) )
-        {
-            const auto subControls = control->subControls();
+    const auto index = qskControlIndex( m_window );
 
-            const auto& localTable = control->hintTable();
+    // the result of isControlRelevant for the controls being looked at
+    QHash< const QskControl*, bool > relevantControls;
 
-            for ( auto aspect : candidates )
-            {
-                if ( isControlAffected( control, subControls, aspect ) )
-                {
-                    aspect.setVariation( control->effectiveVariation() );
-                    aspect.setStates( control->skinStates() );
-                    aspect.setSection( control->section() );
-
-                    if ( !localTable.resolvedHint( aspect ) )
-                        addHint( control, animatorHint, aspect, table1, table2 );
-
-                    if ( auto state = qskSelectedSampleState( control ) )
-                    {
-                        aspect.addStates( state );
-                        if ( !localTable.resolvedHint( aspect ) )
-                            addHint( control, animatorHint, aspect, table1, table2 );
-                    }
-                }
-            }
+    if ( updateAll || candidates.contains( QskAspect::NoSubcontrol ) )
+    {
+        const auto controls = index->controls();
+        for ( const auto control : controls )
+        {
+            const bool isRelevant = isControlRelevant( control, table2 );
+            relevantControls.insert( control, isRelevant );
 
 #if 1
             /*
@@ -425,14 +601,65 @@ void WindowAnimator::addItemAspects( QQuickItem* item,
                 graphic filters we schedule an initial update and let the
                 controls do the rest: see QskSkinnable::effectiveGraphicFilter
              */
-            item->update();
+            if ( isRelevant && updateAll )
+                const_cast< QskControl* >( control )->update();
 #endif
         }
     }
 
-    const auto children = item->childItems();
-    for ( auto child : children )
-        addItemAspects( child, animatorHint, candidates, table1, table2 );
+    for ( auto it = candidates.constBegin(); it != candidates.constEnd(); ++it )
+    {
+        const auto controls = index->controls( it.key() );
+        if ( controls == nullptr )
+            continue;
+
+        for ( const auto control : *controls )
+        {
+            auto relevantIt = relevantControls.find( control );
+            if ( relevantIt == relevantControls.end() )
+            {
+                relevantIt = relevantControls.insert(
+                    control, isControlRelevant( control, table2 ) );
+            }
+
+            if ( !relevantIt.value() )
+                continue;
+
+            for ( const auto aspect : it.value() )
+            {
+                if ( isControlAffected( control, aspect ) )
+                    addControlAspect( control, animatorHint, aspect, table1, table2 );
+            }
+        }
+    }
+}
+
+bool WindowAnimator::isControlRelevant(
+    const QskControl* control, const QskSkinHintTable& table ) const
+{
+    return control->isVisible() && control->isInitiallyPainted()
+        && qskHasHintTable( control->effectiveSkin(), table );
+}
+
+void WindowAnimator::addControlAspect( const QskControl* control,
+    const QskAnimationHint& animatorHint, QskAspect aspect,
+    const QskSkinHintTable& table1, const QskSkinHintTable& table2 )
+{
+    const auto& localTable = control->hintTable();
+
+    aspect.setVariation( control->effectiveVariation() );
+    aspect.setStates( control->skinStates() );
+    aspect.setSection( control->section() );
+
+    if ( !qskHasResolvedHint( localTable, aspect ) )
+        addHint( control, animatorHint, aspect, table1, table2 );
+
+    if ( auto state = qskSelectedSampleState( control ) )
+    {
+        aspect.addStates( state );
+        if ( !qskHasResolvedHint( localTable, aspect ) )
+            addHint( control, animatorHint, aspect, table1, table2 );
+    }
 }
 
 void WindowAnimator::update()
@@ -458,11 +685,12 @@ void WindowAnimator::addHint( const QskControl* control,
     const QskSkinHintTable& table1, const QskSkinHintTable& table2 )
 {
     QskAspect r1, r2;
+    bool ok1, ok2;
 
-    const auto v1 = table1.resolvedHint( aspect, &r1 );
-    const auto v2 = table2.resolvedHint( aspect, &r2 );
+    const auto v1 = table1.resolvedValue( aspect, &r1, &ok1 );
+    const auto v2 = table2.resolvedValue( aspect, &r2, &ok2 );
 
-    if ( v1 && v2 )
+    if ( ok1 && ok2 )
     {
         if ( r1.section() == r2.section() )
             aspect.setSection( r2.section() );
@@ -485,32 +713,32 @@ void WindowAnimator::addHint( const QskControl* control,
             accecptIdentity = true;
         }
 
-        if ( QskVariantAnimator::maybeInterpolate( *v1, *v2, accecptIdentity ) )
+        if ( QskVariantAnimator::maybeInterpolate( v1, v2, accecptIdentity ) )
         {
-            storeAnimator( control, aspect, *v1, *v2, animatorHint );
+            storeAnimator( control, aspect, v1, v2, animatorHint );
             storeUpdateInfo( control, aspect );
         }
     }
-    else if ( v1 )
+    else if ( ok1 )
     {
         aspect.setVariation( r1.variation() );
         aspect.setStates( r1.states() );
 
-        storeAnimator( control, aspect, *v1, QVariant(), animatorHint );
+        storeAnimator( control, aspect, v1, QVariant(), animatorHint );
         storeUpdateInfo( control, aspect );
     }
-    else if ( v2 )
+    else if ( ok2 )
     {
         aspect.setVariation( r1.variation() );
         aspect.setStates( r1.states() );
 
-        storeAnimator( control, aspect, QVariant(), *v2, animatorHint );
+        storeAnimator( control, aspect, QVariant(), v2, animatorHint );
         storeUpdateInfo( control, aspect );
     }
 }
 
-inline bool WindowAnimator::isControlAffected( const QskControl* control,
-    const QVector< QskAspect::Subcontrol >& subControls, const QskAspect aspect ) const
+inline bool WindowAnimator::isControlAffected(
+    const QskControl* control, const QskAspect aspect ) const
 {
     if ( !aspect.isMetric() )
     {
@@ -531,14 +759,10 @@ inline bool WindowAnimator::isControlAffected( const QskControl* control,
         return false;
     }
 
-    if ( subControl != QskAspect::NoSubcontrol )
-    {
-        if ( !subControls.contains( subControl ) )
-        {
-            // the control is not interested in the aspect
-            return false;
-        }
-    }
+    /*
+        Being interested in the subcontrol has already been checked
+        by the index of the controls
+     */
 
     return true;
 }
@@ -724,12 +948,19 @@ void QskSkinTransition::run( const QskAnimationHint& animationHint )
     const auto& fontTable1 = m_data->tables[ 0 ].fontTable;
     const auto& fontTable2 = m_data->tables[ 1 ].fontTable;
 
-    QSet< QskAspect > candidates;
+    Candidates candidates;
 
     if ( ( animationHint.duration > 0 ) && ( m_data->mask != 0 ) )
     {
-        qskAddCandidates( m_data->mask, table1.hints(), candidates );
-        qskAddCandidates( m_data->mask, table2.hints(), candidates );
+        const auto& hints1 = table1.hints();
+        const auto& hints2 = table2.hints();
+
+        QSet< QskAspect > aspects;
+        qskAddCandidates( m_data->mask, hints1, hints2, aspects );
+        qskAddCandidates( m_data->mask, hints2, hints1, aspects );
+
+        for ( const auto aspect : std::as_const( aspects ) )
+            candidates[ aspect.subControl() ] += aspect;
     }
 
     if ( !candidates.isEmpty() )
@@ -737,6 +968,9 @@ void QskSkinTransition::run( const QskAnimationHint& animationHint )
         bool doGraphicFilter = m_data->mask & QskSkinTransition::Color;
         bool doFont = m_data->mask & QskSkinTransition::Metric;
 
+        const bool isGraphicFilterChanged =
+            doGraphicFilter && ( graphicFilters1 != graphicFilters2 );
+
         const auto windows = qGuiApp->topLevelWindows();
 
         for ( const auto window : windows )
@@ -765,13 +999,10 @@ void QskSkinTransition::run( const QskAnimationHint& animationHint )
                         fontTable1, fontTable2 );
                 }
 
-                /*
-                   finally we schedule the animators the hard way by running
-                   over the the item trees.
-                 */
+                // finally we schedule the animators for the affected controls
 
-                animator->addItemAspects( w->contentItem(),
-                    animationHint, candidates, table1, table2 );
+                animator->addItemAspects( animationHint, candidates,
+                    table1, table2, isGraphicFilterChanged );
 
                 qskApplicationAnimator->add( animator );
             }
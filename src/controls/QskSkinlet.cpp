@@ -110,6 +110,15 @@ static inline QSGNode* qskUpdateTextNode( const QskSkinnable* skinnable,
     return textNode;
 }
 
+static inline bool qskTestUpdateFlag(
+    const QQuickItem* item, QskItem::UpdateFlag flag )
+{
+    if ( auto qItem = qobject_cast< const QskItem* >( item ) )
+        return qItem->testUpdateFlag( flag );
+
+    return QskSetup::testUpdateFlag( flag );
+}
+
 static inline QSGNode* qskUpdateGraphicNode(
     const QskSkinnable* skinnable, QSGNode* node,
     const QskGraphic& graphic, const QskColorFilter& colorFilter,
@@ -126,11 +135,8 @@ static inline QSGNode* qskUpdateGraphicNode(
     if ( graphicNode == nullptr )
         graphicNode = new QskGraphicNode();
 
-    const auto flag = QskItem::PreferRasterForTextures;
-
-    bool useRaster = QskSetup::testUpdateFlag( flag );
-    if ( auto qItem = qobject_cast< const QskItem* >( item ) )
-        useRaster = qItem->testUpdateFlag( flag );
+    const bool useRaster = qskTestUpdateFlag(
+        item, QskItem::PreferRasterForTextures );
 
     graphicNode->setRenderHint( useRaster ? QskPaintedNode::Raster : QskPaintedNode::OpenGL );
 
@@ -192,7 +198,7 @@ static inline QskTextColors qskTextColors(
 }
 
 static inline QSGNode* qskUpdateBoxNode(
-    const QskSkinnable*, QSGNode* node, const QRectF& rect,
+    const QskSkinnable* skinnable, QSGNode* node, const QRectF& rect,
     const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& borderMetrics,
     const QskBoxBorderColors& borderColors, const QskGradient& gradient,
     const QskShadowMetrics& shadowMetrics, const QColor& shadowColor )
@@ -210,6 +216,10 @@ static inline QSGNode* qskUpdateBoxNode(
         const auto absoluteShadowMetrics = shadowMetrics.toAbsolute( size );
 
         auto boxNode = QskSGNode::ensureNode< QskBoxNode >( node );
+
+        boxNode->setDistanceFieldPreferred( qskTestUpdateFlag(
+            skinnable->owningItem(), QskItem::PreferDistanceFields ) );
+
         boxNode->updateNode( rect, absoluteShape, absoluteMetrics,
             borderColors, gradient, absoluteShadowMetrics, shadowColor );
 
@@ -220,7 +230,7 @@ static inline QSGNode* qskUpdateBoxNode(
 }
 
 static inline QSGNode* qskUpdateArcNode(
-    const QskSkinnable*, QSGNode* node, const QRectF& rect,
+    const QskSkinnable* skinnable, QSGNode* node, const QRectF& rect,
     qreal borderWidth, const QColor borderColor,
     const QskGradient& gradient, const QskArcMetrics& metrics )
 {
@@ -231,6 +241,10 @@ static inline QSGNode* qskUpdateArcNode(
         return nullptr;
 
     auto arcNode = QskSGNode::ensureNode< QskArcNode >( node );
+
+    arcNode->setDistanceFieldPreferred( qskTestUpdateFlag(
+        skinnable->owningItem(), QskItem::PreferDistanceFields ) );
+
     arcNode->setArcData( rect, metrics, borderWidth, borderColor, gradient, {}, {} );
 
     return arcNode;
@@ -765,13 +779,21 @@ int QskSkinlet::sampleIndexAt( const QskSkinnable* skinnable,
 
 QSGNode* QskSkinlet::updateSeriesNode( const QskSkinnable* skinnable,
     QskAspect::Subcontrol subControl, QSGNode* rootNode ) const
+{
+    const auto count = sampleCount( skinnable, subControl );
+    return updateSeriesNode( skinnable, subControl, 0, count - 1, rootNode );
+}
+
+QSGNode* QskSkinlet::updateSeriesNode( const QskSkinnable* skinnable,
+    QskAspect::Subcontrol subControl, int from, int to, QSGNode* rootNode ) const
 {
     auto node = rootNode ? rootNode->firstChild() : nullptr;
     QSGNode* lastNode = nullptr;
 
-    const auto count = sampleCount( skinnable, subControl );
+    from = qMax( from, 0 );
+    to = qMin( to, sampleCount( skinnable, subControl ) - 1 );
 
-    for( int i = 0; i < count; i++ )
+    for( int i = from; i <= to; i++ )
     {
         QSGNode* newNode = nullptr;
 
@@ -805,7 +827,10 @@ QSGNode* QskSkinlet::updateSeriesNode( const QskSkinnable* skinnable,
         }
     }
 
-    QskSGNode::removeAllChildNodesAfter( rootNode, lastNode );
+    if ( lastNode )
+        QskSGNode::removeAllChildNodesAfter( rootNode, lastNode );
+    else if ( rootNode )
+        QskSGNode::removeAllChildNodesFrom( rootNode, rootNode->firstChild() );
 
     return rootNode;
 }
@@ -172,6 +172,10 @@ class QSK_EXPORT QskSkinlet
     QSGNode* updateSeriesNode( const QskSkinnable*,
         QskAspect::Subcontrol, QSGNode* ) const;
 
+    // creating nodes for the samples [from, to] only, f.e. the visible ones
+    QSGNode* updateSeriesNode( const QskSkinnable*,
+        QskAspect::Subcontrol, int from, int to, QSGNode* ) const;
+
     virtual QSGNode* updateSampleNode( const QskSkinnable*,
         QskAspect::Subcontrol, int index, QSGNode* ) const;
 
@@ -38,6 +38,9 @@
 #define DEBUG_ANIMATOR 0
 #define DEBUG_STATE 0
 
+// from QskSkinTransition.cpp
+extern void qskUpdateControlIndex( const QskControl*, bool isDestroyed );
+
 static inline bool qskIsControl( const QskSkinnable* skinnable )
 {
     return skinnable->metaObject()->inherits( &QskControl::staticMetaObject );
@@ -331,6 +334,9 @@ void QskSkinnable::setSubcontrolProxy(
         m_data->subcontrolProxies = new PrivateData::ProxyMap();
 
     ( *m_data->subcontrolProxies )[ subControl ] = proxy;
+
+    if ( auto control = qskControlCast( owningItem() ) )
+        qskUpdateControlIndex( control, false );
 }
 
 void QskSkinnable::resetSubcontrolProxy( QskAspect::Subcontrol subcontrol )
@@ -346,6 +352,9 @@ void QskSkinnable::resetSubcontrolProxy( QskAspect::Subcontrol subcontrol )
                 delete proxies;
                 proxies = nullptr;
             }
+
+            if ( auto control = qskControlCast( owningItem() ) )
+                qskUpdateControlIndex( control, false );
         }
     }
 }
@@ -1117,24 +1126,27 @@ QVariant QskSkinnable::interpolatedHint(
     return v;
 }
 
-const QVariant& QskSkinnable::storedHint(
+QVariant QskSkinnable::storedHint(
     QskAspect aspect, QskSkinHintStatus* status ) const
 {
     const auto skin = effectiveSkin();
 
     QskAspect resolvedAspect;
+    QVariant value;
+    bool ok;
 
     const auto& localTable = m_data->hintTable;
     if ( localTable.hasHints() )
     {
-        if ( const auto value = localTable.resolvedHint( aspect, &resolvedAspect ) )
+        value = localTable.resolvedValue( aspect, &resolvedAspect, &ok );
+        if ( ok )
         {
             if ( status )
             {
                 status->source = QskSkinHintStatus::Skinnable;
                 status->aspect = resolvedAspect;
             }
-            return *value;
+            return value;
         }
     }
 
@@ -1143,7 +1155,8 @@ const QVariant& QskSkinnable::storedHint(
     const auto& skinTable = skin->hintTable();
     if ( skinTable.hasHints() )
     {
-        if ( const auto value = skinTable.resolvedHint( aspect, &resolvedAspect ) )
+        value = skinTable.resolvedValue( aspect, &resolvedAspect, &ok );
+        if ( ok )
         {
             if ( status )
             {
@@ -1151,7 +1164,7 @@ const QVariant& QskSkinnable::storedHint(
                 status->aspect = resolvedAspect;
             }
 
-            return *value;
+            return value;
         }
 
         if ( aspect.hasSubcontrol() )
@@ -1161,7 +1174,8 @@ const QVariant& QskSkinnable::storedHint(
             aspect.clearSubcontrol();
             aspect.clearStates();
 
-            if ( const auto value = skinTable.resolvedHint( aspect, &resolvedAspect ) )
+            value = skinTable.resolvedValue( aspect, &resolvedAspect, &ok );
+            if ( ok )
             {
                 if ( status )
                 {
@@ -1169,7 +1183,7 @@ const QVariant& QskSkinnable::storedHint(
                     status->aspect = resolvedAspect;
                 }
 
-                return *value;
+                return value;
             }
         }
     }
@@ -1180,8 +1194,7 @@ const QVariant& QskSkinnable::storedHint(
         status->aspect = QskAspect();
     }
 
-    static QVariant hintInvalid;
-    return hintInvalid;
+    return QVariant();
 }
 
 bool QskSkinnable::hasSkinState( QskAspect::State state ) const
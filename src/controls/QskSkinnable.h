@@ -282,7 +282,7 @@ class QSK_EXPORT QskSkinnable
 
     QVariant animatedHint( QskAspect, QskSkinHintStatus* ) const;
     QVariant interpolatedHint( QskAspect, QskSkinHintStatus* ) const;
-    const QVariant& storedHint( QskAspect, QskSkinHintStatus* = nullptr ) const;
+    QVariant storedHint( QskAspect, QskSkinHintStatus* = nullptr ) const;
 
     friend class QskSkinStateChanger;
     void replaceSkinStates( QskAspect::States, int sampleIndex = -1 );
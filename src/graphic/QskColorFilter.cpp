@@ -10,6 +10,18 @@
 #include <qpen.h>
 #include <qvariant.h>
 
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+static void qskRegisterColorFilter()
+{
+    qRegisterMetaType< QskColorFilter >();
+    QMetaType::registerEqualsComparator< QskColorFilter >();
+}
+
+Q_CONSTRUCTOR_FUNCTION( qskRegisterColorFilter )
+
+#endif
+
 static inline QRgb qskSubstitutedRgb(
     const QVector< QPair< QRgb, QRgb > >& substitions, QRgb rgba, QRgb mask )
 {
@@ -17,10 +17,24 @@
 #include <qpixmap.h>
 #include <qhashfunctions.h>
 
+#include <atomic>
+
 QSK_QT_PRIVATE_BEGIN
 #include <private/qpainter_p.h>
 QSK_QT_PRIVATE_END
 
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+static void qskRegisterGraphic()
+{
+    qRegisterMetaType< QskGraphic >();
+    QMetaType::registerEqualsComparator< QskGraphic >();
+}
+
+Q_CONSTRUCTOR_FUNCTION( qskRegisterGraphic )
+
+#endif
+
 static inline qreal qskDevicePixelRatio()
 {
     return qGuiApp ? qGuiApp->devicePixelRatio() : 1.0;
@@ -328,6 +342,251 @@ namespace QskGraphicPrivate
     };
 }
 
+static inline QskHashValue qskHashColor( const QColor& color, QskHashValue seed )
+{
+    return qHash( quint64( color.rgba64() ), seed );
+}
+
+static QskHashValue qskHashImage( const QImage& image, QskHashValue seed )
+{
+    auto hash = qHash( image.width(), seed );
+    hash = qHash( image.height(), hash );
+    hash = qHash( static_cast< int >( image.format() ), hash );
+
+    if ( !image.isNull() )
+    {
+        /*
+            The content, not the cacheKey, that differs for each load.
+            The padding bytes at the end of the scanlines are not
+            initialized, so we must not include them.
+         */
+        const auto bytesPerLine = static_cast< size_t >(
+            ( image.width() * image.depth() + 7 ) / 8 );
+
+        for ( int y = 0; y < image.height(); y++ )
+            hash = qHashBits( image.constScanLine( y ), bytesPerLine, hash );
+
+        const auto colorTable = image.colorTable();
+        if ( !colorTable.isEmpty() )
+        {
+            hash = qHashBits( colorTable.constData(),
+                colorTable.size() * sizeof( QRgb ), hash );
+        }
+    }
+
+    return hash;
+}
+
+static QskHashValue qskHashPath( const QPainterPath& path, QskHashValue seed )
+{
+    auto hash = qHash( static_cast< int >( path.fillRule() ), seed );
+
+    const int count = path.elementCount();
+    hash = qHash( count, hash );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const auto element = path.elementAt( i );
+
+        hash = qHash( static_cast< int >( element.type ), hash );
+        hash = qHash( element.x, hash );
+        hash = qHash( element.y, hash );
+    }
+
+    return hash;
+}
+
+static QskHashValue qskHashGradient( const QGradient* gradient, QskHashValue seed )
+{
+    auto hash = qHash( static_cast< int >( gradient->type() ), seed );
+    hash = qHash( static_cast< int >( gradient->spread() ), hash );
+    hash = qHash( static_cast< int >( gradient->coordinateMode() ), hash );
+
+    const auto stops = gradient->stops();
+    for ( const auto& stop : stops )
+    {
+        hash = qHash( stop.first, hash );
+        hash = qskHashColor( stop.second, hash );
+    }
+
+    switch( gradient->type() )
+    {
+        case QGradient::LinearGradient:
+        {
+            const auto g = static_cast< const QLinearGradient* >( gradient );
+
+            const QRectF r( g->start(), g->finalStop() );
+            hash = qHashBits( &r, sizeof( r ), hash );
+
+            break;
+        }
+        case QGradient::RadialGradient:
+        {
+            const auto g = static_cast< const QRadialGradient* >( gradient );
+
+            const qreal values[] = { g->center().x(), g->center().y(),
+                g->focalPoint().x(), g->focalPoint().y(), g->centerRadius(), g->focalRadius() };
+
+            hash = qHashBits( values, sizeof( values ), hash );
+
+            break;
+        }
+        case QGradient::ConicalGradient:
+        {
+            const auto g = static_cast< const QConicalGradient* >( gradient );
+
+            const qreal values[] = { g->center().x(), g->center().y(), g->angle() };
+            hash = qHashBits( values, sizeof( values ), hash );
+
+            break;
+        }
+        default:
+            break;
+    }
+
+    return hash;
+}
+
+static QskHashValue qskHashBrush( const QBrush& brush, QskHashValue seed )
+{
+    auto hash = qHash( static_cast< int >( brush.style() ), seed );
+    hash = qskHashColor( brush.color(), hash );
+    hash = qHash( brush.transform(), hash );
+
+    if ( const auto gradient = brush.gradient() )
+        hash = qskHashGradient( gradient, hash );
+
+    if ( brush.style() == Qt::TexturePattern )
+        hash = qskHashImage( brush.textureImage(), hash );
+
+    return hash;
+}
+
+static QskHashValue qskHashPen( const QPen& pen, QskHashValue seed )
+{
+    auto hash = qHash( pen.widthF(), seed );
+    hash = qHash( static_cast< int >( pen.style() ), hash );
+    hash = qHash( static_cast< int >( pen.capStyle() ), hash );
+    hash = qHash( static_cast< int >( pen.joinStyle() ), hash );
+    hash = qHash( pen.miterLimit(), hash );
+    hash = qHash( pen.isCosmetic(), hash );
+    hash = qHash( pen.dashOffset(), hash );
+
+    const auto dashes = pen.dashPattern();
+    for ( const auto dash : dashes )
+        hash = qHash( dash, hash );
+
+    return qskHashBrush( pen.brush(), hash );
+}
+
+static QskHashValue qskHashState(
+    const QskPainterCommand::StateData* data, QskHashValue seed )
+{
+    const auto flags = data->flags;
+
+    auto hash = qHash( static_cast< int >( flags ), seed );
+
+    if ( flags & QPaintEngine::DirtyPen )
+        hash = qskHashPen( data->pen, hash );
+
+    if ( flags & QPaintEngine::DirtyBrush )
+        hash = qskHashBrush( data->brush, hash );
+
+    if ( flags & QPaintEngine::DirtyBrushOrigin )
+    {
+        hash = qHash( data->brushOrigin.x(), hash );
+        hash = qHash( data->brushOrigin.y(), hash );
+    }
+
+    if ( flags & QPaintEngine::DirtyBackground )
+        hash = qskHashBrush( data->backgroundBrush, hash );
+
+    if ( flags & QPaintEngine::DirtyBackgroundMode )
+        hash = qHash( static_cast< int >( data->backgroundMode ), hash );
+
+    if ( flags & QPaintEngine::DirtyFont )
+        hash = qHash( data->font, hash );
+
+    if ( flags & QPaintEngine::DirtyTransform )
+        hash = qHash( data->transform, hash );
+
+    if ( flags & QPaintEngine::DirtyClipEnabled )
+        hash = qHash( data->isClipEnabled, hash );
+
+    if ( flags & ( QPaintEngine::DirtyClipRegion | QPaintEngine::DirtyClipPath ) )
+        hash = qHash( static_cast< int >( data->clipOperation ), hash );
+
+    if ( flags & QPaintEngine::DirtyClipRegion )
+    {
+        for ( const auto& rect : data->clipRegion )
+            hash = qHashBits( &rect, sizeof( rect ), hash );
+    }
+
+    if ( flags & QPaintEngine::DirtyClipPath )
+        hash = qskHashPath( data->clipPath, hash );
+
+    if ( flags & QPaintEngine::DirtyHints )
+        hash = qHash( static_cast< int >( data->renderHints ), hash );
+
+    if ( flags & QPaintEngine::DirtyCompositionMode )
+        hash = qHash( static_cast< int >( data->compositionMode ), hash );
+
+    if ( flags & QPaintEngine::DirtyOpacity )
+        hash = qHash( data->opacity, hash );
+
+    return hash;
+}
+
+static QskHashValue qskHashCommands(
+    const QVector< QskPainterCommand >& commands, QskHashValue seed )
+{
+    auto hash = qHash( commands.size(), seed );
+
+    for ( const auto& command : commands )
+    {
+        hash = qHash( static_cast< int >( command.type() ), hash );
+
+        switch( command.type() )
+        {
+            case QskPainterCommand::Path:
+            {
+                hash = qskHashPath( *command.path(), hash );
+                break;
+            }
+            case QskPainterCommand::Pixmap:
+            {
+                const auto data = command.pixmapData();
+
+                hash = qHashBits( &data->rect, sizeof( QRectF ), hash );
+                hash = qHashBits( &data->subRect, sizeof( QRectF ), hash );
+                hash = qskHashImage( data->pixmap.toImage(), hash );
+
+                break;
+            }
+            case QskPainterCommand::Image:
+            {
+                const auto data = command.imageData();
+
+                hash = qHashBits( &data->rect, sizeof( QRectF ), hash );
+                hash = qHashBits( &data->subRect, sizeof( QRectF ), hash );
+                hash = qHash( static_cast< int >( data->flags ), hash );
+                hash = qskHashImage( data->image, hash );
+
+                break;
+            }
+            case QskPainterCommand::State:
+            {
+                hash = qskHashState( command.stateData(), hash );
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return hash;
+}
+
 class QskGraphic::PrivateData : public QSharedData
 {
   public:
@@ -345,6 +604,7 @@ class QskGraphic::PrivateData : public QSharedData
         , boundingRect( other.boundingRect )
         , pointRect( other.pointRect )
         , modificationId( other.modificationId )
+        , contentHash( other.contentHash.load() )
         , commandTypes( other.commandTypes )
         , renderHints( other.renderHints )
     {
@@ -352,9 +612,35 @@ class QskGraphic::PrivateData : public QSharedData
 
     inline bool operator==( const PrivateData& other ) const
     {
-        return ( modificationId == other.modificationId ) &&
-            ( renderHints == other.renderHints ) &&
-            ( viewBox == other.viewBox );
+        if ( ( renderHints != other.renderHints ) || ( viewBox != other.viewBox ) )
+            return false;
+
+        if ( modificationId == other.modificationId )
+            return true;
+
+        return ( hash() == other.hash() ) && ( commands == other.commands );
+    }
+
+    QskHashValue hash() const
+    {
+        /*
+            Calculating the hash is not for free, but the commands
+            of a graphic are usually recorded/loaded once and never
+            modified later. So we do it lazily and only once.
+            As the value does not depend on the calling thread a race
+            condition would only result in calculating it twice.
+         */
+        auto value = contentHash.load( std::memory_order_relaxed );
+        if ( value == 0 )
+        {
+            value = qskHashCommands( commands, 7817 );
+            if ( value == 0 )
+                value = 1; // 0 indicates an invalid value
+
+            contentHash.store( value, std::memory_order_relaxed );
+        }
+
+        return value;
     }
 
     void resetCommands()
@@ -366,11 +652,13 @@ class QskGraphic::PrivateData : public QSharedData
         boundingRect = pointRect = { 0.0, 0.0, -1.0, -1.0 };
 
         modificationId = 0;
+        contentHash = 0;
     }
 
     inline void addCommand( const QskPainterCommand& command )
     {
         commands += command;
+        contentHash = 0;
 
         static QAtomicInteger< quint64 > nextId( 1 );
         modificationId = nextId.fetchAndAddRelaxed( 1 );
@@ -384,6 +672,7 @@ class QskGraphic::PrivateData : public QSharedData
     QRectF pointRect = { 0.0, 0.0, -1.0, -1.0 };
 
     quint64 modificationId = 0;
+    mutable std::atomic< QskHashValue > contentHash { 0 };
 
     uint commandTypes : 4;
     uint renderHints : 4;
@@ -1051,7 +1340,7 @@ QskHashValue QskGraphic::hash( QskHashValue seed ) const
     auto hash = qHash( m_data->renderHints, seed );
     hash = qHashBits( &m_data->viewBox, sizeof( QRectF ), hash );
 
-    return qHash( m_data->modificationId, hash );
+    return qHash( m_data->hash(), hash );
 }
 
 QskGraphic QskGraphic::fromImage( const QImage& image )
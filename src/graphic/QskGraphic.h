@@ -133,6 +133,12 @@ class QSK_EXPORT QskGraphic : public QPaintDevice
     static QskGraphic fromGraphic( const QskGraphic&, const QskColorFilter& );
 
     quint64 modificationId() const;
+
+    /*
+        The hash depends on the recorded commands and not on the
+        modificationId. So identical graphics, that have been loaded
+        from different sources, have the same hash value.
+     */
     QskHashValue hash( QskHashValue seed ) const;
 
   protected:
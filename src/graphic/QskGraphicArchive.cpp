@@ -0,0 +1,345 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskGraphicArchive.h"
+#include "QskGraphic.h"
+#include "QskGraphicIO.h"
+
+#include <qbytearray.h>
+#include <qfile.h>
+#include <qstringlist.h>
+#include <qvector.h>
+
+#include <algorithm>
+#include <cstring>
+
+/*
+    Layout ( little endian ):
+
+    - header
+    - index: entries sorted by the UTF-8 encoded names
+    - names: UTF-8 encoded, not null terminated
+    - data: QVG data of the graphics, aligned to 16 bytes
+ */
+
+static const char qskArchiveMagicNumber[] = "QSKA";
+
+namespace
+{
+    struct ArchiveHeader
+    {
+        char magic[ 4 ];
+        quint32 version;
+        quint32 count;
+        quint32 reserved;
+    };
+
+    struct ArchiveEntry
+    {
+        quint64 nameOffset;
+        quint64 dataOffset;
+        quint64 dataSize;
+        quint32 nameSize;
+        quint32 reserved;
+    };
+
+    static_assert( sizeof( ArchiveHeader ) == 16, "bad alignment" );
+    static_assert( sizeof( ArchiveEntry ) == 32, "bad alignment" );
+}
+
+static inline qint64 qskArchiveAligned( qint64 offset )
+{
+    return ( offset + 15 ) / 16 * 16;
+}
+
+static inline int qskCompareName( const uchar* data,
+    const ArchiveEntry& entry, const QByteArray& name )
+{
+    const auto size = qMin( quint64( name.size() ), quint64( entry.nameSize ) );
+
+    const int ret = memcmp( data + entry.nameOffset, name.constData(), size );
+    if ( ret != 0 )
+        return ret;
+
+    if ( entry.nameSize == quint64( name.size() ) )
+        return 0;
+
+    return ( entry.nameSize < quint64( name.size() ) ) ? -1 : 1;
+}
+
+class QskGraphicArchive::PrivateData
+{
+  public:
+    // a QFile for mapped data, or a QByteArray
+    std::shared_ptr< const void > owner;
+
+    const uchar* data = nullptr;
+    qint64 size = 0;
+
+    const ArchiveEntry* entries = nullptr;
+    int count = 0;
+};
+
+QskGraphicArchive::QskGraphicArchive()
+    : m_data( new PrivateData() )
+{
+}
+
+QskGraphicArchive::QskGraphicArchive( const QString& fileName )
+    : QskGraphicArchive()
+{
+    open( fileName );
+}
+
+QskGraphicArchive::~QskGraphicArchive()
+{
+}
+
+bool QskGraphicArchive::open( const QString& fileName )
+{
+    close();
+
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    auto file = std::make_shared< QFile >( fileName );
+    if ( !file->open( QIODevice::ReadOnly ) )
+    {
+        qWarning( "QskGraphicArchive: can't open %s", qPrintable( fileName ) );
+        return false;
+    }
+
+    std::shared_ptr< const void > owner;
+
+    const auto size = file->size();
+    const uchar* data = file->map( 0, size );
+
+    if ( data && ( quintptr( data ) % 8 == 0 ) )
+    {
+        owner = file;
+    }
+    else
+    {
+        // f.e. compressed resources
+
+        if ( data )
+            file->unmap( const_cast< uchar* >( data ) );
+
+        const auto bytes = std::make_shared< const QByteArray >( file->readAll() );
+
+        data = reinterpret_cast< const uchar* >( bytes->constData() );
+        owner = bytes;
+    }
+
+    bool ok = size >= qint64( sizeof( ArchiveHeader ) );
+
+    const auto header = reinterpret_cast< const ArchiveHeader* >( data );
+
+    if ( ok )
+    {
+        ok = ( memcmp( header->magic, qskArchiveMagicNumber, 4 ) == 0 )
+            && ( header->version == 1 )
+            && ( header->count <= ( size - sizeof( ArchiveHeader ) ) / sizeof( ArchiveEntry ) );
+    }
+
+    const auto entries = reinterpret_cast< const ArchiveEntry* >( header + 1 );
+
+    for ( quint32 i = 0; ok && i < header->count; i++ )
+    {
+        const auto& entry = entries[ i ];
+
+        ok = ( entry.nameOffset <= quint64( size ) )
+            && ( entry.nameSize <= size - entry.nameOffset )
+            && ( entry.dataOffset <= quint64( size ) )
+            && ( entry.dataSize <= size - entry.dataOffset );
+    }
+
+    if ( !ok )
+    {
+        qWarning( "QskGraphicArchive: invalid archive %s", qPrintable( fileName ) );
+        return false;
+    }
+
+    m_data->owner = owner;
+    m_data->data = data;
+    m_data->size = size;
+    m_data->entries = entries;
+    m_data->count = header->count;
+
+    return true;
+#else
+    qWarning( "QskGraphicArchive: not supported on big endian systems" );
+    Q_UNUSED( fileName );
+
+    return false;
+#endif
+}
+
+void QskGraphicArchive::close()
+{
+    *m_data = PrivateData();
+}
+
+bool QskGraphicArchive::isOpen() const
+{
+    return m_data->data != nullptr;
+}
+
+int QskGraphicArchive::count() const
+{
+    return m_data->count;
+}
+
+QStringList QskGraphicArchive::names() const
+{
+    QStringList names;
+    names.reserve( m_data->count );
+
+    for ( int i = 0; i < m_data->count; i++ )
+    {
+        const auto& entry = m_data->entries[ i ];
+
+        names += QString::fromUtf8(
+            reinterpret_cast< const char* >( m_data->data + entry.nameOffset ),
+            entry.nameSize );
+    }
+
+    return names;
+}
+
+bool QskGraphicArchive::contains( const QString& name ) const
+{
+    return indexOf( name ) >= 0;
+}
+
+QskGraphic QskGraphicArchive::graphic( const QString& name ) const
+{
+    const auto index = indexOf( name );
+    if ( index < 0 )
+        return QskGraphic();
+
+    const auto& entry = m_data->entries[ index ];
+
+    return QskGraphicIO::read( m_data->data + entry.dataOffset,
+        entry.dataSize, m_data->owner );
+}
+
+int QskGraphicArchive::indexOf( const QString& name ) const
+{
+    const auto utf8 = name.toUtf8();
+    const auto entries = m_data->entries;
+
+    int from = 0;
+    int to = m_data->count - 1;
+
+    while ( from <= to )
+    {
+        const int mid = ( from + to ) / 2;
+
+        const int ret = qskCompareName( m_data->data, entries[ mid ], utf8 );
+        if ( ret == 0 )
+            return mid;
+
+        if ( ret < 0 )
+            from = mid + 1;
+        else
+            to = mid - 1;
+    }
+
+    return -1;
+}
+
+bool QskGraphicArchive::write(
+    const QMap< QString, QByteArray >& graphics, const QString& fileName )
+{
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    struct Item
+    {
+        QByteArray name;
+        QByteArray data;
+    };
+
+    QVector< Item > items;
+    items.reserve( graphics.size() );
+
+    for ( auto it = graphics.constBegin(); it != graphics.constEnd(); ++it )
+        items += Item { it.key().toUtf8(), it.value() };
+
+    // the order of QString is not the one of the UTF-8 bytes
+    std::sort( items.begin(), items.end(),
+        []( const Item& item1, const Item& item2 ) { return item1.name < item2.name; } );
+
+    ArchiveHeader header;
+    memset( &header, 0, sizeof( header ) );
+
+    memcpy( header.magic, qskArchiveMagicNumber, 4 );
+    header.version = 1;
+    header.count = items.size();
+
+    QVector< ArchiveEntry > entries;
+    entries.reserve( items.size() );
+
+    QByteArray names;
+
+    for ( const auto& item : items )
+    {
+        ArchiveEntry entry;
+        memset( &entry, 0, sizeof( entry ) );
+
+        entry.nameOffset = names.size();
+        entry.nameSize = item.name.size();
+
+        names += item.name;
+
+        entries += entry;
+    }
+
+    const qint64 namesOffset = sizeof( ArchiveHeader )
+        + entries.size() * qint64( sizeof( ArchiveEntry ) );
+
+    qint64 offset = qskArchiveAligned( namesOffset + names.size() );
+
+    for ( int i = 0; i < items.size(); i++ )
+    {
+        auto& entry = entries[ i ];
+
+        entry.nameOffset += namesOffset;
+        entry.dataOffset = offset;
+        entry.dataSize = items[ i ].data.size();
+
+        offset = qskArchiveAligned( offset + entry.dataSize );
+    }
+
+    QFile file( fileName );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+    {
+        qWarning( "QskGraphicArchive: can't open %s", qPrintable( fileName ) );
+        return false;
+    }
+
+    bool ok = file.write( reinterpret_cast< const char* >( &header ), sizeof( header ) ) >= 0;
+
+    if ( ok && !entries.isEmpty() )
+    {
+        ok = file.write( reinterpret_cast< const char* >( entries.constData() ),
+            entries.size() * qint64( sizeof( ArchiveEntry ) ) ) >= 0;
+    }
+
+    if ( ok )
+        ok = file.write( names ) >= 0;
+
+    for ( int i = 0; ok && i < items.size(); i++ )
+    {
+        const QByteArray padding( entries[ i ].dataOffset - file.pos(), '\0' );
+        ok = ( file.write( padding ) >= 0 ) && ( file.write( items[ i ].data ) >= 0 );
+    }
+
+    return ok;
+#else
+    qWarning( "QskGraphicArchive: not supported on big endian systems" );
+    Q_UNUSED( graphics );
+    Q_UNUSED( fileName );
+
+    return false;
+#endif
+}
@@ -0,0 +1,60 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_GRAPHIC_ARCHIVE_H
+#define QSK_GRAPHIC_ARCHIVE_H
+
+#include "QskGlobal.h"
+
+#include <qmap.h>
+#include <qstring.h>
+#include <memory>
+
+class QskGraphic;
+class QStringList;
+class QByteArray;
+
+/*
+    A packed file of QVG graphics with a sorted index, that can be
+    generated at build time ( see svg2qvg and the qsk_svg2qvg_archive
+    cmake function ). The file is memory mapped, so that an application
+    opens one file instead of thousands and only the graphics, that are
+    actually requested, are decoded.
+
+    Graphics might refer to the mapped data, that stays alive
+    as long as there are graphics using it.
+ */
+class QSK_EXPORT QskGraphicArchive
+{
+  public:
+    QskGraphicArchive();
+    QskGraphicArchive( const QString& fileName );
+
+    ~QskGraphicArchive();
+
+    bool open( const QString& fileName );
+    void close();
+
+    bool isOpen() const;
+
+    int count() const;
+    QStringList names() const;
+
+    bool contains( const QString& name ) const;
+    QskGraphic graphic( const QString& name ) const;
+
+    // name -> data as created by QskGraphicIO::write
+    static bool write( const QMap< QString, QByteArray >&, const QString& fileName );
+
+  private:
+    Q_DISABLE_COPY( QskGraphicArchive )
+
+    int indexOf( const QString& name ) const;
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -11,10 +11,14 @@
 #include <qdatastream.h>
 #include <qfile.h>
 #include <qvector.h>
+#include <qimage.h>
+#include <qpainterpath.h>
 
 #include <cstring>
+#include <memory>
 
 static const char qskMagicNumber[] = "QSKG";
+static const char qskMagicNumber2[] = "QSK2";
 
 /*
     To avoid crashes ( fonts ), when svg2qvg was running with a different Qt
@@ -202,31 +206,926 @@ static inline void qskReadStateData(
     commands += QskPainterCommand( data );
 }
 
+/*
+    QVG v2 stores the commands in flat arrays of fixed size records, that
+    can be used directly from a memory mapped file or Qt resource. Only
+    attributes, that can't be represented by plain values ( fonts, gradients,
+    clip regions ... ) are stored as QDataStream blobs in the payload section.
+    Raster data is stored as plain QImage bits, so that images can be created
+    without decoding and copying.
+
+    All values are in little endian byte order and all sections
+    are aligned to 16 bytes.
+ */
+
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    #define QSK_QVG2_SUPPORTED 1
+#endif
+
+namespace
+{
+    enum Qvg2Section
+    {
+        Qvg2Commands,
+        Qvg2Paths,
+        Qvg2Elements,
+        Qvg2Rasters,
+        Qvg2States,
+        Qvg2Payload,
+
+        Qvg2SectionCount
+    };
+
+    struct Qvg2SectionInfo
+    {
+        quint64 offset;
+        quint64 count; // number of records, bytes for the payload
+    };
+
+    struct Qvg2Header
+    {
+        char magic[ 4 ];
+        quint32 version;
+        quint32 commandCount;
+        quint32 reserved;
+
+        double viewBox[ 4 ];
+
+        Qvg2SectionInfo sections[ Qvg2SectionCount ];
+    };
+
+    struct Qvg2CommandRecord
+    {
+        quint32 type;
+        quint32 index; // into the records of the type
+    };
+
+    struct Qvg2PathRecord
+    {
+        quint32 firstElement;
+        quint32 elementCount;
+        quint32 fillRule;
+        quint32 reserved;
+    };
+
+    struct Qvg2ElementRecord
+    {
+        double x;
+        double y;
+        quint32 type;
+        quint32 reserved;
+    };
+
+    struct Qvg2RasterRecord
+    {
+        double rect[ 4 ];
+        double subRect[ 4 ];
+
+        quint32 isPixmap;
+        quint32 conversionFlags;
+
+        quint32 width;
+        quint32 height;
+        quint32 bytesPerLine;
+        quint32 format;
+
+        quint64 dataOffset; // relative to the payload
+    };
+
+    struct Qvg2StateRecord
+    {
+        quint32 flags;
+        quint32 extensionFlags; // flags, that are stored in the extension
+        quint64 extensionOffset; // relative to the payload
+        quint64 extensionSize;
+
+        quint64 penColor;
+        double penWidth;
+        double penMiterLimit;
+        quint32 penStyle;
+        quint32 penCapStyle;
+        quint32 penJoinStyle;
+        quint32 penCosmetic;
+
+        quint64 brushColor;
+        quint32 brushStyle;
+        quint32 backgroundMode;
+        double brushOrigin[ 2 ];
+
+        double transform[ 9 ];
+
+        quint32 renderHints;
+        quint32 compositionMode;
+        quint32 clipOperation;
+        quint32 isClipEnabled;
+
+        double opacity;
+    };
+
+    static_assert( sizeof( Qvg2Header ) % 16 == 0, "bad alignment" );
+    static_assert( sizeof( Qvg2CommandRecord ) == 8, "bad alignment" );
+    static_assert( sizeof( Qvg2PathRecord ) == 16, "bad alignment" );
+    static_assert( sizeof( Qvg2ElementRecord ) == 24, "bad alignment" );
+    static_assert( sizeof( Qvg2RasterRecord ) % 8 == 0, "bad alignment" );
+    static_assert( sizeof( Qvg2StateRecord ) % 8 == 0, "bad alignment" );
+
+    class Qvg2Buffer
+    {
+      public:
+        QByteArray bytes;               // data loaded into memory
+        std::unique_ptr< QFile > file;  // data being memory mapped
+        std::shared_ptr< const void > owner; // f.e. a QskGraphicArchive
+
+        const uchar* data = nullptr;
+        qint64 size = 0;
+    };
+
+    using Qvg2BufferPtr = std::shared_ptr< const Qvg2Buffer >;
+}
+
+static inline bool qskIsQvg2( const QByteArray& data )
+{
+    return ( data.size() >= 4 ) && ( memcmp( data.constData(), qskMagicNumber2, 4 ) == 0 );
+}
+
+#ifdef QSK_QVG2_SUPPORTED
+
+static inline qint64 qskQvg2Aligned( qint64 offset, int alignment = 16 )
+{
+    return ( offset + alignment - 1 ) / alignment * alignment;
+}
+
+static inline bool qskIsFlatPen( const QPen& pen )
+{
+    return ( pen.brush().style() == Qt::SolidPattern )
+        && ( pen.style() != Qt::CustomDashLine ) && qFuzzyIsNull( pen.dashOffset() );
+}
+
+static inline bool qskIsFlatBrush( const QBrush& brush )
+{
+    return ( brush.style() <= Qt::DiagCrossPattern ) && brush.transform().isIdentity();
+}
+
+static inline QImage qskRasterImage( const QImage& image )
+{
+    // no color tables in v2
+    switch( image.format() )
+    {
+        case QImage::Format_Invalid:
+        case QImage::Format_Mono:
+        case QImage::Format_MonoLSB:
+        case QImage::Format_Indexed8:
+            return image.convertToFormat( QImage::Format_ARGB32_Premultiplied );
+
+        default:
+            return image;
+    }
+}
+
+static void qskReleaseQvg2Buffer( void* info )
+{
+    delete static_cast< Qvg2BufferPtr* >( info );
+}
+
+static bool qskWriteQvg2( const QskGraphic& graphic, QIODevice* dev )
+{
+    QVector< Qvg2CommandRecord > commandRecords;
+    QVector< Qvg2PathRecord > pathRecords;
+    QVector< Qvg2ElementRecord > elementRecords;
+    QVector< Qvg2RasterRecord > rasterRecords;
+    QVector< Qvg2StateRecord > stateRecords;
+    QByteArray payload;
+
+    const auto& commands = graphic.commands();
+    commandRecords.reserve( commands.size() );
+
+    for ( const auto& command : commands )
+    {
+        Qvg2CommandRecord commandRecord;
+        commandRecord.type = command.type();
+
+        switch ( command.type() )
+        {
+            case QskPainterCommand::Path:
+            {
+                const auto path = command.path();
+
+                Qvg2PathRecord record;
+                record.firstElement = elementRecords.size();
+                record.elementCount = path->elementCount();
+                record.fillRule = path->fillRule();
+                record.reserved = 0;
+
+                for ( int i = 0; i < path->elementCount(); i++ )
+                {
+                    const auto element = path->elementAt( i );
+                    elementRecords += Qvg2ElementRecord { element.x, element.y, quint32( element.type ), 0 };
+                }
+
+                commandRecord.index = pathRecords.size();
+                pathRecords += record;
+
+                break;
+            }
+            case QskPainterCommand::Pixmap:
+            case QskPainterCommand::Image:
+            {
+                QRectF rect, subRect;
+                QImage image;
+                Qt::ImageConversionFlags conversionFlags;
+
+                const bool isPixmap = ( command.type() == QskPainterCommand::Pixmap );
+                if ( isPixmap )
+                {
+                    const auto data = command.pixmapData();
+
+                    rect = data->rect;
+                    subRect = data->subRect;
+                    image = qskRasterImage( data->pixmap.toImage() );
+                }
+                else
+                {
+                    const auto data = command.imageData();
+
+                    rect = data->rect;
+                    subRect = data->subRect;
+                    image = qskRasterImage( data->image );
+                    conversionFlags = data->flags;
+                }
+
+                payload.resize( qskQvg2Aligned( payload.size() ) );
+
+                Qvg2RasterRecord record;
+
+                record.rect[ 0 ] = rect.x();
+                record.rect[ 1 ] = rect.y();
+                record.rect[ 2 ] = rect.width();
+                record.rect[ 3 ] = rect.height();
+
+                record.subRect[ 0 ] = subRect.x();
+                record.subRect[ 1 ] = subRect.y();
+                record.subRect[ 2 ] = subRect.width();
+                record.subRect[ 3 ] = subRect.height();
+
+                record.isPixmap = isPixmap;
+                record.conversionFlags = static_cast< quint32 >( conversionFlags );
+
+                record.width = image.width();
+                record.height = image.height();
+                record.bytesPerLine = image.bytesPerLine();
+                record.format = image.format();
+                record.dataOffset = payload.size();
+
+                payload.append( reinterpret_cast< const char* >( image.constBits() ),
+                    image.bytesPerLine() * image.height() );
+
+                commandRecord.index = rasterRecords.size();
+                rasterRecords += record;
+
+                break;
+            }
+            case QskPainterCommand::State:
+            {
+                const auto data = command.stateData();
+                const auto flags = data->flags;
+
+                Qvg2StateRecord record;
+                memset( &record, 0, sizeof( record ) );
+
+                record.flags = static_cast< quint32 >( flags );
+
+                quint32 extensionFlags = 0;
+
+                if ( flags & QPaintEngine::DirtyPen )
+                {
+                    const auto& pen = data->pen;
+
+                    if ( qskIsFlatPen( pen ) )
+                    {
+                        record.penColor = pen.color().rgba64();
+                        record.penWidth = pen.widthF();
+                        record.penMiterLimit = pen.miterLimit();
+                        record.penStyle = pen.style();
+                        record.penCapStyle = pen.capStyle();
+                        record.penJoinStyle = pen.joinStyle();
+                        record.penCosmetic = pen.isCosmetic();
+                    }
+                    else
+                    {
+                        extensionFlags |= QPaintEngine::DirtyPen;
+                    }
+                }
+
+                if ( flags & QPaintEngine::DirtyBrush )
+                {
+                    if ( qskIsFlatBrush( data->brush ) )
+                    {
+                        record.brushColor = data->brush.color().rgba64();
+                        record.brushStyle = data->brush.style();
+                    }
+                    else
+                    {
+                        extensionFlags |= QPaintEngine::DirtyBrush;
+                    }
+                }
+
+                if ( flags & QPaintEngine::DirtyBrushOrigin )
+                {
+                    record.brushOrigin[ 0 ] = data->brushOrigin.x();
+                    record.brushOrigin[ 1 ] = data->brushOrigin.y();
+                }
+
+                if ( flags & QPaintEngine::DirtyBackground )
+                {
+                    record.backgroundMode = data->backgroundMode;
+                    extensionFlags |= QPaintEngine::DirtyBackground;
+                }
+
+                if ( flags & QPaintEngine::DirtyTransform )
+                {
+                    const auto& t = data->transform;
+
+                    const double values[] = { t.m11(), t.m12(), t.m13(),
+                        t.m21(), t.m22(), t.m23(), t.m31(), t.m32(), t.m33() };
+
+                    memcpy( record.transform, values, sizeof( values ) );
+                }
+
+                if ( flags & ( QPaintEngine::DirtyClipRegion | QPaintEngine::DirtyClipPath ) )
+                    record.clipOperation = data->clipOperation;
+
+                record.isClipEnabled = data->isClipEnabled;
+                record.renderHints = static_cast< quint32 >( data->renderHints );
+                record.compositionMode = data->compositionMode;
+                record.opacity = data->opacity;
+
+                extensionFlags |= static_cast< quint32 >( flags & ( QPaintEngine::DirtyFont
+                    | QPaintEngine::DirtyClipRegion | QPaintEngine::DirtyClipPath ) );
+
+                if ( extensionFlags )
+                {
+                    QByteArray extension;
+
+                    QDataStream s( &extension, QIODevice::WriteOnly );
+                    s.setVersion( qskDataStreamVersion );
+                    s.setByteOrder( QDataStream::BigEndian );
+
+                    if ( extensionFlags & QPaintEngine::DirtyPen )
+                        s << data->pen;
+
+                    if ( extensionFlags & QPaintEngine::DirtyBrush )
+                        s << data->brush;
+
+                    if ( extensionFlags & QPaintEngine::DirtyFont )
+                        s << data->font;
+
+                    if ( extensionFlags & QPaintEngine::DirtyBackground )
+                        s << data->backgroundBrush;
+
+                    if ( extensionFlags & QPaintEngine::DirtyClipRegion )
+                        s << data->clipRegion;
+
+                    if ( extensionFlags & QPaintEngine::DirtyClipPath )
+                        s << data->clipPath;
+
+                    payload.resize( qskQvg2Aligned( payload.size(), 8 ) );
+
+                    record.extensionFlags = extensionFlags;
+                    record.extensionOffset = payload.size();
+                    record.extensionSize = extension.size();
+
+                    payload += extension;
+                }
+
+                commandRecord.index = stateRecords.size();
+                stateRecords += record;
+
+                break;
+            }
+            default:
+                return false;
+        }
+
+        commandRecords += commandRecord;
+    }
+
+    Qvg2Header header;
+    memset( &header, 0, sizeof( header ) );
+
+    memcpy( header.magic, qskMagicNumber2, 4 );
+    header.version = 2;
+    header.commandCount = commandRecords.size();
+
+    const auto viewBox = graphic.viewBox();
+    header.viewBox[ 0 ] = viewBox.x();
+    header.viewBox[ 1 ] = viewBox.y();
+    header.viewBox[ 2 ] = viewBox.width();
+    header.viewBox[ 3 ] = viewBox.height();
+
+    const struct
+    {
+        const void* data;
+        qint64 count;
+        qint64 size;
+    } sections[] =
+    {
+        { commandRecords.constData(), commandRecords.size(),
+            commandRecords.size() * qint64( sizeof( Qvg2CommandRecord ) ) },
+
+        { pathRecords.constData(), pathRecords.size(),
+            pathRecords.size() * qint64( sizeof( Qvg2PathRecord ) ) },
+
+        { elementRecords.constData(), elementRecords.size(),
+            elementRecords.size() * qint64( sizeof( Qvg2ElementRecord ) ) },
+
+        { rasterRecords.constData(), rasterRecords.size(),
+            rasterRecords.size() * qint64( sizeof( Qvg2RasterRecord ) ) },
+
+        { stateRecords.constData(), stateRecords.size(),
+            stateRecords.size() * qint64( sizeof( Qvg2StateRecord ) ) },
+
+        { payload.constData(), payload.size(), payload.size() }
+    };
+
+    qint64 offset = sizeof( Qvg2Header );
+    for ( int i = 0; i < Qvg2SectionCount; i++ )
+    {
+        header.sections[ i ].offset = offset;
+        header.sections[ i ].count = sections[ i ].count;
+
+        offset = qskQvg2Aligned( offset + sections[ i ].size );
+    }
+
+    if ( dev->write( reinterpret_cast< const char* >( &header ), sizeof( header ) ) < 0 )
+        return false;
+
+    static const char padding[ 16 ] = { 0 };
+
+    qint64 pos = sizeof( Qvg2Header );
+    for ( int i = 0; i < Qvg2SectionCount; i++ )
+    {
+        const auto& section = sections[ i ];
+
+        if ( section.size > 0 )
+        {
+            if ( dev->write( static_cast< const char* >( section.data ), section.size ) < 0 )
+                return false;
+        }
+
+        pos += section.size;
+
+        const auto paddingSize = qskQvg2Aligned( pos ) - pos;
+        if ( paddingSize > 0 )
+        {
+            if ( dev->write( padding, paddingSize ) < 0 )
+                return false;
+
+            pos += paddingSize;
+        }
+    }
+
+    return true;
+}
+
+template< typename T >
+static inline const T* qskQvg2Records(
+    const Qvg2Buffer& buffer, const Qvg2Header& header, int section )
+{
+    const auto& info = header.sections[ section ];
+
+    if ( ( info.offset % 8 ) || info.offset > quint64( buffer.size ) )
+        return nullptr;
+
+    if ( info.count > ( buffer.size - info.offset ) / sizeof( T ) )
+        return nullptr;
+
+    return reinterpret_cast< const T* >( buffer.data + info.offset );
+}
+
+static QPainterPath qskQvg2Path(
+    const Qvg2PathRecord& record, const Qvg2ElementRecord* elements )
+{
+    QPainterPath path;
+    path.reserve( record.elementCount );
+    path.setFillRule( static_cast< Qt::FillRule >( record.fillRule ) );
+
+    elements += record.firstElement;
+
+    const int count = record.elementCount;
+    for ( int i = 0; i < count; i++ )
+    {
+        const auto& element = elements[ i ];
+
+        switch( element.type )
+        {
+            case QPainterPath::MoveToElement:
+            {
+                path.moveTo( element.x, element.y );
+                break;
+            }
+            case QPainterPath::LineToElement:
+            {
+                path.lineTo( element.x, element.y );
+                break;
+            }
+            case QPainterPath::CurveToElement:
+            {
+                if ( i + 2 < count )
+                {
+                    const auto& e1 = elements[ i + 1 ];
+                    const auto& e2 = elements[ i + 2 ];
+
+                    path.cubicTo( element.x, element.y, e1.x, e1.y, e2.x, e2.y );
+                    i += 2;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return path;
+}
+
+static bool qskQvg2State( const Qvg2StateRecord& record,
+    const uchar* payload, quint64 payloadSize, QskPainterCommand::StateData& data )
+{
+    const auto flags = static_cast< QPaintEngine::DirtyFlags >( record.flags );
+    data.flags = flags;
+
+    if ( flags & QPaintEngine::DirtyPen )
+    {
+        QPen pen( QColor::fromRgba64( QRgba64::fromRgba64( record.penColor ) ) );
+        pen.setWidthF( record.penWidth );
+        pen.setMiterLimit( record.penMiterLimit );
+        pen.setStyle( static_cast< Qt::PenStyle >( record.penStyle ) );
+        pen.setCapStyle( static_cast< Qt::PenCapStyle >( record.penCapStyle ) );
+        pen.setJoinStyle( static_cast< Qt::PenJoinStyle >( record.penJoinStyle ) );
+        pen.setCosmetic( record.penCosmetic );
+
+        data.pen = pen;
+    }
+
+    if ( flags & QPaintEngine::DirtyBrush )
+    {
+        data.brush = QBrush( QColor::fromRgba64( QRgba64::fromRgba64( record.brushColor ) ),
+            static_cast< Qt::BrushStyle >( record.brushStyle ) );
+    }
+
+    if ( flags & QPaintEngine::DirtyBrushOrigin )
+        data.brushOrigin = QPointF( record.brushOrigin[ 0 ], record.brushOrigin[ 1 ] );
+
+    if ( flags & QPaintEngine::DirtyBackground )
+        data.backgroundMode = static_cast< Qt::BGMode >( record.backgroundMode );
+
+    if ( flags & QPaintEngine::DirtyTransform )
+    {
+        const auto t = record.transform;
+        data.transform = QTransform( t[ 0 ], t[ 1 ], t[ 2 ],
+            t[ 3 ], t[ 4 ], t[ 5 ], t[ 6 ], t[ 7 ], t[ 8 ] );
+    }
+
+    data.clipOperation = static_cast< Qt::ClipOperation >( record.clipOperation );
+    data.isClipEnabled = record.isClipEnabled;
+    data.renderHints = static_cast< QPainter::RenderHints >( record.renderHints );
+    data.compositionMode = static_cast< QPainter::CompositionMode >( record.compositionMode );
+    data.opacity = record.opacity;
+
+    const auto extensionFlags = record.extensionFlags;
+    if ( extensionFlags == 0 )
+        return true;
+
+    if ( record.extensionOffset > payloadSize
+        || record.extensionSize > payloadSize - record.extensionOffset )
+    {
+        return false;
+    }
+
+    const auto extension = QByteArray::fromRawData(
+        reinterpret_cast< const char* >( payload + record.extensionOffset ),
+        record.extensionSize );
+
+    QDataStream s( extension );
+    s.setVersion( qskDataStreamVersion );
+    s.setByteOrder( QDataStream::BigEndian );
+
+    if ( extensionFlags & QPaintEngine::DirtyPen )
+        s >> data.pen;
+
+    if ( extensionFlags & QPaintEngine::DirtyBrush )
+        s >> data.brush;
+
+    if ( extensionFlags & QPaintEngine::DirtyFont )
+        s >> data.font;
+
+    if ( extensionFlags & QPaintEngine::DirtyBackground )
+        s >> data.backgroundBrush;
+
+    if ( extensionFlags & QPaintEngine::DirtyClipRegion )
+        s >> data.clipRegion;
+
+    if ( extensionFlags & QPaintEngine::DirtyClipPath )
+        s >> data.clipPath;
+
+    return s.status() == QDataStream::Ok;
+}
+
+static bool qskQvg2Raster( const Qvg2RasterRecord& record,
+    const Qvg2BufferPtr& buffer, const uchar* payload, quint64 payloadSize,
+    QVector< QskPainterCommand >& commands )
+{
+    if ( record.format == QImage::Format_Invalid
+        || record.format >= QImage::NImageFormats )
+    {
+        return false;
+    }
+
+    const auto dataSize = quint64( record.bytesPerLine ) * record.height;
+
+    if ( ( record.dataOffset % 4 ) || record.dataOffset > payloadSize
+        || dataSize > payloadSize - record.dataOffset )
+    {
+        return false;
+    }
+
+    QImage image;
+
+    if ( record.width > 0 && record.height > 0 )
+    {
+        /*
+            The image refers to the data of the buffer, that is kept
+            alive until the image has been destroyed.
+         */
+        auto info = new Qvg2BufferPtr( buffer );
+
+        image = QImage( payload + record.dataOffset,
+            record.width, record.height, record.bytesPerLine,
+            static_cast< QImage::Format >( record.format ),
+            qskReleaseQvg2Buffer, info );
+
+        if ( image.isNull() )
+        {
+            delete info;
+            return false;
+        }
+    }
+
+    const auto r = record.rect;
+    const QRectF rect( r[ 0 ], r[ 1 ], r[ 2 ], r[ 3 ] );
+
+    const auto sr = record.subRect;
+    const QRectF subRect( sr[ 0 ], sr[ 1 ], sr[ 2 ], sr[ 3 ] );
+
+    if ( record.isPixmap )
+    {
+        commands += QskPainterCommand( rect, QPixmap::fromImage( image ), subRect );
+    }
+    else
+    {
+        const auto flags = static_cast< Qt::ImageConversionFlags >( record.conversionFlags );
+        commands += QskPainterCommand( rect, image, subRect, flags );
+    }
+
+    return true;
+}
+
+static inline bool qskHasQvg2Rasters( const uchar* data, qint64 size )
+{
+    if ( size < qint64( sizeof( Qvg2Header ) ) )
+        return false;
+
+    const auto& header = *reinterpret_cast< const Qvg2Header* >( data );
+    return header.sections[ Qvg2Rasters ].count > 0;
+}
+
+static QskGraphic qskReadQvg2( const Qvg2BufferPtr& buffer )
+{
+    if ( buffer->size < qint64( sizeof( Qvg2Header ) ) )
+        return QskGraphic();
+
+    const auto& header = *reinterpret_cast< const Qvg2Header* >( buffer->data );
+    if ( header.version != 2 )
+    {
+        qWarning( "QskGraphicIO::read: unsupported version: %d", int( header.version ) );
+        return QskGraphic();
+    }
+
+    const auto commandRecords = qskQvg2Records< Qvg2CommandRecord >( *buffer, header, Qvg2Commands );
+    const auto pathRecords = qskQvg2Records< Qvg2PathRecord >( *buffer, header, Qvg2Paths );
+    const auto elementRecords = qskQvg2Records< Qvg2ElementRecord >( *buffer, header, Qvg2Elements );
+    const auto rasterRecords = qskQvg2Records< Qvg2RasterRecord >( *buffer, header, Qvg2Rasters );
+    const auto stateRecords = qskQvg2Records< Qvg2StateRecord >( *buffer, header, Qvg2States );
+    const auto payload = qskQvg2Records< uchar >( *buffer, header, Qvg2Payload );
+
+    if ( commandRecords == nullptr || pathRecords == nullptr || elementRecords == nullptr
+        || rasterRecords == nullptr || stateRecords == nullptr || payload == nullptr
+        || header.commandCount != header.sections[ Qvg2Commands ].count )
+    {
+        qWarning( "QskGraphicIO::read: corrupted data" );
+        return QskGraphic();
+    }
+
+    const auto& sections = header.sections;
+
+    QVector< QskPainterCommand > commands;
+    commands.reserve( header.commandCount );
+
+    for ( quint32 i = 0; i < header.commandCount; i++ )
+    {
+        const auto& command = commandRecords[ i ];
+
+        bool ok = false;
+
+        switch ( command.type )
+        {
+            case QskPainterCommand::Path:
+            {
+                if ( command.index < sections[ Qvg2Paths ].count )
+                {
+                    const auto& record = pathRecords[ command.index ];
+
+                    ok = quint64( record.firstElement ) + record.elementCount
+                        <= sections[ Qvg2Elements ].count;
+
+                    if ( ok )
+                        commands += QskPainterCommand( qskQvg2Path( record, elementRecords ) );
+                }
+                break;
+            }
+            case QskPainterCommand::Pixmap:
+            case QskPainterCommand::Image:
+            {
+                if ( command.index < sections[ Qvg2Rasters ].count )
+                {
+                    ok = qskQvg2Raster( rasterRecords[ command.index ], buffer,
+                        payload, sections[ Qvg2Payload ].count, commands );
+                }
+                break;
+            }
+            case QskPainterCommand::State:
+            {
+                if ( command.index < sections[ Qvg2States ].count )
+                {
+                    QskPainterCommand::StateData data;
+
+                    ok = qskQvg2State( stateRecords[ command.index ],
+                        payload, sections[ Qvg2Payload ].count, data );
+
+                    if ( ok )
+                        commands += QskPainterCommand( data );
+                }
+                break;
+            }
+        }
+
+        if ( !ok )
+        {
+            qWarning( "QskGraphicIO::read: corrupted data" );
+            return QskGraphic();
+        }
+    }
+
+    const auto vb = header.viewBox;
+
+    QskGraphic graphic;
+    graphic.setViewBox( QRectF( vb[ 0 ], vb[ 1 ], vb[ 2 ], vb[ 3 ] ) );
+    graphic.setCommands( commands );
+
+    return graphic;
+}
+
+#endif
+
+static QskGraphic qskReadQvg2( const QByteArray& data )
+{
+#ifdef QSK_QVG2_SUPPORTED
+    auto buffer = std::make_shared< Qvg2Buffer >();
+
+    buffer->bytes = data;
+
+    if ( quintptr( data.constData() ) % 8 )
+    {
+        // f.e. QByteArray::fromRawData with unaligned data
+        buffer->bytes.detach();
+    }
+
+    buffer->data = reinterpret_cast< const uchar* >( buffer->bytes.constData() );
+    buffer->size = buffer->bytes.size();
+
+    return qskReadQvg2( Qvg2BufferPtr( buffer ) );
+#else
+    Q_UNUSED( data );
+    qWarning( "QskGraphicIO::read: QVG v2 is not supported on big endian systems" );
+
+    return QskGraphic();
+#endif
+}
+
+static QskGraphic qskReadQvg2( std::unique_ptr< QFile > file )
+{
+#ifdef QSK_QVG2_SUPPORTED
+    /*
+        Memory mapping works for regular files and uncompressed
+        Qt resources. Otherwise we fall back to reading the file.
+
+        Images would refer to the mapped data and keep the file open
+        as long as the graphic is alive. To avoid having a file descriptor
+        for each graphic, files with raster data are read into memory.
+     */
+    const auto size = file->size();
+
+    if ( auto data = file->map( 0, size ) )
+    {
+        if ( quintptr( data ) % 8 == 0 && !qskHasQvg2Rasters( data, size ) )
+        {
+            auto buffer = std::make_shared< Qvg2Buffer >();
+
+            buffer->data = data;
+            buffer->size = size;
+            buffer->file = std::move( file );
+
+            return qskReadQvg2( Qvg2BufferPtr( buffer ) );
+        }
+
+        file->unmap( data );
+    }
+#endif
+
+    return qskReadQvg2( file->readAll() );
+}
+
+static QskGraphic qskReadQvg2( const uchar* data,
+    qint64 size, const std::shared_ptr< const void >& owner )
+{
+#ifdef QSK_QVG2_SUPPORTED
+    if ( quintptr( data ) % 8 == 0 )
+    {
+        auto buffer = std::make_shared< Qvg2Buffer >();
+
+        buffer->data = data;
+        buffer->size = size;
+        buffer->owner = owner;
+
+        return qskReadQvg2( Qvg2BufferPtr( buffer ) );
+    }
+#else
+    Q_UNUSED( owner );
+#endif
+
+    return qskReadQvg2( QByteArray( reinterpret_cast< const char* >( data ), size ) );
+}
+
 QskGraphic QskGraphicIO::read( const QString& fileName )
 {
-    QFile file( fileName );
-    if ( file.open( QIODevice::ReadOnly ) == false )
+    std::unique_ptr< QFile > file( new QFile( fileName ) );
+    if ( file->open( QIODevice::ReadOnly ) == false )
     {
         qWarning( "QskGraphicIO::read can't open %s", qPrintable( fileName ) );
         return QskGraphic();
     }
 
-    return read( &file );
+    if ( qskIsQvg2( file->peek( 4 ) ) )
+        return qskReadQvg2( std::move( file ) );
+
+    return read( file.get() );
 }
 
 QskGraphic QskGraphicIO::read( const QByteArray& data )
 {
+    if ( qskIsQvg2( data ) )
+        return qskReadQvg2( data );
+
     QBuffer buffer;
     buffer.setData( data );
 
+    if ( !buffer.open( QIODevice::ReadOnly ) )
+        return QskGraphic();
+
     return read( &buffer );
 }
 
+QskGraphic QskGraphicIO::read( const uchar* data,
+    qint64 size, const std::shared_ptr< const void >& owner )
+{
+    if ( data == nullptr || size < 4 )
+        return QskGraphic();
+
+    if ( memcmp( data, qskMagicNumber2, 4 ) == 0 )
+        return qskReadQvg2( data, size, owner );
+
+    // v1 is decoded into new objects, so there is no need to keep the data
+    return read( QByteArray::fromRawData( reinterpret_cast< const char* >( data ), size ) );
+}
+
 QskGraphic QskGraphicIO::read( QIODevice* dev )
 {
     if ( dev == nullptr )
         return QskGraphic();
 
+    if ( qskIsQvg2( dev->peek( 4 ) ) )
+        return qskReadQvg2( dev->readAll() );
+
     QDataStream stream( dev );
 #if 1
     stream.setVersion( qskDataStreamVersion );
@@ -289,7 +1188,8 @@ QskGraphic QskGraphicIO::read( QIODevice* dev )
     return graphic;
 }
 
-bool QskGraphicIO::write( const QskGraphic& graphic, const QString& fileName )
+bool QskGraphicIO::write( const QskGraphic& graphic,
+    const QString& fileName, Version version )
 {
     QFile file( fileName );
     if ( file.open( QIODevice::WriteOnly | QIODevice::Truncate ) == false )
@@ -298,20 +1198,34 @@ bool QskGraphicIO::write( const QskGraphic& graphic, const QString& fileName )
         return false;
     }
 
-    return write( graphic, &file );
+    return write( graphic, &file, version );
 }
 
-bool QskGraphicIO::write( const QskGraphic& graphic, QByteArray& data )
+bool QskGraphicIO::write( const QskGraphic& graphic,
+    QByteArray& data, Version version )
 {
     QBuffer buffer( &data );
-    return write( graphic, &buffer );
+    if ( !buffer.open( QIODevice::WriteOnly ) )
+        return false;
+
+    return write( graphic, &buffer, version );
 }
 
-bool QskGraphicIO::write( const QskGraphic& graphic, QIODevice* dev )
+bool QskGraphicIO::write( const QskGraphic& graphic,
+    QIODevice* dev, Version version )
 {
     if ( dev == nullptr )
         return false;
 
+    if ( version == Version2 )
+    {
+#ifdef QSK_QVG2_SUPPORTED
+        return qskWriteQvg2( graphic, dev );
+#else
+        qWarning( "QskGraphicIO::write: QVG v2 is not supported on big endian systems" );
+#endif
+    }
+
     QDataStream stream( dev );
 #if 1
     stream.setVersion( qskDataStreamVersion );
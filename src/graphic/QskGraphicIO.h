@@ -7,6 +7,7 @@
 #define QSK_GRAPHIC_IO_H
 
 #include "QskGlobal.h"
+#include <memory>
 
 class QskGraphic;
 class QString;
@@ -15,13 +16,49 @@ class QByteArray;
 
 namespace QskGraphicIO
 {
+    enum Version
+    {
+        /*
+            QDataStream based format, where each command
+            has to be decoded into heap allocated objects
+         */
+        Version1 = 1,
+
+        /*
+            Flat arrays of fixed size records, that can be used directly
+            from a memory mapped file or Qt resource. Files with raster
+            data are read into memory instead, so that graphics do not keep
+            files open. Otherwise raster data is not copied and graphics loaded
+            from a QByteArray keep a reference to it. So don't pass
+            QByteArray::fromRawData with data, that does not outlive the graphic.
+         */
+        Version2 = 2
+    };
+
+    /*
+        The version is detected from the data when reading. Version2 has
+        to be requested explicitly when writing, as it can't be read by
+        libraries, that support Version1 only.
+     */
     QSK_EXPORT QskGraphic read( const QString& fileName );
     QSK_EXPORT QskGraphic read( const QByteArray& data );
     QSK_EXPORT QskGraphic read( QIODevice* dev );
 
-    QSK_EXPORT bool write( const QskGraphic&, const QString& fileName );
-    QSK_EXPORT bool write( const QskGraphic&, QByteArray& data );
-    QSK_EXPORT bool write( const QskGraphic&, QIODevice* dev );
+    /*
+        Reading from memory, f.e. from a memory mapped archive. For v2 the
+        graphic might refer to the data, that is kept alive by the owner.
+     */
+    QSK_EXPORT QskGraphic read( const uchar* data, qint64 size,
+        const std::shared_ptr< const void >& owner );
+
+    QSK_EXPORT bool write( const QskGraphic&,
+        const QString& fileName, Version = Version1 );
+
+    QSK_EXPORT bool write( const QskGraphic&,
+        QByteArray& data, Version = Version1 );
+
+    QSK_EXPORT bool write( const QskGraphic&,
+        QIODevice* dev, Version = Version1 );
 }
 
 #endif
@@ -75,12 +75,12 @@ QImage QskGraphicImageProvider::requestImage(
         return dummy;
     }
 
-    const auto graphic = requestGraphic( id );
-    if ( graphic == nullptr )
+    const auto graphic = this->graphic( id );
+    if ( graphic.isNull() )
         return QImage();
 
-    const QSize sz = qskGraphicSize( *graphic, requestedSize, size );
-    return graphic->toImage( sz, Qt::KeepAspectRatio );
+    const QSize sz = qskGraphicSize( graphic, requestedSize, size );
+    return graphic.toImage( sz, Qt::KeepAspectRatio );
 }
 
 QPixmap QskGraphicImageProvider::requestPixmap(
@@ -96,12 +96,12 @@ QPixmap QskGraphicImageProvider::requestPixmap(
         return dummy;
     }
 
-    const auto graphic = requestGraphic( id );
-    if ( graphic == nullptr )
+    const auto graphic = this->graphic( id );
+    if ( graphic.isNull() )
         return QPixmap();
 
-    const QSize sz = qskGraphicSize( *graphic, requestedSize, size );
-    return graphic->toPixmap( sz, Qt::KeepAspectRatio );
+    const QSize sz = qskGraphicSize( graphic, requestedSize, size );
+    return graphic.toPixmap( sz, Qt::KeepAspectRatio );
 }
 
 QQuickTextureFactory* QskGraphicImageProvider::requestTexture(
@@ -110,12 +110,25 @@ QQuickTextureFactory* QskGraphicImageProvider::requestTexture(
     if ( requestedSize.width() == 0 || requestedSize.height() == 0 )
         return nullptr;
 
-    const auto graphic = requestGraphic( id );
-    if ( graphic == nullptr )
+    const auto graphic = this->graphic( id );
+    if ( graphic.isNull() )
         return nullptr;
 
-    const QSize sz = qskGraphicSize( *graphic, requestedSize, size );
-    return new QskGraphicTextureFactory( *graphic, sz );
+    const QSize sz = qskGraphicSize( graphic, requestedSize, size );
+    return new QskGraphicTextureFactory( graphic, sz );
+}
+
+QskGraphic QskGraphicImageProvider::graphic( const QString& id ) const
+{
+    /*
+        The image provider is called from the threads of the QML engine,
+        while the cache of the graphic provider is populated from others.
+        So we need a copy and not a pointer, that might be evicted.
+     */
+    if ( auto graphicProvider = Qsk::graphicProvider( m_providerId ) )
+        return graphicProvider->graphic( id );
+
+    return QskGraphic();
 }
 
 const QskGraphic* QskGraphicImageProvider::requestGraphic( const QString& id ) const
@@ -29,6 +29,10 @@ class QSK_EXPORT QskGraphicImageProvider : public QQuickImageProvider
     QString graphicProviderId() const;
 
   protected:
+    // a copy of the graphic, that can be used from the threads of the QML engine
+    QskGraphic graphic( const QString& id ) const;
+
+    // deprecated: see QskGraphicProvider::requestGraphic, use graphic() instead
     const QskGraphic* requestGraphic( const QString& id ) const;
 
   private:
@@ -6,6 +6,7 @@
 #include "QskGraphicProvider.h"
 #include "QskGraphicProviderMap.h"
 #include "QskGraphic.h"
+#include "QskPainterCommand.h"
 #include "QskSkinManager.h"
 #include "QskSkin.h"
 
@@ -13,16 +14,132 @@
 #include <qcache.h>
 #include <qdebug.h>
 #include <qurl.h>
+#include <qhash.h>
+#include <qvector.h>
+#include <qpointer.h>
+#include <qrunnable.h>
+#include <qthread.h>
+#include <qthreadpool.h>
+#include <qcoreapplication.h>
 #include <qglobalstatic.h>
+#include <qstringlist.h>
+
+#include <atomic>
+#include <limits>
 
 Q_GLOBAL_STATIC( QskGraphicProviderMap, qskGraphicProviders )
 
+static QString qskImageId( const QUrl& url )
+{
+    QString imageId = url.toString( QUrl::RemoveScheme |
+        QUrl::RemoveAuthority | QUrl::NormalizePathSegments );
+
+    if ( !imageId.isEmpty() && imageId[ 0 ] == '/' )
+        imageId = imageId.mid( 1 );
+
+    return imageId;
+}
+
+static void qskDeliverLater( const QObject* context,
+    const std::function< void( const QskGraphic& ) >& callback,
+    const QskGraphic& graphic )
+{
+    const QPointer< const QObject > ctx( context );
+
+    QMetaObject::invokeMethod( qApp,
+        [ ctx, callback, graphic ]() { if ( ctx ) callback( graphic ); },
+        Qt::QueuedConnection );
+}
+
+namespace
+{
+    class LoadTask final : public QRunnable
+    {
+      public:
+        LoadTask( const std::function< void() >& function )
+            : m_function( function )
+        {
+        }
+
+        void run() override
+        {
+            m_function();
+        }
+
+      private:
+        const std::function< void() > m_function;
+    };
+}
+
+static inline bool qskIsGuiThread()
+{
+    const auto app = QCoreApplication::instance();
+    return ( app == nullptr ) || ( QThread::currentThread() == app->thread() );
+}
+
+static inline qint64 qskPathCost( const QPainterPath& path )
+{
+    return path.elementCount() * qint64( sizeof( QPainterPath::Element ) );
+}
+
+namespace
+{
+    class PrefetchTask final : public QRunnable
+    {
+      public:
+        PrefetchTask( const QskGraphicProvider* provider,
+                const QStringList& ids, const std::atomic< bool >* isCancelled )
+            : m_provider( provider )
+            , m_ids( ids )
+            , m_isCancelled( isCancelled )
+        {
+        }
+
+        void run() override
+        {
+            for ( const auto& id : m_ids )
+            {
+                if ( *m_isCancelled )
+                    break;
+
+                ( void ) m_provider->graphic( id );
+            }
+        }
+
+      private:
+        const QskGraphicProvider* m_provider;
+        const QStringList m_ids;
+        const std::atomic< bool >* m_isCancelled;
+    };
+}
+
 class QskGraphicProvider::PrivateData
 {
   public:
+    PrivateData()
+    {
+        cache.setMaxCost( 8 * 1024 * 1024 );
+
+        // prefetching should not compete with other tasks of the application
+        prefetchPool.setMaxThreadCount( 1 );
+    }
+
     // caching of graphics
     QCache< QString, const QskGraphic > cache;
     QMutex mutex;
+
+    QThreadPool prefetchPool;
+    std::atomic< bool > isCancelled { false };
+
+    // asynchronous requests: GUI thread only
+    struct Request
+    {
+        QPointer< const QObject > context;
+        Callback callback;
+    };
+
+    QHash< QString, QVector< Request > > requests;
+    QThreadPool loadingPool;
 };
 
 QskGraphicProvider::QskGraphicProvider( QObject* parent )
@@ -33,64 +150,281 @@ QskGraphicProvider::QskGraphicProvider( QObject* parent )
 
 QskGraphicProvider::~QskGraphicProvider()
 {
+    // too late, when the derived part is in use, see cancelLoading()
+
+    m_data->loadingPool.clear();
+    m_data->loadingPool.waitForDone();
+
+    m_data->prefetchPool.clear();
+    m_data->prefetchPool.waitForDone();
 }
 
-void QskGraphicProvider::setCacheSize( int size )
+void QskGraphicProvider::setMaximumCacheCost( int cost )
 {
-    if ( size < 0 )
-        size = 0;
+    if ( cost < 0 )
+        cost = 0;
 
     QMutexLocker locker( &m_data->mutex );
-    m_data->cache.setMaxCost( size );
+    m_data->cache.setMaxCost( cost );
 }
 
-int QskGraphicProvider::cacheSize() const
+int QskGraphicProvider::maximumCacheCost() const
 {
     QMutexLocker locker( &m_data->mutex );
     return m_data->cache.maxCost();
 }
 
+int QskGraphicProvider::cacheCost() const
+{
+    QMutexLocker locker( &m_data->mutex );
+    return m_data->cache.totalCost();
+}
+
 void QskGraphicProvider::clearCache()
 {
     QMutexLocker locker( &m_data->mutex );
     m_data->cache.clear();
 }
 
-const QskGraphic* QskGraphicProvider::requestGraphic( const QString& id ) const
+void QskGraphicProvider::prefetch( const QStringList& ids )
+{
+    if ( !ids.isEmpty() )
+    {
+        m_data->prefetchPool.start(
+            new PrefetchTask( this, ids, &m_data->isCancelled ) );
+    }
+}
+
+void QskGraphicProvider::waitForPrefetching()
 {
-    const QskGraphic* graphic = nullptr;
+    m_data->prefetchPool.waitForDone();
+}
+
+void QskGraphicProvider::requestGraphicAsync( const QString& id,
+    const QObject* context, const Callback& callback )
+{
+    auto& requests = m_data->requests[ id ];
+    requests += PrivateData::Request { context, callback };
+
+    if ( requests.count() > 1 )
+        return; // served by the load operation in progress
 
+    auto load = [ this, id ]()
     {
-        QMutexLocker locker( &m_data->mutex );
-        graphic = m_data->cache.object( id );
+        const auto graphic = this->graphic( id );
+
+        /*
+            Using the provider as context: when it has been
+            deleted in the meantime, the result is dropped.
+         */
+        QMetaObject::invokeMethod( this,
+            [ this, id, graphic ]() { deliverGraphic( id, graphic ); },
+            Qt::QueuedConnection );
+    };
+
+    m_data->loadingPool.start( new LoadTask( load ) );
+}
+
+void QskGraphicProvider::deliverGraphic( const QString& id, const QskGraphic& graphic )
+{
+    const auto requests = m_data->requests.take( id );
+
+    for ( const auto& request : requests )
+    {
+        if ( request.context )
+            request.callback( graphic );
     }
+}
 
-    if ( graphic == nullptr )
+void QskGraphicProvider::cancelLoading()
+{
+    // a prefetch task stops after the graphic it is currently loading
+    m_data->isCancelled = true;
+
+    m_data->prefetchPool.clear();
+    m_data->loadingPool.clear();
+
+    m_data->prefetchPool.waitForDone();
+    m_data->loadingPool.waitForDone();
+
+    m_data->isCancelled = false;
+
+    // the requests, that have not been served, are answered with a null graphic
+
+    const auto requests = m_data->requests;
+    m_data->requests.clear();
+
+    for ( const auto& list : requests )
     {
-        graphic = loadGraphic( id );
+        for ( const auto& request : list )
+            qskDeliverLater( request.context, request.callback, QskGraphic() );
+    }
+}
 
-        if ( graphic == nullptr )
-        {
-            qWarning() << "QskGraphicProvider: can't load" << id;
-            return nullptr;
-        }
+int QskGraphicProvider::graphicCost( const QskGraphic& graphic )
+{
+    const auto& commands = graphic.commands();
+
+    qint64 cost = sizeof( QskGraphic )
+        + commands.size() * qint64( sizeof( QskPainterCommand ) );
 
+    for ( const auto& command : commands )
+    {
+        switch( command.type() )
         {
-            QMutexLocker locker( &m_data->mutex );
+            case QskPainterCommand::Path:
+            {
+                cost += sizeof( QPainterPath ) + qskPathCost( *command.path() );
+                break;
+            }
+            case QskPainterCommand::Pixmap:
+            {
+                const auto& pixmap = command.pixmapData()->pixmap;
 
-            if( auto cached = m_data->cache.object( id ) )
+                cost += sizeof( QskPainterCommand::PixmapData )
+                    + qint64( pixmap.width() ) * pixmap.height() * pixmap.depth() / 8;
+                break;
+            }
+            case QskPainterCommand::Image:
             {
-                delete graphic;
-                graphic = cached;
+                cost += sizeof( QskPainterCommand::ImageData )
+                    + command.imageData()->image.sizeInBytes();
+                break;
             }
-            else
+            case QskPainterCommand::State:
             {
-                const int cost = 1; // TODO ...
-                m_data->cache.insert( id, graphic, cost );
+                cost += sizeof( QskPainterCommand::StateData )
+                    + qskPathCost( command.stateData()->clipPath );
+                break;
             }
+            default:
+                break;
         }
     }
 
+    return static_cast< int >( qMin( cost, qint64( std::numeric_limits< int >::max() ) ) );
+}
+
+const QskGraphic* QskGraphicProvider::requestGraphic( const QString& id ) const
+{
+    {
+        QMutexLocker locker( &m_data->mutex );
+
+        if ( auto graphic = m_data->cache.object( id ) )
+            return graphic;
+    }
+
+    const auto graphic = loadGraphic( id );
+    if ( graphic == nullptr )
+    {
+        qWarning() << "QskGraphicProvider: can't load" << id;
+        return nullptr;
+    }
+
+    const auto cost = graphicCost( *graphic );
+
+    QMutexLocker locker( &m_data->mutex );
+    return cacheGraphic( id, graphic, cost );
+}
+
+QskGraphic QskGraphicProvider::graphic( const QString& id ) const
+{
+    {
+        QMutexLocker locker( &m_data->mutex );
+
+        if ( auto graphic = m_data->cache.object( id ) )
+            return *graphic;
+    }
+
+    const auto loaded = loadGraphic( id );
+    if ( loaded == nullptr )
+    {
+        qWarning() << "QskGraphicProvider: can't load" << id;
+        return QskGraphic();
+    }
+
+    /*
+        Another thread might evict the graphic, as soon as the mutex
+        is released. So we return a ( implicitly shared ) copy
+     */
+    const QskGraphic copy = *loaded;
+    const auto cost = graphicCost( copy );
+
+    QMutexLocker locker( &m_data->mutex );
+
+    const auto& cache = m_data->cache;
+
+    if ( qskIsGuiThread() || cache.contains( id )
+        || ( cache.totalCost() + cost <= cache.maxCost() ) )
+    {
+        ( void ) cacheGraphic( id, loaded, cost );
+    }
+    else
+    {
+        locker.unlock();
+        delete loaded;
+
+        /*
+            Evicting would invalidate pointers returned by requestGraphic,
+            that are in use by the GUI thread. So the graphic is inserted
+            from the GUI thread, where the least recently used graphics
+            are evicted as usual.
+         */
+        auto provider = const_cast< QskGraphicProvider* >( this );
+
+        QMetaObject::invokeMethod( provider,
+            [ provider, id, copy, cost ]() { provider->insertGraphic( id, copy, cost ); },
+            Qt::QueuedConnection );
+    }
+
+    return copy;
+}
+
+void QskGraphicProvider::insertGraphic(
+    const QString& id, const QskGraphic& graphic, int cost )
+{
+    QMutexLocker locker( &m_data->mutex );
+    ( void ) cacheGraphic( id, new QskGraphic( graphic ), cost );
+}
+
+const QskGraphic* QskGraphicProvider::cacheGraphic(
+    const QString& id, const QskGraphic* graphic, int cost ) const
+{
+    // the mutex is locked by the caller
+
+    auto& cache = m_data->cache;
+
+    if( auto cached = cache.object( id ) )
+    {
+        // loaded by another thread in the meantime
+        delete graphic;
+        return cached;
+    }
+
+    if ( !qskIsGuiThread() && ( cache.totalCost() + cost > cache.maxCost() ) )
+    {
+        /*
+            Evicting would invalidate pointers returned by
+            requestGraphic, that are in use by the GUI thread.
+            Only the deprecated requestGraphic can get here,
+            as graphic() hands the graphic over to the GUI thread.
+         */
+        delete graphic;
+        return nullptr;
+    }
+
+    if ( cost > cache.maxCost() )
+    {
+        qWarning() << "QskGraphicProvider: graphic exceeds the maximum cache cost:" << id;
+
+        // being the only entry of the cache, until something else is requested
+        cost = cache.maxCost();
+    }
+
+    // with a cache size of 0 the graphic gets deleted
+    if ( !cache.insert( id, graphic, qMax( cost, 1 ) ) )
+        return nullptr;
+
     return graphic;
 }
 
@@ -124,23 +458,35 @@ QskGraphic Qsk::loadGraphic( const QUrl& url )
 {
     static QskGraphic nullGraphic;
 
-    QString imageId = url.toString( QUrl::RemoveScheme |
-        QUrl::RemoveAuthority | QUrl::NormalizePathSegments );
-
+    const auto imageId = qskImageId( url );
     if ( imageId.isEmpty() )
         return nullGraphic;
 
-    if ( imageId[ 0 ] == '/' )
-        imageId = imageId.mid( 1 );
-
     const QString providerId = url.host();
 
-    const QskGraphic* graphic = nullptr;
-
     if ( const auto provider = Qsk::graphicProvider( providerId ) )
-        graphic = provider->requestGraphic( imageId );
+        return provider->graphic( imageId );
+
+    return nullGraphic;
+}
+
+void Qsk::loadGraphicAsync( const QUrl& url, const QObject* context,
+    const std::function< void( const QskGraphic& ) >& callback )
+{
+    /*
+        Looking up the provider depends on the current skin,
+        so we do it here and not in the worker thread.
+     */
+    const auto imageId = qskImageId( url );
+
+    QskGraphicProvider* provider = nullptr;
+    if ( !imageId.isEmpty() )
+        provider = Qsk::graphicProvider( url.host() );
 
-    return graphic ? *graphic : nullGraphic;
+    if ( provider )
+        provider->requestGraphicAsync( imageId, context, callback );
+    else
+        qskDeliverLater( context, callback, QskGraphic() ); // always delayed
 }
 
 #include "moc_QskGraphicProvider.cpp"
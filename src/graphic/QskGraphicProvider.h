@@ -9,33 +9,106 @@
 #include "QskGlobal.h"
 
 #include <qobject.h>
+#include <functional>
 #include <memory>
 
 class QskGraphic;
 class QUrl;
+class QStringList;
 
 class QSK_EXPORT QskGraphicProvider : public QObject
 {
     Q_OBJECT
 
-    Q_PROPERTY( int cacheSize READ cacheSize WRITE setCacheSize )
+    Q_PROPERTY( int maximumCacheCost READ maximumCacheCost WRITE setMaximumCacheCost )
 
   public:
     QskGraphicProvider( QObject* parent = nullptr );
     ~QskGraphicProvider() override;
 
-    void setCacheSize( int );
-    int cacheSize() const;
+    /*
+        The limit of the cache in bytes ( default: 8MB ). The cost of a graphic
+        is estimated from the number of its commands, the number of path
+        elements and the size of embedded images/pixmaps.
+
+        Note: this replaces setCacheSize()/cacheSize(), that had been
+              limiting the number of graphics.
+     */
+    void setMaximumCacheCost( int );
+    int maximumCacheCost() const;
+
+    // estimated bytes occupied by the cached graphics
+    int cacheCost() const;
 
     void clearCache();
 
+    /*
+        Loads the graphics in a worker thread and inserts them into
+        the cache, f.e. at startup or before a page transition. Graphics,
+        that do not fit into the cache without evicting others, are
+        inserted from the GUI thread, when control returns to the
+        event loop.
+        As loadGraphic is called from a different thread it has to be
+        thread safe and prefetching has to be stopped, before the
+        provider gets destroyed ( see cancelLoading ).
+     */
+    void prefetch( const QStringList& ids );
+    void waitForPrefetching();
+
+    /*
+        Deprecated: use graphic() instead.
+
+        The returned pointer is valid until the graphic gets evicted from
+        the cache. Graphics are evicted in the GUI thread only: graphics
+        loaded from other threads ( prefetch, requestGraphicAsync, graphic() ),
+        that do not fit into the cache, are inserted from the event loop.
+        So the pointer can be used in the GUI thread until the next call of
+        a method of the provider or returning to the event loop.
+        When being called from another thread, a graphic, that does not fit
+        into the cache, is dropped and nullptr is returned.
+     */
     const QskGraphic* requestGraphic( const QString& id ) const;
 
+    // a copy of the graphic, that can be used from any thread
+    QskGraphic graphic( const QString& id ) const;
+
+    using Callback = std::function< void( const QskGraphic& ) >;
+
+    /*
+        Loads the graphic in a worker thread of the provider. The callback
+        is invoked in the GUI thread - unless the context object has been
+        deleted in the meantime. Requests for the same id, that are made
+        while loading is in progress, are served by the same load operation.
+
+        To be called from the GUI thread only.
+     */
+    void requestGraphicAsync( const QString& id,
+        const QObject* context, const Callback& );
+
+    /*
+        Cancels prefetching and asynchronous loading and waits for the
+        requests in progress. Pending callbacks are invoked with a null graphic.
+
+        As the derived part is already gone, when ~QskGraphicProvider is
+        running, this has to be done before destroying a provider, that might
+        be in use by worker threads. QskGraphicProviderMap does this for the
+        providers it owns ( f.e the providers of a skin ).
+     */
+    void cancelLoading();
+
+    static int graphicCost( const QskGraphic& );
+
   protected:
     virtual const QskGraphic* loadGraphic( const QString& id ) const = 0;
 
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
+
+  private:
+    void deliverGraphic( const QString&, const QskGraphic& );
+    void insertGraphic( const QString&, const QskGraphic&, int cost );
+
+    const QskGraphic* cacheGraphic( const QString&, const QskGraphic*, int cost ) const;
 };
 
 namespace Qsk
@@ -45,6 +118,17 @@ namespace Qsk
 
     QSK_EXPORT QskGraphic loadGraphic( const QUrl& url );
     QSK_EXPORT QskGraphic loadGraphic( const char* source );
+
+    /*
+        Resolves the provider and loads the graphic using
+        QskGraphicProvider::requestGraphicAsync. The callback is always
+        invoked delayed, even when there is no provider for the url.
+
+        Note, that the provider has to be thread safe for this
+        ( QskGraphicProvider::loadGraphic )
+     */
+    QSK_EXPORT void loadGraphicAsync( const QUrl& url, const QObject* context,
+        const std::function< void( const QskGraphic& ) >& callback );
 }
 
 #endif
@@ -15,6 +15,23 @@ static inline QString qskKey( const QString& providerId )
     return providerId.toLower();
 }
 
+static inline void qskDeleteProvider( QskGraphicProvider* provider )
+{
+    if ( provider )
+    {
+        // worker threads must not call into a half destroyed provider
+        provider->cancelLoading();
+        delete provider;
+    }
+}
+
+static void qskDeleteProviders(
+    const QHash< QString, QPointer< QskGraphicProvider > >& hashTab )
+{
+    for ( const auto& provider : hashTab )
+        qskDeleteProvider( provider );
+}
+
 class QskGraphicProviderMap::PrivateData
 {
   public:
@@ -28,12 +45,12 @@ QskGraphicProviderMap::QskGraphicProviderMap()
 
 QskGraphicProviderMap::~QskGraphicProviderMap()
 {
-    qDeleteAll( m_data->hashTab );
+    qskDeleteProviders( m_data->hashTab );
 }
 
 void QskGraphicProviderMap::clear()
 {
-    qDeleteAll( m_data->hashTab );
+    qskDeleteProviders( m_data->hashTab );
     m_data->hashTab.clear();
 }
 
@@ -52,7 +69,7 @@ void QskGraphicProviderMap::insert(
 
 void QskGraphicProviderMap::remove( const QString& providerId )
 {
-    delete take( providerId );
+    qskDeleteProvider( take( providerId ) );
 }
 
 QskGraphicProvider* QskGraphicProviderMap::take( const QString& providerId )
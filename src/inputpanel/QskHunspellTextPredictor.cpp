@@ -93,6 +93,10 @@ class QskHunspellTextPredictor::PrivateData
     QByteArray hunspellEncoding;
     QStringList candidates;
     QLocale locale;
+
+    QString pendingText;
+    bool hasPendingRequest = false;
+    bool isRequestScheduled = false;
 };
 
 QskHunspellTextPredictor::QskHunspellTextPredictor(
@@ -114,6 +118,8 @@ QskHunspellTextPredictor::~QskHunspellTextPredictor()
 
 void QskHunspellTextPredictor::reset()
 {
+    m_data->hasPendingRequest = false;
+
     if ( !m_data->candidates.isEmpty() )
     {
         m_data->candidates.clear();
@@ -172,6 +178,34 @@ void QskHunspellTextPredictor::loadDictionaries()
 
 void QskHunspellTextPredictor::request( const QString& text )
 {
+    /*
+        Hunspell_suggest is slow and requests are queued calls from
+        the input panel. So we answer the most recent request only,
+        after all requests of the queue have been delivered.
+     */
+    m_data->pendingText = text;
+    m_data->hasPendingRequest = true;
+
+    if ( !m_data->isRequestScheduled )
+    {
+        m_data->isRequestScheduled = true;
+
+        QMetaObject::invokeMethod( this,
+            &QskHunspellTextPredictor::processRequest, Qt::QueuedConnection );
+    }
+}
+
+void QskHunspellTextPredictor::processRequest()
+{
+    m_data->isRequestScheduled = false;
+
+    if ( !m_data->hasPendingRequest )
+        return;
+
+    m_data->hasPendingRequest = false;
+
+    const auto text = m_data->pendingText;
+
     if( !m_data->hunspellHandle )
     {
         Q_EMIT predictionChanged( text, {} );
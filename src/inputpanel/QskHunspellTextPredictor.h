@@ -28,6 +28,7 @@ class QSK_EXPORT QskHunspellTextPredictor : public QskTextPredictor
 
   private:
     Q_INVOKABLE void loadDictionaries();
+    Q_INVOKABLE void processRequest();
 
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
@@ -12,6 +12,7 @@
 #include "QskPopup.h"
 #include "QskQuick.h"
 #include "QskTextPredictor.h"
+#include "QskWordGraphTextPredictor.h"
 #include "QskWindow.h"
 #include "QskPlatform.h"
 
@@ -557,6 +558,10 @@ std::shared_ptr< QskTextPredictor > QskInputContextFactory::setupPredictor( cons
 
 QskTextPredictor* QskInputContextFactory::createPredictor( const QLocale& locale )
 {
+    // precompiled word graphs are preferred as they are much faster
+    if ( !QskWordGraphTextPredictor::graphFile( locale ).isEmpty() )
+        return new QskWordGraphTextPredictor( locale );
+
 #if HUNSPELL
     return new QskHunspellTextPredictor( locale );
 #else
@@ -0,0 +1,477 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskWordGraphTextPredictor.h"
+
+#include <qdebug.h>
+#include <qdir.h>
+#include <qendian.h>
+#include <qfile.h>
+#include <qlocale.h>
+#include <qstringlist.h>
+
+#include <cstring>
+
+#include <map>
+#include <queue>
+#include <vector>
+
+/*
+    File format ( little endian ):
+
+        header: "QSKW", version, number of nodes, reserved ( 4 x 4 bytes )
+        nodes:  firstChild ( 4 bytes ), childCount ( 2 bytes ),
+                character ( 2 bytes, UTF-16 ), frequency ( 4 bytes ),
+                maximum frequency of the subtree ( 4 bytes )
+
+    The nodes are stored breadth first, so that the children of
+    a node are in a contiguous range, sorted by their characters.
+    Node 0 is the root. A frequency of 0 indicates, that the
+    path to the node is not a word.
+
+    As the frequencies are attached to the nodes, the trie is not
+    minimized to a DAWG.
+ */
+
+static const char qskMagic[] = "QSKW";
+static const quint32 qskVersion = 1;
+
+namespace
+{
+    enum
+    {
+        HeaderSize = 16,
+        NodeSize = 16
+    };
+
+    class Graph
+    {
+      public:
+        bool setData( const uchar* data, qint64 size )
+        {
+            m_nodes = nullptr;
+            m_count = 0;
+
+            if ( data == nullptr || size < HeaderSize )
+                return false;
+
+            if ( memcmp( data, qskMagic, 4 ) != 0 )
+                return false;
+
+            if ( qFromLittleEndian< quint32 >( data + 4 ) != qskVersion )
+                return false;
+
+            const auto count = qFromLittleEndian< quint32 >( data + 8 );
+            if ( count == 0 || size != HeaderSize + qint64( count ) * NodeSize )
+                return false;
+
+            m_nodes = data + HeaderSize;
+            m_count = count;
+
+            return true;
+        }
+
+        inline bool isValid() const { return m_count > 0; }
+
+        inline quint32 firstChild( quint32 node ) const
+        {
+            return qFromLittleEndian< quint32 >( m_nodes + node * NodeSize );
+        }
+
+        inline quint32 childCount( quint32 node ) const
+        {
+            const auto count = qFromLittleEndian< quint16 >( m_nodes + node * NodeSize + 4 );
+
+            // protecting against corrupted files
+            return ( firstChild( node ) + count <= m_count ) ? count : 0;
+        }
+
+        inline ushort character( quint32 node ) const
+        {
+            return qFromLittleEndian< quint16 >( m_nodes + node * NodeSize + 6 );
+        }
+
+        inline quint32 frequency( quint32 node ) const
+        {
+            return qFromLittleEndian< quint32 >( m_nodes + node * NodeSize + 8 );
+        }
+
+        inline quint32 maxFrequency( quint32 node ) const
+        {
+            return qFromLittleEndian< quint32 >( m_nodes + node * NodeSize + 12 );
+        }
+
+        bool findNode( const QString& prefix, quint32& node ) const
+        {
+            node = 0;
+
+            for ( const auto c : prefix )
+            {
+                quint32 from = firstChild( node );
+                quint32 to = from + childCount( node );
+
+                bool found = false;
+
+                while ( from < to )
+                {
+                    const auto mid = from + ( to - from ) / 2;
+                    const auto ch = character( mid );
+
+                    if ( ch == c.unicode() )
+                    {
+                        node = mid;
+                        found = true;
+                        break;
+                    }
+
+                    if ( ch < c.unicode() )
+                        from = mid + 1;
+                    else
+                        to = mid;
+                }
+
+                if ( !found )
+                    return false;
+            }
+
+            return true;
+        }
+
+        QStringList completions( const QString& prefix, int maxCount ) const
+        {
+            QStringList words;
+
+            quint32 node;
+            if ( maxCount <= 0 || !findNode( prefix, node ) )
+                return words;
+
+            /*
+                Best first search: the maximum frequency of a subtree
+                is an upper bound for all words below, so words are
+                found in the order of their frequencies.
+             */
+            class Candidate
+            {
+              public:
+                inline bool operator<( const Candidate& other ) const
+                {
+                    return score < other.score;
+                }
+
+                quint32 score;
+                quint32 node;
+                QString text;
+                bool isWord;
+            };
+
+            std::priority_queue< Candidate > queue;
+            queue.push( { maxFrequency( node ), node, prefix, false } );
+
+            while ( !queue.empty() && words.count() < maxCount )
+            {
+                const auto candidate = queue.top();
+                queue.pop();
+
+                if ( candidate.isWord )
+                {
+                    words += candidate.text;
+                    continue;
+                }
+
+                if ( const auto f = frequency( candidate.node ) )
+                    queue.push( { f, candidate.node, candidate.text, true } );
+
+                const auto first = firstChild( candidate.node );
+                const auto count = childCount( candidate.node );
+
+                for ( quint32 i = first; i < first + count; i++ )
+                {
+                    queue.push( { maxFrequency( i ), i,
+                        candidate.text + QChar( character( i ) ), false } );
+                }
+            }
+
+            return words;
+        }
+
+      private:
+        const uchar* m_nodes = nullptr;
+        quint32 m_count = 0;
+    };
+}
+
+class QskWordGraphTextPredictor::PrivateData
+{
+  public:
+    QLocale locale;
+
+    QFile file;
+    Graph graph;
+
+    QStringList candidates;
+    int maxCandidates = 20;
+
+    QString pendingText;
+    bool hasPendingRequest = false;
+    bool isRequestScheduled = false;
+};
+
+QskWordGraphTextPredictor::QskWordGraphTextPredictor(
+        const QLocale& locale, QObject* object )
+    : Inherited( object )
+    , m_data( new PrivateData() )
+{
+    m_data->locale = locale;
+
+    // loading in the thread of the predictor
+    QMetaObject::invokeMethod( this,
+        &QskWordGraphTextPredictor::loadGraph, Qt::QueuedConnection );
+}
+
+QskWordGraphTextPredictor::~QskWordGraphTextPredictor()
+{
+}
+
+void QskWordGraphTextPredictor::setMaxCandidates( int count )
+{
+    m_data->maxCandidates = qMax( count, 0 );
+}
+
+int QskWordGraphTextPredictor::maxCandidates() const
+{
+    return m_data->maxCandidates;
+}
+
+QString QskWordGraphTextPredictor::graphFile( const QLocale& locale )
+{
+    const auto userPaths = QString::fromUtf8( qgetenv( "QSK_WORDGRAPH_PATH" ) );
+    const auto paths = userPaths.split( QDir::listSeparator(), Qt::SkipEmptyParts );
+
+    const auto fileName = locale.name() + QStringLiteral( ".qwg" );
+
+    for ( const auto& path : paths )
+    {
+        const QDir dir( path );
+        if ( dir.exists( fileName ) )
+            return dir.absoluteFilePath( fileName );
+    }
+
+    return QString();
+}
+
+void QskWordGraphTextPredictor::loadGraph()
+{
+    const auto fileName = graphFile( m_data->locale );
+
+    if ( !fileName.isEmpty() )
+    {
+        m_data->file.setFileName( fileName );
+
+        if ( m_data->file.open( QIODevice::ReadOnly ) )
+        {
+            const auto size = m_data->file.size();
+            const auto data = m_data->file.map( 0, size );
+
+            if ( m_data->graph.setData( data, size ) )
+                return;
+
+            qWarning() << "invalid word graph:" << fileName;
+        }
+    }
+    else
+    {
+        qWarning() << "could not find a word graph for locale" << m_data->locale
+            << ". Consider setting QSK_WORDGRAPH_PATH to the directory "
+            << "containing the .qwg files.";
+    }
+
+    m_data->file.close();
+}
+
+void QskWordGraphTextPredictor::reset()
+{
+    m_data->hasPendingRequest = false;
+
+    if ( !m_data->candidates.isEmpty() )
+    {
+        m_data->candidates.clear();
+        Q_EMIT predictionChanged( QString(), {} );
+    }
+}
+
+void QskWordGraphTextPredictor::request( const QString& text )
+{
+    /*
+        Requests are queued calls from the input panel. When typing
+        fast we only want to answer the most recent one, so we defer
+        processing until all requests of the queue have been delivered.
+     */
+    m_data->pendingText = text;
+    m_data->hasPendingRequest = true;
+
+    if ( !m_data->isRequestScheduled )
+    {
+        m_data->isRequestScheduled = true;
+
+        QMetaObject::invokeMethod( this,
+            &QskWordGraphTextPredictor::processRequest, Qt::QueuedConnection );
+    }
+}
+
+void QskWordGraphTextPredictor::processRequest()
+{
+    m_data->isRequestScheduled = false;
+
+    if ( !m_data->hasPendingRequest )
+        return;
+
+    m_data->hasPendingRequest = false;
+
+    const auto text = m_data->pendingText;
+    const auto& graph = m_data->graph;
+
+    QStringList candidates;
+
+    if ( graph.isValid() && !text.isEmpty() )
+    {
+        candidates = graph.completions( text, m_data->maxCandidates );
+
+        if ( candidates.isEmpty() && text[0].isUpper() )
+        {
+            // capitalized words at the beginning of a sentence
+
+            auto lowerText = text;
+            lowerText[0] = lowerText[0].toLower();
+
+            candidates = graph.completions( lowerText, m_data->maxCandidates );
+
+            for ( auto& candidate : candidates )
+                candidate[0] = candidate[0].toUpper();
+        }
+    }
+
+    m_data->candidates = candidates;
+    Q_EMIT predictionChanged( text, m_data->candidates );
+}
+
+bool QskWordGraphTextPredictor::compile( QIODevice* wordList, QIODevice* graph )
+{
+    if ( wordList == nullptr || graph == nullptr )
+        return false;
+
+    class TrieNode
+    {
+      public:
+        std::map< ushort, quint32 > children;
+        quint32 frequency = 0;
+    };
+
+    std::vector< TrieNode > nodes( 1 );
+
+    while ( !wordList->atEnd() )
+    {
+        const auto line = QString::fromUtf8( wordList->readLine() ).simplified();
+        if ( line.isEmpty() )
+            continue;
+
+        const auto parts = line.split( QLatin1Char( ' ' ) );
+        const auto& word = parts[0];
+
+        quint32 frequency = 1;
+        if ( parts.count() > 1 )
+            frequency = qMax( parts[1].toUInt(), 1u );
+
+        quint32 node = 0;
+
+        for ( const auto c : word )
+        {
+            const auto it = nodes[ node ].children.find( c.unicode() );
+            if ( it != nodes[ node ].children.end() )
+            {
+                node = it->second;
+            }
+            else
+            {
+                const auto child = static_cast< quint32 >( nodes.size() );
+                nodes[ node ].children[ c.unicode() ] = child;
+                nodes.emplace_back();
+
+                node = child;
+            }
+        }
+
+        auto& f = nodes[ node ].frequency;
+        f = ( f > 0xffffffffu - frequency ) ? 0xffffffffu : f + frequency;
+    }
+
+    // breadth first order, so that siblings are contiguous
+
+    std::vector< quint32 > order;
+    order.reserve( nodes.size() );
+    order.push_back( 0 );
+
+    std::vector< quint32 > firstChild( nodes.size(), 0 );
+    std::vector< ushort > characters( nodes.size(), 0 );
+
+    for ( size_t i = 0; i < order.size(); i++ )
+    {
+        const auto& children = nodes[ order[i] ].children;
+
+        if ( children.size() > 0xffff )
+        {
+            qWarning() << "too many different characters following a prefix";
+            return false;
+        }
+
+        firstChild[ i ] = static_cast< quint32 >( order.size() );
+
+        for ( const auto& child : children )
+        {
+            characters[ order.size() ] = child.first;
+            order.push_back( child.second );
+        }
+    }
+
+    std::vector< quint32 > maxFrequencies( order.size(), 0 );
+
+    for ( size_t i = order.size(); i-- > 0; )
+    {
+        const auto& node = nodes[ order[i] ];
+
+        auto f = node.frequency;
+
+        const auto first = firstChild[ i ];
+        for ( size_t j = first; j < first + node.children.size(); j++ )
+            f = qMax( f, maxFrequencies[ j ] );
+
+        maxFrequencies[ i ] = f;
+    }
+
+    QByteArray data( HeaderSize + int( order.size() ) * NodeSize, '\0' );
+    auto p = reinterpret_cast< uchar* >( data.data() );
+
+    memcpy( p, qskMagic, 4 );
+    qToLittleEndian< quint32 >( qskVersion, p + 4 );
+    qToLittleEndian< quint32 >( static_cast< quint32 >( order.size() ), p + 8 );
+
+    p += HeaderSize;
+
+    for ( size_t i = 0; i < order.size(); i++ )
+    {
+        const auto& node = nodes[ order[i] ];
+
+        qToLittleEndian< quint32 >( firstChild[ i ], p );
+        qToLittleEndian< quint16 >( static_cast< quint16 >( node.children.size() ), p + 4 );
+        qToLittleEndian< quint16 >( characters[ i ], p + 6 );
+        qToLittleEndian< quint32 >( node.frequency, p + 8 );
+        qToLittleEndian< quint32 >( maxFrequencies[ i ], p + 12 );
+
+        p += NodeSize;
+    }
+
+    return graph->write( data ) == data.size();
+}
+
+#include "moc_QskWordGraphTextPredictor.cpp"
@@ -0,0 +1,57 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_WORD_GRAPH_TEXT_PREDICTOR_H
+#define QSK_WORD_GRAPH_TEXT_PREDICTOR_H
+
+#include "QskTextPredictor.h"
+#include <memory>
+
+class QLocale;
+class QIODevice;
+
+/*
+    A predictor for completing prefixes, that works on a precompiled
+    trie of words with their frequencies. The file is memory mapped,
+    so loading is immediate and lookups need no further allocations
+    beside the candidates.
+
+    Dictionaries are found as "<locale>.qwg" in the directories of
+    QSK_WORDGRAPH_PATH and are created from word lists with words2graph.
+ */
+class QSK_EXPORT QskWordGraphTextPredictor : public QskTextPredictor
+{
+    Q_OBJECT
+
+    using Inherited = QskTextPredictor;
+
+  public:
+    QskWordGraphTextPredictor( const QLocale& locale, QObject* = nullptr );
+    ~QskWordGraphTextPredictor() override;
+
+    void setMaxCandidates( int );
+    int maxCandidates() const;
+
+    static QString graphFile( const QLocale& );
+
+    /*
+        Each line of the word list has a word and an optional
+        frequency, separated by whitespace.
+     */
+    static bool compile( QIODevice* wordList, QIODevice* graph );
+
+  protected:
+    void request( const QString& ) override;
+    void reset() override;
+
+  private:
+    Q_INVOKABLE void loadGraph();
+    Q_INVOKABLE void processRequest();
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -463,7 +463,15 @@ bool QskGridBox::event( QEvent* event )
     {
         case QEvent::LayoutRequest:
         {
-            invalidate();
+            /*
+                The size hints of children have changed. As long as this
+                does not affect the size hints of the box there is no need
+                to bother the parent with a layout request.
+             */
+            if ( m_data->engine.invalidateHints() )
+                resetImplicitSize();
+
+            polish();
             break;
         }
         case QEvent::LayoutDirectionChange:
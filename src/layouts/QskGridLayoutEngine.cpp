@@ -14,6 +14,7 @@
 
 #include <vector>
 #include <functional>
+#include <algorithm>
 
 static inline qreal qskSegmentLength(
     const QskLayoutChain::Segments& s, int start, int end )
@@ -170,6 +171,15 @@ namespace
         return layoutItem.metrics( orientation, constraint );
     }
 
+    inline bool qskIsEqual( const QskLayoutChain::CellData& cell1,
+        const QskLayoutChain::CellData& cell2 )
+    {
+        return ( cell1.isValid == cell2.isValid )
+            && ( cell1.stretch == cell2.stretch )
+            && ( cell1.canGrow == cell2.canGrow )
+            && ( cell1.metrics == cell2.metrics );
+    }
+
     class Element
     {
       public:
@@ -377,8 +387,23 @@ class QskGridLayoutEngine::PrivateData
             ? that->columnSettings : that->rowSettings;
     }
 
+    QVector< QskLayoutChain::CellData >& elementCells( Qt::Orientation orientation ) const
+    {
+        auto that = const_cast< PrivateData* >( this );
+        return ( orientation == Qt::Horizontal )
+            ? that->columnCells : that->rowCells;
+    }
+
     ElementsVector elements;
 
+    /*
+        The cells of the elements, as they have been used for setting
+        up the unconstrained chains. They allow to find out which
+        rows/columns are affected by modified size hints.
+     */
+    QVector< QskLayoutChain::CellData > rowCells;
+    QVector< QskLayoutChain::CellData > columnCells;
+
     Settings rowSettings;
     Settings columnSettings;
 
@@ -666,15 +691,25 @@ int QskGridLayoutEngine::effectiveCount(
 void QskGridLayoutEngine::setupChain( Qt::Orientation orientation,
     const QskLayoutChain::Segments& constraints, QskLayoutChain& chain ) const
 {
+    const auto& elements = m_data->elements;
+
+    auto& elementCells = m_data->elementCells( orientation );
+    if ( constraints.isEmpty() )
+        elementCells.fill( QskLayoutChain::CellData(), elements.count() );
+    else
+        elementCells.clear();
+
     /*
         We collect all information from the simple elements first
         before adding those that occupy more than one cell
      */
-    QVarLengthArray< const Element* > postponed;
-    postponed.reserve( m_data->elements.count() );
+    QVarLengthArray< int > postponed;
+    postponed.reserve( elements.count() );
 
-    for ( const auto& element : m_data->elements )
+    for ( int i = 0; i < elements.count(); i++ )
     {
+        const auto& element = elements[ i ];
+
         if ( element.isIgnored() )
             continue;
 
@@ -693,11 +728,14 @@ void QskGridLayoutEngine::setupChain( Qt::Orientation orientation,
             if ( element.item() )
                 cell.metrics = qskItemMetrics( element.item(), orientation, constraint );
 
+            if ( !elementCells.isEmpty() )
+                elementCells[ i ] = cell;
+
             chain.expandCell( grid.top(), cell );
         }
         else
         {
-            postponed += &element;
+            postponed += i;
         }
     }
 
@@ -706,9 +744,11 @@ void QskGridLayoutEngine::setupChain( Qt::Orientation orientation,
     for ( const auto& setting : settings.settings() )
         chain.shrinkCell( setting.position, setting.cell() );
 
-    for ( const auto element : postponed )
+    for ( const auto i : postponed )
     {
-        auto grid = m_data->effectiveGrid( *element );
+        const auto& element = elements[ i ];
+
+        auto grid = m_data->effectiveGrid( element );
         if ( orientation == Qt::Horizontal )
             grid.setRect( grid.y(), grid.x(), grid.height(), grid.width() );
 
@@ -716,9 +756,124 @@ void QskGridLayoutEngine::setupChain( Qt::Orientation orientation,
         if ( !constraints.isEmpty() )
             constraint = qskSegmentLength( constraints, grid.left(), grid.right() );
 
-        auto cell = element->cell( orientation );
-        cell.metrics = qskItemMetrics( element->item(), orientation, constraint );
+        auto cell = element.cell( orientation );
+        cell.metrics = qskItemMetrics( element.item(), orientation, constraint );
+
+        if ( !elementCells.isEmpty() )
+            elementCells[ i ] = cell;
 
         chain.expandCells( grid.top(), grid.height(), cell );
     }
 }
+
+bool QskGridLayoutEngine::updateChain(
+    Qt::Orientation orientation, QskLayoutChain& chain ) const
+{
+    const auto& elements = m_data->elements;
+
+    auto& elementCells = m_data->elementCells( orientation );
+    if ( elementCells.count() != elements.count() )
+        return false;
+
+    const auto transposed = [this, orientation]( const Element& element )
+    {
+        auto grid = m_data->effectiveGrid( element );
+        if ( orientation == Qt::Horizontal )
+            grid.setRect( grid.y(), grid.x(), grid.height(), grid.width() );
+
+        return grid;
+    };
+
+    // finding the lines, where the hints of an element have changed
+
+    QVarLengthArray< int > lines;
+
+    for ( int i = 0; i < elements.count(); i++ )
+    {
+        const auto& element = elements[ i ];
+
+        if ( element.item() == nullptr )
+            continue;
+
+        auto& elementCell = elementCells[ i ];
+
+        if ( element.isIgnored() )
+        {
+            if ( elementCell.isValid )
+            {
+                // the element is still part of the chain
+                return false;
+            }
+
+            continue;
+        }
+
+        if ( !elementCell.isValid )
+        {
+            // the element has been ignored, when setting up the chain
+            return false;
+        }
+
+        auto cell = element.cell( orientation );
+        cell.metrics = qskItemMetrics( element.item(), orientation, -1.0 );
+
+        if ( qskIsEqual( cell, elementCell ) )
+            continue;
+
+        const auto grid = transposed( element );
+        if ( grid.height() != 1 )
+            return false;
+
+        elementCell = cell;
+
+        if ( std::find( lines.cbegin(), lines.cend(), grid.top() ) == lines.cend() )
+            lines += grid.top();
+    }
+
+    if ( lines.isEmpty() )
+        return true;
+
+    /*
+        Elements spanning more than one line distribute their hints
+        depending on the other cells. Here we would have to
+        rebuild the chain anyway.
+     */
+    for ( const auto& element : elements )
+    {
+        if ( element.isIgnored() )
+            continue;
+
+        const auto grid = transposed( element );
+        if ( grid.height() > 1 )
+        {
+            for ( const auto line : lines )
+            {
+                if ( line >= grid.top() && line <= grid.bottom() )
+                    return false;
+            }
+        }
+    }
+
+    const auto& settings = m_data->settings( orientation );
+
+    for ( const auto line : lines )
+    {
+        chain.resetCell( line );
+
+        for ( int i = 0; i < elements.count(); i++ )
+        {
+            const auto& element = elements[ i ];
+
+            if ( !element.isIgnored() && transposed( element ).top() == line )
+                chain.expandCell( line, elementCells[ i ] );
+        }
+
+        const auto setting = settings.settingAt( line );
+        if ( setting.position == line )
+            chain.shrinkCell( line, setting.cell() );
+    }
+
+    chain.finish();
+
+    return true;
+}
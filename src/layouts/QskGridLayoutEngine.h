@@ -64,6 +64,8 @@ class QSK_EXPORT QskGridLayoutEngine : public QskLayoutEngine2D
     void setupChain( Qt::Orientation, const QskLayoutChain::Segments&,
         QskLayoutChain& ) const override final;
 
+    bool updateChain( Qt::Orientation, QskLayoutChain& ) const override final;
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
@@ -33,6 +33,12 @@ void QskLayoutChain::reset( int count, qreal constraint )
     m_validCells = 0;
 }
 
+void QskLayoutChain::resetCell( int index )
+{
+    // the chain needs to be finished again
+    m_cells[ index ] = CellData();
+}
+
 void QskLayoutChain::shrinkCell( int index, const CellData& newCell )
 {
     if ( !newCell.isValid )
@@ -59,6 +59,7 @@ class QskLayoutChain
     void invalidate();
 
     void reset( int count, qreal constraint );
+    void resetCell( int index );
     void expandCell( int index, const CellData& );
     void expandCells( int start, int end, const CellData& );
     void shrinkCell( int index, const CellData& );
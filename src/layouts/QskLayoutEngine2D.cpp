@@ -471,6 +471,62 @@ void QskLayoutEngine2D::invalidate( int what )
     }
 }
 
+bool QskLayoutEngine2D::invalidateHints()
+{
+    if ( m_data->blockInvalidate )
+        return false;
+
+    // the size policies might have changed as well
+    m_data->constraintType = -1;
+    invalidateElementCache();
+
+    auto& rowChain = m_data->rowChain;
+    auto& columnChain = m_data->columnChain;
+
+    const auto isValid = [this]( Qt::Orientation orientation )
+    {
+        const auto& chain = m_data->layoutChain( orientation );
+        return ( chain.constraint() == -1.0 )
+            && ( chain.count() == effectiveCount( orientation ) );
+    };
+
+    if ( constraintType() != QskSizePolicy::Unconstrained
+        || !isValid( Qt::Horizontal ) || !isValid( Qt::Vertical ) )
+    {
+        invalidate( LayoutCache );
+        return true;
+    }
+
+    const auto columnMetrics = columnChain.boundingMetrics();
+    const auto rowMetrics = rowChain.boundingMetrics();
+
+    m_data->blockInvalidate = true;
+
+    const bool ok = updateChain( Qt::Horizontal, columnChain )
+        && updateChain( Qt::Vertical, rowChain );
+
+    m_data->blockInvalidate = false;
+
+    if ( !ok )
+    {
+        invalidate( LayoutCache );
+        return true;
+    }
+
+    // the segments have to be recalculated from the chains
+    m_data->layoutSize = QSize();
+    m_data->rows.clear();
+    m_data->columns.clear();
+
+    return ( columnChain.boundingMetrics() != columnMetrics )
+        || ( rowChain.boundingMetrics() != rowMetrics );
+}
+
+bool QskLayoutEngine2D::updateChain( Qt::Orientation, QskLayoutChain& ) const
+{
+    return false;
+}
+
 QskSizePolicy::ConstraintType QskLayoutEngine2D::constraintType() const
 {
     if ( m_data->constraintType < 0 )
@@ -42,6 +42,13 @@ class QSK_EXPORT QskLayoutEngine2D
 
     void invalidate();
 
+    /*
+        Updates the layout chains incrementally, when the size hints
+        of some elements have changed. Returns false, when the
+        bounding metrics of the layout are unchanged.
+     */
+    bool invalidateHints();
+
     qreal widthForHeight( qreal height ) const;
     qreal heightForWidth( qreal width ) const;
 
@@ -79,6 +86,13 @@ class QSK_EXPORT QskLayoutEngine2D
     virtual void setupChain( Qt::Orientation,
         const QskLayoutChain::Segments&, QskLayoutChain& ) const = 0;
 
+    /*
+        Updates the cells of an unconstrained chain, that are affected
+        by modified size hints. Returns false, when this is not possible
+        and the chain has to be rebuilt from scratch.
+     */
+    virtual bool updateChain( Qt::Orientation, QskLayoutChain& ) const;
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
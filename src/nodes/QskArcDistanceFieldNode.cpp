@@ -0,0 +1,538 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskArcDistanceFieldNode.h"
+#include "QskArcMetrics.h"
+#include "QskColorRamp.h"
+#include "QskFunctions.h"
+#include "QskGradient.h"
+#include "QskGradientDirection.h"
+
+#include <qcolor.h>
+#include <qsgmaterial.h>
+#include <qsgmaterialshader.h>
+#include <qsgtexture.h>
+#include <qmath.h>
+
+#include <cstring>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qsgnode_p.h>
+QSK_QT_PRIVATE_END
+
+// QSGMaterialRhiShader became QSGMaterialShader in Qt6
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+#include <QSGMaterialRhiShader>
+using RhiShader = QSGMaterialRhiShader;
+#else
+using RhiShader = QSGMaterialShader;
+#endif
+
+namespace
+{
+    class Material final : public QSGMaterial
+    {
+      public:
+        Material();
+        ~Material() override;
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+        QSGMaterialShader* createShader() const override;
+#else
+        QSGMaterialShader* createShader( QSGRendererInterface::RenderMode ) const override;
+#endif
+
+        QSGMaterialType* type() const override;
+        int compare( const QSGMaterial* other ) const override;
+
+        QVector4D m_borderColor { 0, 0, 0, 0 };
+
+        /*
+            xy: cos/sin of the angle of the midpoint
+            zw: cos/sin of the angle between midpoint/endpoint
+         */
+        QVector4D m_arc { 1, 0, -1, 0 };
+
+        // conic gradient: center relative to the center of the arc
+        QVector2D m_gradientCenter;
+        float m_gradientAspectRatio = 1.0f;
+        float m_gradientStart = 0.0f;
+        float m_gradientSpan = 1.0f;
+
+        float m_radius = 0.0f;    // center line of the arc
+        float m_thickness = 0.0f; // half of the thickness
+        float m_borderWidth = 0.0f;
+
+        QskGradientStops m_stops;
+        QskGradient::SpreadMode m_spreadMode = QskGradient::PadSpread;
+
+        QskColorRamp::Ramp* colorRamp( const void* rhi );
+
+      private:
+        // keeps the row of the ramp, as long as the material is alive
+        QskColorRamp::Ramp* m_colorRamp = nullptr;
+    };
+}
+
+namespace
+{
+    class ShaderRhi final : public RhiShader
+    {
+      public:
+        ShaderRhi()
+        {
+            const QString root( ":/qskinny/shaders/" );
+            setShaderFileName( VertexStage, root + "arc.vert.qsb" );
+            setShaderFileName( FragmentStage, root + "arc.frag.qsb" );
+        }
+
+        bool updateUniformData( RenderState& state,
+            QSGMaterial* const newMaterial, QSGMaterial* const oldMaterial ) override
+        {
+            const auto matOld = static_cast< Material* >( oldMaterial );
+            const auto matNew = static_cast< Material* >( newMaterial );
+
+            Q_ASSERT( state.uniformData()->size() >= 136 );
+
+            auto data = state.uniformData()->data();
+            bool changed = false;
+
+            if ( state.isMatrixDirty() )
+            {
+                const auto matrix = state.combinedMatrix();
+                memcpy( data + 0, matrix.constData(), 64 );
+
+                changed = true;
+            }
+
+            if ( matOld == nullptr || matNew->m_borderColor != matOld->m_borderColor )
+            {
+                memcpy( data + 64, &matNew->m_borderColor, 16 );
+                changed = true;
+            }
+
+            if ( matOld == nullptr || matNew->m_arc != matOld->m_arc )
+            {
+                memcpy( data + 80, &matNew->m_arc, 16 );
+                changed = true;
+            }
+
+            if ( matOld == nullptr || matNew->m_gradientCenter != matOld->m_gradientCenter
+                || matNew->m_gradientAspectRatio != matOld->m_gradientAspectRatio
+                || matNew->m_gradientStart != matOld->m_gradientStart
+                || matNew->m_gradientSpan != matOld->m_gradientSpan )
+            {
+                memcpy( data + 96, &matNew->m_gradientCenter, 8 );
+                memcpy( data + 104, &matNew->m_gradientAspectRatio, 4 );
+                memcpy( data + 108, &matNew->m_gradientStart, 4 );
+                memcpy( data + 112, &matNew->m_gradientSpan, 4 );
+
+                changed = true;
+            }
+
+            if ( matOld == nullptr || matNew->m_radius != matOld->m_radius
+                || matNew->m_thickness != matOld->m_thickness
+                || matNew->m_borderWidth != matOld->m_borderWidth )
+            {
+                memcpy( data + 116, &matNew->m_radius, 4 );
+                memcpy( data + 120, &matNew->m_thickness, 4 );
+                memcpy( data + 124, &matNew->m_borderWidth, 4 );
+
+                changed = true;
+            }
+
+            if ( state.isOpacityDirty() )
+            {
+                const float opacity = state.opacity();
+                memcpy( data + 128, &opacity, 4 );
+
+                changed = true;
+            }
+
+            {
+                const auto coordinate = QskColorRamp::rowCoordinate(
+                    matNew->colorRamp( state.rhi() ) );
+
+                if ( matOld == nullptr || memcmp( data + 132, &coordinate, 4 ) != 0 )
+                {
+                    memcpy( data + 132, &coordinate, 4 );
+                    changed = true;
+                }
+            }
+
+            return changed;
+        }
+
+        void updateSampledImage( RenderState& state, int binding,
+            QSGTexture* textures[], QSGMaterial* newMaterial, QSGMaterial* ) override
+        {
+            if ( binding != 1 )
+                return;
+
+            auto material = static_cast< Material* >( newMaterial );
+
+            auto texture = QskColorRamp::texture( material->colorRamp( state.rhi() ) );
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+            texture->updateRhiTexture( state.rhi(), state.resourceUpdateBatch() );
+#else
+            texture->commitTextureOperations( state.rhi(), state.resourceUpdateBatch() );
+#endif
+
+            textures[0] = texture;
+        }
+    };
+}
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+namespace
+{
+    // the old type of shader - specific for OpenGL
+
+    class ShaderGL final : public QSGMaterialShader
+    {
+        struct Uniforms
+        {
+            int matrix = -1;
+            int borderColor = -1;
+            int arc = -1;
+            int gradientCenter = -1;
+            int gradientAspectRatio = -1;
+            int gradientStart = -1;
+            int gradientSpan = -1;
+            int radius = -1;
+            int thickness = -1;
+            int borderWidth = -1;
+            int opacity = -1;
+            int rampCoordinate = -1;
+        };
+
+      public:
+        ShaderGL()
+        {
+            const QString root( ":/qskinny/shaders/" );
+            setShaderSourceFile( QOpenGLShader::Vertex, root + "arc.vert" );
+            setShaderSourceFile( QOpenGLShader::Fragment, root + "arc.frag" );
+        }
+
+        char const* const* attributeNames() const override
+        {
+            static char const* const names[] = { "in_vertex", "in_coord", nullptr };
+            return names;
+        }
+
+        void initialize() override
+        {
+            QSGMaterialShader::initialize();
+
+            const auto* const p = program();
+
+            id.matrix = p->uniformLocation( "matrix" );
+            id.borderColor = p->uniformLocation( "borderColor" );
+            id.arc = p->uniformLocation( "arc" );
+            id.gradientCenter = p->uniformLocation( "gradientCenter" );
+            id.gradientAspectRatio = p->uniformLocation( "gradientAspectRatio" );
+            id.gradientStart = p->uniformLocation( "gradientStart" );
+            id.gradientSpan = p->uniformLocation( "gradientSpan" );
+            id.radius = p->uniformLocation( "radius" );
+            id.thickness = p->uniformLocation( "thickness" );
+            id.borderWidth = p->uniformLocation( "borderWidth" );
+            id.opacity = p->uniformLocation( "opacity" );
+            id.rampCoordinate = p->uniformLocation( "rampCoordinate" );
+        }
+
+        void updateState( const QSGMaterialShader::RenderState& state,
+            QSGMaterial* const newMaterial, QSGMaterial* const oldMaterial ) override
+        {
+            auto* const p = program();
+
+            if ( state.isMatrixDirty() )
+            {
+                p->setUniformValue( id.matrix, state.combinedMatrix() );
+            }
+
+            if ( state.isOpacityDirty() )
+            {
+                p->setUniformValue( id.opacity, state.opacity() );
+            }
+
+            auto* const material = static_cast< Material* >( newMaterial );
+
+            auto updateMaterial = ( oldMaterial == nullptr ) ||
+                ( newMaterial->compare( oldMaterial ) != 0 );
+
+            updateMaterial |= state.isCachedMaterialDataDirty();
+
+            if ( updateMaterial )
+            {
+                p->setUniformValue( id.borderColor, material->m_borderColor );
+                p->setUniformValue( id.arc, material->m_arc );
+                p->setUniformValue( id.gradientCenter, material->m_gradientCenter );
+                p->setUniformValue( id.gradientAspectRatio, material->m_gradientAspectRatio );
+                p->setUniformValue( id.gradientStart, material->m_gradientStart );
+                p->setUniformValue( id.gradientSpan, material->m_gradientSpan );
+                p->setUniformValue( id.radius, material->m_radius );
+                p->setUniformValue( id.thickness, material->m_thickness );
+                p->setUniformValue( id.borderWidth, material->m_borderWidth );
+            }
+
+            const auto ramp = material->colorRamp( nullptr );
+
+            p->setUniformValue( id.rampCoordinate, QskColorRamp::rowCoordinate( ramp ) );
+            QskColorRamp::texture( ramp )->bind();
+        }
+
+      private:
+        Uniforms id;
+    };
+}
+
+#endif
+
+namespace
+{
+    Material::Material()
+    {
+        setFlag( QSGMaterial::Blending, true );
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+        setFlag( QSGMaterial::SupportsRhiShader, true );
+#endif
+    }
+
+    Material::~Material()
+    {
+        QskColorRamp::release( m_colorRamp );
+    }
+
+    QskColorRamp::Ramp* Material::colorRamp( const void* rhi )
+    {
+        m_colorRamp = QskColorRamp::update( m_colorRamp, rhi, m_stops, m_spreadMode );
+        return m_colorRamp;
+    }
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+    QSGMaterialShader* Material::createShader() const
+    {
+        if ( !( flags() & QSGMaterial::RhiShaderWanted ) )
+            return new ShaderGL();
+
+        return new ShaderRhi();
+    }
+
+#else
+
+    QSGMaterialShader* Material::createShader( QSGRendererInterface::RenderMode ) const
+    {
+        return new ShaderRhi();
+    }
+
+#endif
+
+    QSGMaterialType* Material::type() const
+    {
+        static QSGMaterialType staticType;
+        return &staticType;
+    }
+
+    int Material::compare( const QSGMaterial* const other ) const
+    {
+        auto material = static_cast< const Material* >( other );
+
+        if ( ( material->m_borderColor == m_borderColor )
+            && ( material->m_arc == m_arc )
+            && ( material->m_gradientCenter == m_gradientCenter )
+            && qFuzzyCompare( material->m_gradientAspectRatio, m_gradientAspectRatio )
+            && qFuzzyCompare( material->m_gradientStart, m_gradientStart )
+            && qFuzzyCompare( material->m_gradientSpan, m_gradientSpan )
+            && qFuzzyCompare( material->m_radius, m_radius )
+            && qFuzzyCompare( material->m_thickness, m_thickness )
+            && qFuzzyCompare( material->m_borderWidth, m_borderWidth )
+            && ( material->m_spreadMode == m_spreadMode )
+            && ( material->m_stops == m_stops ) )
+        {
+            return 0;
+        }
+
+        return QSGMaterial::compare( other );
+    }
+}
+
+template< typename T >
+static inline bool qskUpdateValue( T& value, const T& newValue )
+{
+    if ( value == newValue )
+        return false;
+
+    value = newValue;
+    return true;
+}
+
+class QskArcDistanceFieldNodePrivate final : public QSGGeometryNodePrivate
+{
+  public:
+    QskArcDistanceFieldNodePrivate()
+        : geometry( QSGGeometry::defaultAttributes_TexturedPoint2D(), 4 )
+    {
+    }
+
+    QSGGeometry geometry;
+    Material material;
+    QRectF rect;
+};
+
+QskArcDistanceFieldNode::QskArcDistanceFieldNode()
+    : QSGGeometryNode( *new QskArcDistanceFieldNodePrivate )
+{
+    Q_D( QskArcDistanceFieldNode );
+
+    setGeometry( &d->geometry );
+    setMaterial( &d->material );
+
+    d->geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
+}
+
+QskArcDistanceFieldNode::~QskArcDistanceFieldNode() = default;
+
+bool QskArcDistanceFieldNode::isSupported(
+    const QRectF& rect, const QskGradient& gradient )
+{
+    if ( !qskFuzzyCompare( rect.width(), rect.height() ) )
+        return false; // elliptic arcs
+
+    if ( !gradient.isVisible() || gradient.isMonochrome() )
+        return true;
+
+    return gradient.type() == QskGradient::Conic;
+}
+
+void QskArcDistanceFieldNode::updateNode( const QRectF& rect,
+    const QskArcMetrics& metrics, qreal borderWidth,
+    const QColor& borderColor, const QskGradient& gradient )
+{
+    Q_D( QskArcDistanceFieldNode );
+
+    if ( metrics.isNull() || rect.isEmpty() )
+    {
+        setBoundingRectangle( {} );
+        return;
+    }
+
+    if ( borderWidth <= 0.0 || borderColor.alpha() == 0 )
+        borderWidth = 0.0;
+
+    // the border is centered on the outline of the arc
+    const auto bw2 = 0.5 * borderWidth;
+
+    /*
+        The quad covers the complete circle, so that
+        angle animations do not touch the geometry. The extra
+        pixel is for the antialiasing
+     */
+    setBoundingRectangle( rect.adjusted( -bw2 - 1.0, -bw2 - 1.0, bw2 + 1.0, bw2 + 1.0 ) );
+
+    auto& material = d->material;
+    bool changed = false;
+
+    {
+        const auto outerRadius = 0.5 * qMin( rect.width(), rect.height() );
+        const auto thickness = qBound( 0.0, metrics.thickness(), outerRadius );
+
+        changed |= qskUpdateValue( material.m_radius,
+            float( outerRadius - 0.5 * thickness ) );
+
+        changed |= qskUpdateValue( material.m_thickness, float( 0.5 * thickness ) );
+        changed |= qskUpdateValue( material.m_borderWidth, float( borderWidth ) );
+    }
+
+    {
+        const auto a = borderColor.alphaF();
+        const QVector4D c( borderColor.redF() * a,
+            borderColor.greenF() * a, borderColor.blueF() * a, a );
+
+        changed |= qskUpdateValue( material.m_borderColor,
+            ( borderWidth > 0.0 ) ? c : QVector4D() );
+    }
+
+    {
+        const auto spanAngle = metrics.spanAngle();
+
+        const auto a1 = qDegreesToRadians( metrics.startAngle() + 0.5 * spanAngle );
+        const auto a2 = qDegreesToRadians( 0.5 * qMin( qAbs( spanAngle ), 360.0 ) );
+
+        const QVector4D arc( ::cos( a1 ), ::sin( a1 ), ::cos( a2 ), ::sin( a2 ) );
+        changed |= qskUpdateValue( material.m_arc, arc );
+    }
+
+    if ( gradient.isVisible() )
+    {
+        changed |= qskUpdateValue( material.m_stops, gradient.stops() );
+        changed |= qskUpdateValue( material.m_spreadMode, gradient.spreadMode() );
+    }
+    else
+    {
+        static const QskGradientStops noFill = QskGradient( Qt::transparent ).stops();
+
+        changed |= qskUpdateValue( material.m_stops, noFill );
+        changed |= qskUpdateValue( material.m_spreadMode, QskGradient::PadSpread );
+    }
+
+    if ( gradient.isVisible() && !gradient.isMonochrome() )
+    {
+        const auto dir = gradient.stretchedTo( rect ).conicDirection();
+
+        const auto center = rect.center();
+        changed |= qskUpdateValue( material.m_gradientCenter,
+            QVector2D( dir.x() - center.x(), dir.y() - center.y() ) );
+
+        float ratio = dir.aspectRatio();
+        if ( ratio <= 0.0f )
+            ratio = 1.0f;
+
+        changed |= qskUpdateValue( material.m_gradientAspectRatio, ratio );
+
+        // Angles as ratio of a rotation, like in QskGradientMaterial
+
+        float start = fmod( dir.startAngle(), 360.0 ) / 360.0;
+        if ( start < 0.0f )
+            start += 1.0f;
+
+        float span;
+
+        if ( dir.spanAngle() >= 360.0 )
+            span = 1.0f;
+        else if ( dir.spanAngle() <= -360.0 )
+            span = -1.0f;
+        else
+            span = fmod( dir.spanAngle(), 360.0 ) / 360.0;
+
+        changed |= qskUpdateValue( material.m_gradientStart, start );
+        changed |= qskUpdateValue( material.m_gradientSpan, span );
+    }
+
+    if ( changed )
+        markDirty( QSGNode::DirtyMaterial );
+}
+
+void QskArcDistanceFieldNode::setBoundingRectangle( const QRectF& rect )
+{
+    Q_D( QskArcDistanceFieldNode );
+
+    if ( d->rect == rect )
+        return;
+
+    d->rect = rect;
+
+    // texture coordinates are relative to the center of the arc
+    const auto center = rect.center();
+
+    QSGGeometry::updateTexturedRectGeometry(
+        &d->geometry, d->rect, d->rect.translated( -center ) );
+    d->geometry.markVertexDataDirty();
+
+    markDirty( QSGNode::DirtyGeometry );
+}
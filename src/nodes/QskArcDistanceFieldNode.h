@@ -0,0 +1,49 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_ARC_DISTANCE_FIELD_NODE_H
+#define QSK_ARC_DISTANCE_FIELD_NODE_H
+
+#include "QskGlobal.h"
+#include <qsgnode.h>
+
+class QskArcMetrics;
+class QskGradient;
+class QColor;
+
+class QskArcDistanceFieldNodePrivate;
+
+/*
+    An arc, where the fill and the border are done from a signed
+    distance function in the fragment shader. The geometry is a quad
+    covering the complete circle, so that changing the angles or the
+    thickness only modifies the uniforms of the material.
+
+    Limitations: circular arcs with flat caps and monochrome or
+    conic gradients only.
+
+    As the parameters of the arc are uniforms, the materials of
+    different arcs never compare equal and each arc ends up in a
+    draw call of its own.
+ */
+class QSK_EXPORT QskArcDistanceFieldNode : public QSGGeometryNode
+{
+  public:
+    QskArcDistanceFieldNode();
+    ~QskArcDistanceFieldNode() override;
+
+    static bool isSupported( const QRectF&, const QskGradient& );
+
+    // metrics need to be absolute
+    void updateNode( const QRectF&, const QskArcMetrics&,
+        qreal borderWidth, const QColor& borderColor, const QskGradient& );
+
+  private:
+    void setBoundingRectangle( const QRectF& );
+
+    Q_DECLARE_PRIVATE( QskArcDistanceFieldNode )
+};
+
+#endif
@@ -4,6 +4,7 @@
  *****************************************************************************/
 
 #include "QskArcNode.h"
+#include "QskArcDistanceFieldNode.h"
 #include "QskArcMetrics.h"
 #include "QskArcShadowNode.h"
 #include "QskMargins.h"
@@ -22,7 +23,8 @@ namespace
     {
         ShadowRole,
         FillRole,
-        BorderRole
+        BorderRole,
+        DistanceFieldRole
     };
 }
 
@@ -54,7 +56,8 @@ static inline QRectF qskEffectiveRect(
 
 static void qskUpdateChildren( QSGNode* parentNode, quint8 role, QSGNode* node )
 {
-    static const QVector< quint8 > roles = { ShadowRole, FillRole, BorderRole };
+    static const QVector< quint8 > roles =
+        { ShadowRole, FillRole, BorderRole, DistanceFieldRole };
 
     auto oldNode = QskSGNode::findChildNode( parentNode, role );
     QskSGNode::replaceChildNode( roles, role, parentNode, oldNode, node );
@@ -68,6 +71,16 @@ QskArcNode::~QskArcNode()
 {
 }
 
+void QskArcNode::setDistanceFieldPreferred( bool on )
+{
+    m_distanceFieldPreferred = on;
+}
+
+bool QskArcNode::isDistanceFieldPreferred() const
+{
+    return m_distanceFieldPreferred;
+}
+
 void QskArcNode::setArcData( const QRectF& rect,
     const QskArcMetrics& arcMetrics, const QskGradient& fillGradient )
 {
@@ -96,12 +109,16 @@ void QskArcNode::setArcData( const QRectF& rect, const QskArcMetrics& arcMetrics
     auto borderNode = static_cast< QskStrokeNode* >(
         QskSGNode::findChildNode( this, BorderRole ) );
 
+    auto distanceFieldNode = static_cast< QskArcDistanceFieldNode* >(
+        QskSGNode::findChildNode( this, DistanceFieldRole ) );
+
     const auto arcRect = qskEffectiveRect( rect, borderWidth );
     if ( metricsArc.isNull() || arcRect.isEmpty() )
     {
         delete shadowNode;
         delete fillNode;
         delete borderNode;
+        delete distanceFieldNode;
         return;
     }
 
@@ -110,8 +127,6 @@ void QskArcNode::setArcData( const QRectF& rect, const QskArcMetrics& arcMetrics
     const auto isShadowNodeVisible = isFillNodeVisible &&
         shadowColor.isValid() && ( shadowColor.alpha() > 0.0 );
 
-    const auto path = metricsArc.painterPath( arcRect );
-
     if ( isShadowNodeVisible )
     {
         if ( shadowNode == nullptr )
@@ -140,6 +155,38 @@ void QskArcNode::setArcData( const QRectF& rect, const QskArcMetrics& arcMetrics
         shadowNode = nullptr;
     }
 
+    if ( ( isFillNodeVisible || isStrokeNodeVisible )
+        && m_distanceFieldPreferred && QskArcDistanceFieldNode::isSupported( arcRect, gradient ) )
+    {
+        /*
+            Fill and border are done in the fragment shader and
+            modifying the angles does not need any triangulation
+         */
+        if ( distanceFieldNode == nullptr )
+        {
+            distanceFieldNode = new QskArcDistanceFieldNode;
+            QskSGNode::setNodeRole( distanceFieldNode, DistanceFieldRole );
+        }
+
+        distanceFieldNode->updateNode( arcRect, metricsArc,
+            isStrokeNodeVisible ? borderWidth : 0.0, borderColor,
+            isFillNodeVisible ? gradient : QskGradient() );
+
+        delete fillNode;
+        delete borderNode;
+
+        qskUpdateChildren( this, ShadowRole, shadowNode );
+        qskUpdateChildren( this, FillRole, nullptr );
+        qskUpdateChildren( this, BorderRole, nullptr );
+        qskUpdateChildren( this, DistanceFieldRole, distanceFieldNode );
+
+        return;
+    }
+
+    delete distanceFieldNode;
+
+    const auto path = metricsArc.painterPath( arcRect );
+
     if ( isFillNodeVisible )
     {
         if ( fillNode == nullptr )
@@ -178,4 +225,5 @@ void QskArcNode::setArcData( const QRectF& rect, const QskArcMetrics& arcMetrics
     qskUpdateChildren( this, ShadowRole, shadowNode );
     qskUpdateChildren( this, FillRole, fillNode );
     qskUpdateChildren( this, BorderRole, borderNode );
+    qskUpdateChildren( this, DistanceFieldRole, nullptr );
 }
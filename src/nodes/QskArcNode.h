@@ -19,6 +19,13 @@ class QSK_EXPORT QskArcNode : public QSGNode
     QskArcNode();
     ~QskArcNode() override;
 
+    /*
+        When enabled, supported arcs are drawn by QskArcDistanceFieldNode.
+        Experimental: the default setting is false
+     */
+    void setDistanceFieldPreferred( bool );
+    bool isDistanceFieldPreferred() const;
+
     void setArcData( const QRectF&, const QskArcMetrics&, const QskGradient& );
 
     void setArcData( const QRectF&, const QskArcMetrics&,
@@ -27,6 +34,9 @@ class QSK_EXPORT QskArcNode : public QSGNode
     void setArcData( const QRectF&, const QskArcMetrics&,
         qreal borderWidth, const QColor& borderColor, const QskGradient&,
         const QColor& shadowColor, const QskShadowMetrics&);
+
+  private:
+    bool m_distanceFieldPreferred = false;
 };
 
 #endif
@@ -4,6 +4,7 @@
  *****************************************************************************/
 
 #include "QskArcShadowNode.h"
+#include "QskVertex.h"
 
 #include <qcolor.h>
 #include <qsgmaterial.h>
@@ -27,6 +28,48 @@ using RhiShader = QSGMaterialShader;
 
 namespace
 {
+    /*
+        The parameters of the shadow are passed as vertex attributes,
+        so that the scene graph is able to batch shadows with
+        different angles, colors or radii.
+     */
+    class Vertex
+    {
+      public:
+        float x, y;
+        float u, v;
+
+        /*
+            arc[0,1]: cos/sin of the angle of the midpoint
+            arc[2,3]: cos/sin of the angle between midpoint/endpoint
+         */
+        float arc[4];
+
+        float spreadRadius;
+        float blurRadius;
+
+        QskVertex::Color color;
+    };
+
+    const QSGGeometry::AttributeSet& attributeSet()
+    {
+        using G = QSGGeometry;
+
+        static const G::Attribute attributes[] =
+        {
+            G::Attribute::createWithAttributeType( 0, 2, G::FloatType, G::PositionAttribute ),
+            G::Attribute::createWithAttributeType( 1, 2, G::FloatType, G::TexCoordAttribute ),
+            G::Attribute::createWithAttributeType( 2, 4, G::FloatType, G::UnknownAttribute ),
+            G::Attribute::createWithAttributeType( 3, 2, G::FloatType, G::UnknownAttribute ),
+            G::Attribute::createWithAttributeType( 4, 4, G::UnsignedByteType, G::ColorAttribute )
+        };
+
+        static const G::AttributeSet attributeSet =
+            { 5, sizeof( Vertex ), attributes };
+
+        return attributeSet;
+    }
+
     class Material final : public QSGMaterial
     {
       public:
@@ -40,12 +83,6 @@ namespace
 
         QSGMaterialType* type() const override;
         int compare( const QSGMaterial* other ) const override;
-
-        QVector4D m_color { 0, 0, 0, 1 };
-        QVector4D m_arc = {};
-
-        float m_spreadRadius = 0.0f;
-        float m_blurRadius = 0.0f;
     };
 }
 
@@ -62,12 +99,9 @@ namespace
         }
 
         bool updateUniformData( RenderState& state,
-            QSGMaterial* const newMaterial, QSGMaterial* const oldMaterial ) override
+            QSGMaterial*, QSGMaterial* ) override
         {
-            const auto matOld = static_cast< Material* >( oldMaterial );
-            const auto matNew = static_cast< Material* >( newMaterial );
-
-            Q_ASSERT( state.uniformData()->size() == 108 );
+            Q_ASSERT( state.uniformData()->size() >= 68 );
 
             auto data = state.uniformData()->data();
             bool changed = false;
@@ -80,34 +114,10 @@ namespace
                 changed = true;
             }
 
-            if ( matOld == nullptr || matNew->m_color != matOld->m_color )
-            {
-                memcpy( data + 64, &matNew->m_color, 16 );
-                changed = true;
-            }
-
-            if ( matOld == nullptr || matNew->m_arc != matOld->m_arc )
-            {
-                memcpy( data + 80, &matNew->m_arc, 16 );
-                changed = true;
-            }
-
-            if ( matOld == nullptr || matNew->m_spreadRadius != matOld->m_spreadRadius )
-            {
-                memcpy( data + 96, &matNew->m_spreadRadius, 4 );
-                changed = true;
-            }
-
-            if ( matOld == nullptr || matNew->m_blurRadius != matOld->m_blurRadius )
-            {
-                memcpy( data + 100, &matNew->m_blurRadius, 4 );
-                changed = true;
-            }
-
             if ( state.isOpacityDirty() )
             {
                 const float opacity = state.opacity();
-                memcpy( data + 104, &opacity, 4 );
+                memcpy( data + 64, &opacity, 4 );
 
                 changed = true;
             }
@@ -125,16 +135,6 @@ namespace
 
     class ShaderGL final : public QSGMaterialShader
     {
-        struct Uniforms
-        {
-            int matrix = -1;
-            int color = -1;
-            int arc = -1;
-            int spreadRadius = -1;
-            int blurRadius = -1;
-            int opacity = -1;
-        };
-
       public:
         ShaderGL()
         {
@@ -145,7 +145,11 @@ namespace
 
         char const* const* attributeNames() const override
         {
-            static char const* const names[] = { "in_vertex", "in_coord", nullptr };
+            static char const* const names[] =
+            {
+                "in_vertex", "in_coord", "in_arc", "in_radius", "in_color", nullptr
+            };
+
             return names;
         }
 
@@ -155,47 +159,29 @@ namespace
 
             const auto* const p = program();
 
-            id.matrix = p->uniformLocation( "matrix" );
-            id.color = p->uniformLocation( "color" );
-            id.arc = p->uniformLocation( "arc" );
-            id.spreadRadius = p->uniformLocation( "spreadRadius" );
-            id.blurRadius = p->uniformLocation( "blurRadius" );
-            id.opacity = p->uniformLocation( "opacity" );
+            m_matrixId = p->uniformLocation( "matrix" );
+            m_opacityId = p->uniformLocation( "opacity" );
         }
 
         void updateState( const QSGMaterialShader::RenderState& state,
-            QSGMaterial* const newMaterial, QSGMaterial* const oldMaterial ) override
+            QSGMaterial*, QSGMaterial* ) override
         {
             auto* const p = program();
 
             if ( state.isMatrixDirty() )
             {
-                p->setUniformValue( id.matrix, state.combinedMatrix() );
+                p->setUniformValue( m_matrixId, state.combinedMatrix() );
             }
 
             if ( state.isOpacityDirty() )
             {
-                p->setUniformValue( id.opacity, state.opacity() );
-            }
-
-            auto updateMaterial = ( oldMaterial == nullptr ) ||
-                ( newMaterial->compare( oldMaterial ) != 0 );
-
-            updateMaterial |= state.isCachedMaterialDataDirty();
-
-            if ( updateMaterial )
-            {
-                const auto* const material = static_cast< const Material* >( newMaterial );
-
-                p->setUniformValue( id.color, material->m_color );
-                p->setUniformValue( id.arc, material->m_arc );
-                p->setUniformValue( id.spreadRadius, material->m_spreadRadius );
-                p->setUniformValue( id.blurRadius, material->m_blurRadius );
+                p->setUniformValue( m_opacityId, state.opacity() );
             }
         }
 
       private:
-        Uniforms id;
+        int m_matrixId = -1;
+        int m_opacityId = -1;
     };
 }
 
@@ -236,19 +222,10 @@ namespace
         return &staticType;
     }
 
-    int Material::compare( const QSGMaterial* const other ) const
+    int Material::compare( const QSGMaterial* ) const
     {
-        auto material = static_cast< const Material* >( other );
-
-        if ( ( material->m_color == m_color )
-            && ( material->m_arc == m_arc )
-            && qFuzzyCompare( material->m_spreadRadius, m_spreadRadius )
-            && qFuzzyCompare( material->m_blurRadius, m_blurRadius ) )
-        {
-            return 0;
-        }
-
-        return QSGMaterial::compare( other );
+        // all parameters are vertex attributes
+        return 0;
     }
 }
 
@@ -256,13 +233,15 @@ class QskArcShadowNodePrivate final : public QSGGeometryNodePrivate
 {
   public:
     QskArcShadowNodePrivate()
-        : geometry( QSGGeometry::defaultAttributes_TexturedPoint2D(), 4 )
+        : geometry( attributeSet(), 6 )
     {
     }
 
     QSGGeometry geometry;
     Material material;
+
     QRectF rect;
+    QskHashValue hash = 0;
 };
 
 QskArcShadowNode::QskArcShadowNode()
@@ -273,8 +252,7 @@ QskArcShadowNode::QskArcShadowNode()
     setGeometry( &d->geometry );
     setMaterial( &d->material );
 
-    d->geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
-    d->material.setFlag( QSGMaterial::Blending );
+    d->geometry.setDrawingMode( QSGGeometry::DrawTriangles );
 }
 
 QskArcShadowNode::~QskArcShadowNode() = default;
@@ -283,86 +261,78 @@ void QskArcShadowNode::setShadowData(
     const QRectF& rect, qreal spreadRadius, qreal blurRadius,
     qreal startAngle, qreal spanAngle, const QColor& color )
 {
+    Q_D( QskArcShadowNode );
+
     if ( qFuzzyIsNull( spanAngle ) || color.alpha() == 0 )
     {
-        setBoundingRectangle( {} );
+        if ( !d->rect.isEmpty() )
+        {
+            d->rect = QRectF();
+            d->hash = 0;
+
+            d->geometry.allocate( 0 );
+            markDirty( QSGNode::DirtyGeometry );
+        }
+
         return;
     }
 
-    Q_D( QskArcShadowNode );
+    auto hash = qHash( spreadRadius, 9384 );
+    hash = qHash( blurRadius, hash );
+    hash = qHash( startAngle, hash );
+    hash = qHash( spanAngle, hash );
+    hash = qHash( color.rgba(), hash );
 
-    if ( d->rect != rect )
-    {
-        setBoundingRectangle( rect ); // bounding rectangle includig spread/blur
-    }
+    if ( ( rect == d->rect ) && ( hash == d->hash ) )
+        return;
+
+    d->rect = rect; // bounding rectangle includig spread/blur
+    d->hash = hash;
 
     const auto size = qMin( rect.width(), rect.height() );
 
-    {
-#if 1
-        const auto a = color.alphaF();
-        const QVector4D c( color.redF() * a, color.greenF() * a, color.blueF() * a, a );
-#else
-        const QVector4D c( color.redF(), color.greenF(), color.blueF(), color.alphaF() );
-#endif
+    Vertex vertex;
 
-        if ( d->material.m_color != c )
-        {
-            d->material.m_color = c;
-            markDirty( QSGNode::DirtyMaterial );
-        }
-    }
+    vertex.color = color;
+
+    vertex.spreadRadius = spreadRadius / size;
+    vertex.blurRadius = blurRadius / size;
 
     {
-        const float r = spreadRadius / size;
+        const auto a1 = qDegreesToRadians( startAngle + 0.5 * spanAngle );
+        const auto a2 = qDegreesToRadians( 0.5 * qAbs( spanAngle ) );
 
-        if ( d->material.m_spreadRadius != r )
-        {
-            d->material.m_spreadRadius = r;
-            markDirty( QSGNode::DirtyMaterial );
-        }
+        vertex.arc[0] = ::cos( a1 );
+        vertex.arc[1] = ::sin( a1 );
+        vertex.arc[2] = ::cos( a2 );
+        vertex.arc[3] = ::sin( a2 );
     }
 
+    if ( d->geometry.vertexCount() != 6 )
+        d->geometry.allocate( 6 );
+
+    const QPointF points[] =
     {
-        const float r = blurRadius / size;
+        rect.topLeft(), rect.topRight(), rect.bottomLeft(),
+        rect.topRight(), rect.bottomRight(), rect.bottomLeft()
+    };
 
-        if ( d->material.m_blurRadius != r )
-        {
-            d->material.m_blurRadius = r;
-            markDirty( QSGNode::DirtyMaterial );
-        }
-    }
+    auto vertices = static_cast< Vertex* >( d->geometry.vertexData() );
 
+    for ( int i = 0; i < 6; i++ )
     {
-        QVector4D arc( 0.0, 0.0, 1.0, 0.0 );
+        const auto& pos = points[i];
 
-        {
-            const auto a1 = qDegreesToRadians( startAngle + 0.5 * spanAngle );
-            const auto a2 = qDegreesToRadians( 0.5 * qAbs( spanAngle ) );
+        vertex.x = pos.x();
+        vertex.y = pos.y();
 
-            arc = QVector4D( ::cos( a1 ), ::sin( a1 ), ::cos( a2 ), ::sin( a2 ) );
-        }
+        // texture coordinates: [ -0.5, 0.5 ]
+        vertex.u = ( pos.x() == rect.left() ) ? -0.5f : 0.5f;
+        vertex.v = ( pos.y() == rect.top() ) ? -0.5f : 0.5f;
 
-        if ( d->material.m_arc != arc )
-        {
-            d->material.m_arc = arc;
-            markDirty( QSGNode::DirtyMaterial );
-        }
+        vertices[i] = vertex;
     }
-}
-
-void QskArcShadowNode::setBoundingRectangle( const QRectF& rect )
-{
-    Q_D( QskArcShadowNode );
-
-    if ( d->rect == rect )
-        return;
 
-    d->rect = rect;
-
-    QSGGeometry::updateTexturedRectGeometry(
-        &d->geometry, d->rect, { -0.5, -0.5, 1.0, 1.0 } );
     d->geometry.markVertexDataDirty();
-
     markDirty( QSGNode::DirtyGeometry );
 }
@@ -24,8 +24,6 @@ class QskArcShadowNode : public QSGGeometryNode
         qreal startAngle, qreal spanAngle, const QColor& );
 
   private:
-    void setBoundingRectangle( const QRectF& );
-
     Q_DECLARE_PRIVATE( QskArcShadowNode )
 };
 
@@ -0,0 +1,428 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskBoxDistanceFieldNode.h"
+#include "QskBoxBorderColors.h"
+#include "QskBoxBorderMetrics.h"
+#include "QskBoxShapeMetrics.h"
+#include "QskGradient.h"
+#include "QskGradientDirection.h"
+#include "QskVertex.h"
+
+#include <qsgmaterialshader.h>
+#include <qsgmaterial.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qsgnode_p.h>
+QSK_QT_PRIVATE_END
+
+// QSGMaterialRhiShader became QSGMaterialShader in Qt6
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    #include <QSGMaterialRhiShader>
+    using RhiShader = QSGMaterialRhiShader;
+#else
+    using RhiShader = QSGMaterialShader;
+#endif
+
+namespace
+{
+    class Vertex
+    {
+      public:
+        float x, y;
+
+        // position relative to the center and half of the size
+        float cx, cy, hw, hh;
+
+        // bottomRight, topRight, bottomLeft, topLeft
+        float radii[4];
+
+        // left, top, right, bottom
+        float borders[4];
+
+        QskVertex::Color fillColor1;
+        QskVertex::Color fillColor2;
+        QskVertex::Color borderColor;
+
+        float gradientPos;
+    };
+
+    const QSGGeometry::AttributeSet& attributeSet()
+    {
+        using G = QSGGeometry;
+
+        static const G::Attribute attributes[] =
+        {
+            G::Attribute::createWithAttributeType( 0, 2, G::FloatType, G::PositionAttribute ),
+            G::Attribute::createWithAttributeType( 1, 4, G::FloatType, G::UnknownAttribute ),
+            G::Attribute::createWithAttributeType( 2, 4, G::FloatType, G::UnknownAttribute ),
+            G::Attribute::createWithAttributeType( 3, 4, G::FloatType, G::UnknownAttribute ),
+            G::Attribute::createWithAttributeType( 4, 4, G::UnsignedByteType, G::ColorAttribute ),
+            G::Attribute::createWithAttributeType( 5, 4, G::UnsignedByteType, G::ColorAttribute ),
+            G::Attribute::createWithAttributeType( 6, 4, G::UnsignedByteType, G::ColorAttribute ),
+            G::Attribute::createWithAttributeType( 7, 1, G::FloatType, G::UnknownAttribute )
+        };
+
+        static const G::AttributeSet attributeSet =
+            { 8, sizeof( Vertex ), attributes };
+
+        return attributeSet;
+    }
+}
+
+namespace
+{
+    /*
+        All parameters are vertex attributes, so all instances
+        are equal and the nodes can be batched.
+     */
+    class Material final : public QSGMaterial
+    {
+      public:
+        Material();
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+        QSGMaterialShader* createShader() const override;
+#else
+        QSGMaterialShader* createShader( QSGRendererInterface::RenderMode ) const override;
+#endif
+
+        QSGMaterialType* type() const override;
+
+        int compare( const QSGMaterial* ) const override;
+    };
+}
+
+namespace
+{
+    class ShaderRhi final : public RhiShader
+    {
+      public:
+        ShaderRhi()
+        {
+            const QString root( ":/qskinny/shaders/" );
+
+            setShaderFileName( VertexStage, root + "boxsdf.vert.qsb" );
+            setShaderFileName( FragmentStage, root + "boxsdf.frag.qsb" );
+        }
+
+        bool updateUniformData( RenderState& state,
+            QSGMaterial*, QSGMaterial* ) override
+        {
+            Q_ASSERT( state.uniformData()->size() >= 68 );
+
+            auto data = state.uniformData()->data();
+            bool changed = false;
+
+            if ( state.isMatrixDirty() )
+            {
+                const auto matrix = state.combinedMatrix();
+                memcpy( data + 0, matrix.constData(), 64 );
+
+                changed = true;
+            }
+
+            if ( state.isOpacityDirty() )
+            {
+                const float opacity = state.opacity();
+                memcpy( data + 64, &opacity, 4 );
+
+                changed = true;
+            }
+
+            return changed;
+        }
+    };
+}
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+namespace
+{
+    // the old type of shader - specific for OpenGL
+
+    class ShaderGL final : public QSGMaterialShader
+    {
+      public:
+        ShaderGL()
+        {
+            const QString root( ":/qskinny/shaders/" );
+
+            setShaderSourceFile( QOpenGLShader::Vertex, root + "boxsdf.vert" );
+            setShaderSourceFile( QOpenGLShader::Fragment, root + "boxsdf.frag" );
+        }
+
+        char const* const* attributeNames() const override
+        {
+            static char const* const names[] =
+            {
+                "in_vertex", "in_rect", "in_radii", "in_borders",
+                "in_fillColor1", "in_fillColor2", "in_borderColor",
+                "in_gradientPos", nullptr
+            };
+
+            return names;
+        }
+
+        void initialize() override
+        {
+            QSGMaterialShader::initialize();
+
+            auto p = program();
+
+            m_matrixId = p->uniformLocation( "matrix" );
+            m_opacityId = p->uniformLocation( "opacity" );
+        }
+
+        void updateState( const QSGMaterialShader::RenderState& state,
+            QSGMaterial*, QSGMaterial* ) override
+        {
+            auto p = program();
+
+            if ( state.isMatrixDirty() )
+                p->setUniformValue( m_matrixId, state.combinedMatrix() );
+
+            if ( state.isOpacityDirty() )
+                p->setUniformValue( m_opacityId, state.opacity() );
+        }
+
+      private:
+        int m_matrixId = -1;
+        int m_opacityId = -1;
+    };
+}
+
+#endif
+
+Material::Material()
+{
+    setFlag( QSGMaterial::Blending, true );
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    setFlag( QSGMaterial::SupportsRhiShader, true );
+#endif
+}
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+
+QSGMaterialShader* Material::createShader() const
+{
+    if ( !( flags() & QSGMaterial::RhiShaderWanted ) )
+        return new ShaderGL();
+
+    return new ShaderRhi();
+}
+
+#else
+
+QSGMaterialShader* Material::createShader( QSGRendererInterface::RenderMode ) const
+{
+    return new ShaderRhi();
+}
+
+#endif
+
+QSGMaterialType* Material::type() const
+{
+    static QSGMaterialType staticType;
+    return &staticType;
+}
+
+int Material::compare( const QSGMaterial* ) const
+{
+    return 0;
+}
+
+static inline QskGradient qskLinearGradient(
+    const QRectF& rect, const QskGradient& gradient )
+{
+    auto g = gradient.effectiveGradient();
+
+    if ( g.stretchMode() == QskGradient::StretchToSize )
+        g.stretchTo( rect );
+
+    return g;
+}
+
+class QskBoxDistanceFieldNodePrivate final : public QSGGeometryNodePrivate
+{
+  public:
+    QskBoxDistanceFieldNodePrivate()
+        : geometry( attributeSet(), 6 )
+    {
+    }
+
+    QSGGeometry geometry;
+    Material material;
+
+    QskHashValue hash = 0;
+    QRectF rect;
+};
+
+QskBoxDistanceFieldNode::QskBoxDistanceFieldNode()
+    : QSGGeometryNode( *new QskBoxDistanceFieldNodePrivate )
+{
+    Q_D( QskBoxDistanceFieldNode );
+
+    d->geometry.setDrawingMode( QSGGeometry::DrawTriangles );
+
+    setGeometry( &d->geometry );
+    setMaterial( &d->material );
+}
+
+QskBoxDistanceFieldNode::~QskBoxDistanceFieldNode()
+{
+}
+
+bool QskBoxDistanceFieldNode::isSupported( const QRectF& rect,
+    const QskBoxShapeMetrics& shape, const QskBoxBorderColors& borderColors,
+    const QskGradient& gradient )
+{
+    const auto absoluteShape = shape.toAbsolute( rect.size() );
+
+    for ( int i = Qt::TopLeftCorner; i <= Qt::BottomRightCorner; i++ )
+    {
+        const auto radius = absoluteShape.radius( static_cast< Qt::Corner >( i ) );
+        if ( radius.width() != radius.height() )
+            return false; // elliptic corners
+    }
+
+    if ( borderColors.isVisible() && !borderColors.isMonochrome() )
+        return false;
+
+    if ( !gradient.isVisible() || gradient.isMonochrome() )
+        return true;
+
+    const auto g = gradient.effectiveGradient();
+
+    if ( g.type() != QskGradient::Linear || g.spreadMode() != QskGradient::PadSpread )
+        return false;
+
+    const auto& stops = g.stops();
+
+    return ( stops.count() == 2 )
+        && ( stops.first().position() == 0.0 ) && ( stops.last().position() == 1.0 );
+}
+
+void QskBoxDistanceFieldNode::updateNode( const QRectF& rect,
+    const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& borderMetrics,
+    const QskBoxBorderColors& borderColors, const QskGradient& gradient )
+{
+    Q_D( QskBoxDistanceFieldNode );
+
+    QskHashValue hash = 17891;
+
+    hash = shape.hash( hash );
+    hash = borderMetrics.hash( hash );
+    hash = borderColors.hash( hash );
+    hash = gradient.hash( hash );
+
+    if ( ( hash == d->hash ) && ( rect == d->rect ) )
+        return;
+
+    d->hash = hash;
+    d->rect = rect;
+
+    markDirty( QSGNode::DirtyGeometry );
+
+    if ( rect.isEmpty() )
+    {
+        d->geometry.allocate( 0 );
+        return;
+    }
+
+    if ( d->geometry.vertexCount() != 6 )
+        d->geometry.allocate( 6 );
+
+    const auto size = rect.size();
+
+    const auto absoluteShape = shape.toAbsolute( size );
+    const auto borders = borderMetrics.toAbsolute( size );
+
+    const auto maxRadius = 0.5 * qMin( size.width(), size.height() );
+
+    auto radius = [&]( Qt::Corner corner )
+    {
+        return static_cast< float >(
+            qBound( 0.0, absoluteShape.radius( corner ).width(), maxRadius ) );
+    };
+
+    const QskVertex::Color transparent( 0, 0, 0, 0 );
+
+    Vertex v;
+
+    v.fillColor1 = v.fillColor2 = v.borderColor = transparent;
+
+    v.hw = 0.5 * size.width();
+    v.hh = 0.5 * size.height();
+
+    v.radii[0] = radius( Qt::BottomRightCorner );
+    v.radii[1] = radius( Qt::TopRightCorner );
+    v.radii[2] = radius( Qt::BottomLeftCorner );
+    v.radii[3] = radius( Qt::TopLeftCorner );
+
+    v.borders[0] = borders.left();
+    v.borders[1] = borders.top();
+    v.borders[2] = borders.right();
+    v.borders[3] = borders.bottom();
+
+    if ( borderColors.isVisible() )
+        v.borderColor = borderColors.left().rgbStart();
+
+    QskLinearDirection dir;
+
+    if ( gradient.isVisible() )
+    {
+        if ( gradient.isMonochrome() )
+        {
+            v.fillColor1 = v.fillColor2 = gradient.rgbStart();
+        }
+        else
+        {
+            const auto g = qskLinearGradient( rect, gradient );
+
+            v.fillColor1 = g.rgbStart();
+            v.fillColor2 = g.rgbEnd();
+
+            dir = g.linearDirection();
+        }
+    }
+
+    if ( v.borders[0] + v.borders[1] + v.borders[2] + v.borders[3] <= 0.0f )
+        v.borderColor = v.fillColor1;
+
+    /*
+        The quad is extended by a pixel, so that there is
+        space for the antialiasing
+     */
+    const auto r = rect.adjusted( -1.0, -1.0, 1.0, 1.0 );
+    const auto center = rect.center();
+
+    const QPointF points[] =
+    {
+        r.topLeft(), r.topRight(), r.bottomLeft(),
+        r.topRight(), r.bottomRight(), r.bottomLeft()
+    };
+
+    auto vertices = static_cast< Vertex* >( d->geometry.vertexData() );
+
+    for ( int i = 0; i < 6; i++ )
+    {
+        const auto& pos = points[i];
+
+        v.x = pos.x();
+        v.y = pos.y();
+
+        v.cx = pos.x() - center.x();
+        v.cy = pos.y() - center.y();
+
+        v.gradientPos = dir.valueAt( pos );
+
+        vertices[i] = v;
+    }
+
+    d->geometry.markVertexDataDirty();
+}
@@ -0,0 +1,45 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_BOX_DISTANCE_FIELD_NODE_H
+#define QSK_BOX_DISTANCE_FIELD_NODE_H
+
+#include "QskGlobal.h"
+#include <qsgnode.h>
+
+class QskBoxShapeMetrics;
+class QskBoxBorderMetrics;
+class QskBoxBorderColors;
+class QskGradient;
+
+class QskBoxDistanceFieldNodePrivate;
+
+/*
+    A box as a single quad, where the rounded corners, the border and
+    the antialiasing are done from a signed distance function in the
+    fragment shader. Resizing does not need any tessellation and all
+    parameters are vertex attributes, so that boxes can be batched.
+
+    Limitations: circular corners, a monochrome border and
+    monochrome or simple linear gradients ( 2 stops ) only.
+ */
+class QSK_EXPORT QskBoxDistanceFieldNode : public QSGGeometryNode
+{
+  public:
+    QskBoxDistanceFieldNode();
+    ~QskBoxDistanceFieldNode() override;
+
+    static bool isSupported( const QRectF&, const QskBoxShapeMetrics&,
+        const QskBoxBorderColors&, const QskGradient& );
+
+    void updateNode( const QRectF&,
+        const QskBoxShapeMetrics&, const QskBoxBorderMetrics&,
+        const QskBoxBorderColors&, const QskGradient& );
+
+  private:
+    Q_DECLARE_PRIVATE( QskBoxDistanceFieldNode )
+};
+
+#endif
@@ -4,6 +4,7 @@
  *****************************************************************************/
 
 #include "QskBoxNode.h"
+#include "QskBoxDistanceFieldNode.h"
 #include "QskBoxFillNode.h"
 #include "QskBoxShadowNode.h"
 #include "QskBoxRectangleNode.h"
@@ -22,13 +23,15 @@ namespace
     {
         ShadowRole,
         BoxRole,
+        DistanceFieldRole,
         FillRole
     };
 }
 
 static void qskUpdateChildren( QSGNode* parentNode, quint8 role, QSGNode* node )
 {
-    static const QVector< quint8 > roles = { ShadowRole, BoxRole, FillRole };
+    static const QVector< quint8 > roles =
+        { ShadowRole, BoxRole, DistanceFieldRole, FillRole };
 
     auto oldNode = QskSGNode::findChildNode( parentNode, role );
     QskSGNode::replaceChildNode( roles, role, parentNode, oldNode, node );
@@ -58,6 +61,16 @@ QskBoxNode::~QskBoxNode()
 {
 }
 
+void QskBoxNode::setDistanceFieldPreferred( bool on )
+{
+    m_distanceFieldPreferred = on;
+}
+
+bool QskBoxNode::isDistanceFieldPreferred() const
+{
+    return m_distanceFieldPreferred;
+}
+
 void QskBoxNode::updateNode( const QRectF& rect,
     const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& borderMetrics,
     const QskBoxBorderColors& borderColors, const QskGradient& gradient,
@@ -67,6 +80,7 @@ void QskBoxNode::updateNode( const QRectF& rect,
 
     QskBoxShadowNode* shadowNode = nullptr;
     QskBoxRectangleNode* rectNode = nullptr;
+    QskBoxDistanceFieldNode* distanceFieldNode = nullptr;
     QskBoxFillNode* fillNode = nullptr;
 
     if ( !shadowMetrics.isNull()
@@ -78,12 +92,22 @@ void QskBoxNode::updateNode( const QRectF& rect,
     }
 
     /*
-        QskBoxRectangleNode is more efficient and creates batchable geometries.
-        So we prefer using it where possible.
-        Note, that the border is always done with a QskBoxRectangleNode
+        When enabled and supported, QskBoxDistanceFieldNode does
+        fill and border in one node.
+
+        Otherwise QskBoxRectangleNode is more efficient and creates
+        batchable geometries. So we prefer using it where possible.
+        When falling back to a QskBoxFillNode the border is done
+        with a QskBoxRectangleNode.
      */
 
-    if ( QskBoxRenderer::isGradientSupported( shape, gradient ) )
+    if ( m_distanceFieldPreferred && QskBoxDistanceFieldNode::isSupported(
+        rect, shape, borderColors, gradient ) )
+    {
+        distanceFieldNode = qskNode< QskBoxDistanceFieldNode >( this, DistanceFieldRole );
+        distanceFieldNode->updateNode( rect, shape, borderMetrics, borderColors, gradient );
+    }
+    else if ( QskBoxRenderer::isGradientSupported( shape, gradient ) )
     {
         rectNode = qskNode< QskBoxRectangleNode >( this, BoxRole );
         rectNode->updateNode( rect, shape, borderMetrics, borderColors, gradient );
@@ -105,5 +129,6 @@ void QskBoxNode::updateNode( const QRectF& rect,
 
     qskUpdateChildren( this, ShadowRole, shadowNode );
     qskUpdateChildren( this, BoxRole, rectNode );
+    qskUpdateChildren( this, DistanceFieldRole, distanceFieldNode );
     qskUpdateChildren( this, FillRole, fillNode );
 }
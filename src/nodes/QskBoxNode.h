@@ -23,10 +23,20 @@ class QSK_EXPORT QskBoxNode : public QSGNode
     QskBoxNode();
     ~QskBoxNode() override;
 
+    /*
+        When enabled, supported boxes are drawn by QskBoxDistanceFieldNode.
+        Experimental: the default setting is false
+     */
+    void setDistanceFieldPreferred( bool );
+    bool isDistanceFieldPreferred() const;
+
     void updateNode( const QRectF&,
         const QskBoxShapeMetrics&, const QskBoxBorderMetrics&,
         const QskBoxBorderColors&, const QskGradient&,
         const QskShadowMetrics&, const QColor& shadowColor );
+
+  private:
+    bool m_distanceFieldPreferred = false;
 };
 
 #endif
@@ -5,6 +5,7 @@
 
 #include "QskBoxShadowNode.h"
 #include "QskBoxShapeMetrics.h"
+#include "QskVertex.h"
 
 #include <qcolor.h>
 #include <qsgmaterialshader.h>
@@ -25,6 +26,44 @@ QSK_QT_PRIVATE_END
 
 namespace
 {
+    /*
+        The parameters of the shadow are passed as vertex attributes,
+        so that the scene graph is able to batch shadows with
+        different radii, colors or blur extents.
+     */
+    class Vertex
+    {
+      public:
+        float x, y;
+        float u, v;
+
+        float radius[4];
+        float aspectRatio[2];
+        float blurExtent;
+
+        QskVertex::Color color;
+    };
+
+    const QSGGeometry::AttributeSet& attributeSet()
+    {
+        using G = QSGGeometry;
+
+        static const G::Attribute attributes[] =
+        {
+            G::Attribute::createWithAttributeType( 0, 2, G::FloatType, G::PositionAttribute ),
+            G::Attribute::createWithAttributeType( 1, 2, G::FloatType, G::TexCoordAttribute ),
+            G::Attribute::createWithAttributeType( 2, 4, G::FloatType, G::UnknownAttribute ),
+            G::Attribute::createWithAttributeType( 3, 2, G::FloatType, G::UnknownAttribute ),
+            G::Attribute::createWithAttributeType( 4, 1, G::FloatType, G::UnknownAttribute ),
+            G::Attribute::createWithAttributeType( 5, 4, G::UnsignedByteType, G::ColorAttribute )
+        };
+
+        static const G::AttributeSet attributeSet =
+            { 6, sizeof( Vertex ), attributes };
+
+        return attributeSet;
+    }
+
     class Material final : public QSGMaterial
     {
       public:
@@ -39,11 +78,6 @@ namespace
         QSGMaterialType* type() const override;
 
         int compare( const QSGMaterial* other ) const override;
-
-        QVector2D m_aspectRatio = QVector2D{ 1, 1 };
-        QVector4D m_radius = QVector4D{ 0, 0, 0, 0 };
-        QVector4D m_color = QVector4D{ 0, 0, 0, 1 };
-        float m_blurExtent = 0.0;
     };
 }
 
@@ -61,12 +95,9 @@ namespace
         }
 
         bool updateUniformData( RenderState& state,
-            QSGMaterial* newMaterial, QSGMaterial* oldMaterial ) override
+            QSGMaterial*, QSGMaterial* ) override
         {
-            const auto matOld = static_cast< Material* >( oldMaterial );
-            const auto matNew = static_cast< Material* >( newMaterial );
-
-            Q_ASSERT( state.uniformData()->size() >= 112 );
+            Q_ASSERT( state.uniformData()->size() >= 68 );
 
             auto data = state.uniformData()->data();
             bool changed = false;
@@ -79,34 +110,10 @@ namespace
                 changed = true;
             }
 
-            if ( matOld == nullptr || matNew->m_color != matOld->m_color )
-            {
-                memcpy( data + 64, &matNew->m_color, 16 );
-                changed = true;
-            }
-
-            if ( matOld == nullptr || matNew->m_radius != matOld->m_radius )
-            {
-                memcpy( data + 80, &matNew->m_radius, 16 );
-                changed = true;
-            }
-
-            if ( matOld == nullptr || matNew->m_aspectRatio != matOld->m_aspectRatio )
-            {
-                memcpy( data + 96, &matNew->m_aspectRatio, 8 );
-                changed = true;
-            }
-
-            if ( matOld == nullptr || matNew->m_blurExtent != matOld->m_blurExtent )
-            {
-                memcpy( data + 104, &matNew->m_blurExtent, 4 );
-                changed = true;
-            }
-
             if ( state.isOpacityDirty() )
             {
                 const float opacity = state.opacity();
-                memcpy( data + 108, &opacity, 4 );
+                memcpy( data + 64, &opacity, 4 );
 
                 changed = true;
             }
@@ -135,7 +142,12 @@ namespace
 
         char const* const* attributeNames() const override
         {
-            static char const* const names[] = { "in_vertex", "in_coord", nullptr };
+            static char const* const names[] =
+            {
+                "in_vertex", "in_coord", "in_radius", "in_aspectRatio",
+                "in_blurExtent", "in_color", nullptr
+            };
+
             return names;
         }
 
@@ -146,15 +158,11 @@ namespace
             auto p = program();
 
             m_matrixId = p->uniformLocation( "matrix" );
-            m_aspectRatioId = p->uniformLocation( "aspectRatio" );
             m_opacityId = p->uniformLocation( "opacity" );
-            m_blurExtentId = p->uniformLocation( "blurExtent" );
-            m_radiusId = p->uniformLocation( "radius" );
-            m_colorId = p->uniformLocation( "color" );
         }
 
         void updateState( const QSGMaterialShader::RenderState& state,
-            QSGMaterial* newMaterial, QSGMaterial* oldMaterial) override
+            QSGMaterial*, QSGMaterial* ) override
         {
             auto p = program();
 
@@ -163,30 +171,11 @@ namespace
 
             if ( state.isOpacityDirty() )
                 p->setUniformValue( m_opacityId, state.opacity() );
-
-            bool updateMaterial = ( oldMaterial == nullptr )
-                || newMaterial->compare( oldMaterial ) != 0;
-
-            updateMaterial |= state.isCachedMaterialDataDirty();
-
-            if ( updateMaterial )
-            {
-                auto material = static_cast< const Material* >( newMaterial );
-
-                p->setUniformValue( m_aspectRatioId, material->m_aspectRatio );
-                p->setUniformValue( m_blurExtentId, material->m_blurExtent);
-                p->setUniformValue( m_radiusId, material->m_radius );
-                p->setUniformValue( m_colorId, material->m_color );
-            }
         }
 
       private:
         int m_matrixId = -1;
         int m_opacityId = -1;
-        int m_aspectRatioId = -1;
-        int m_blurExtentId = -1;
-        int m_radiusId = -1;
-        int m_colorId = -1;
     };
 }
 
@@ -226,26 +215,17 @@ QSGMaterialType* Material::type() const
     return &staticType;
 }
 
-int Material::compare( const QSGMaterial* other ) const
+int Material::compare( const QSGMaterial* ) const
 {
-    auto material = static_cast< const Material* >( other );
-
-    if ( ( material->m_color == m_color )
-        && ( material->m_aspectRatio == m_aspectRatio )
-        && qFuzzyCompare(material->m_blurExtent, m_blurExtent)
-        && qFuzzyCompare(material->m_radius, m_radius) )
-    {
-        return 0;
-    }
-
-    return QSGMaterial::compare( other );
+    // all parameters are vertex attributes
+    return 0;
 }
 
 class QskBoxShadowNodePrivate final : public QSGGeometryNodePrivate
 {
   public:
     QskBoxShadowNodePrivate()
-        : geometry( QSGGeometry::defaultAttributes_TexturedPoint2D(), 4 )
+        : geometry( attributeSet(), 6 )
     {
     }
 
@@ -253,6 +233,7 @@ class QskBoxShadowNodePrivate final : public QSGGeometryNodePrivate
     Material material;
 
     QRectF rect;
+    QskHashValue hash = 0;
 };
 
 QskBoxShadowNode::QskBoxShadowNode()
@@ -260,6 +241,8 @@ QskBoxShadowNode::QskBoxShadowNode()
 {
     Q_D( QskBoxShadowNode );
 
+    d->geometry.setDrawingMode( QSGGeometry::DrawTriangles );
+
     setGeometry( &d->geometry );
     setMaterial( &d->material );
 }
@@ -274,72 +257,72 @@ void QskBoxShadowNode::setShadowData(
 {
     Q_D( QskBoxShadowNode );
 
-    if ( rect != d->rect )
-    {
-        d->rect = rect;
+    if ( blurRadius <= 0.0 )
+        blurRadius = 0.0;
 
-        QSGGeometry::updateTexturedRectGeometry(
-            &d->geometry, d->rect, QRectF( -0.5, -0.5, 1.0, 1.0 ) );
+    QskHashValue hash = shape.hash( 3496 );
+    hash = qHash( blurRadius, hash );
+    hash = qHash( color.rgba(), hash );
 
-        d->geometry.markVertexDataDirty();
-        markDirty( QSGNode::DirtyGeometry );
+    if ( ( rect == d->rect ) && ( hash == d->hash ) )
+        return;
 
-        QVector2D aspectRatio( 1.0, 1.0 );
+    d->rect = rect;
+    d->hash = hash;
+
+    Vertex vertex;
+
+    {
+        vertex.aspectRatio[0] = vertex.aspectRatio[1] = 1.0f;
 
         if ( rect.width() >= rect.height() )
-            aspectRatio.setX( rect.width() / rect.height() );
+            vertex.aspectRatio[0] = rect.width() / rect.height();
         else
-            aspectRatio.setY( rect.height() / rect.width() );
-
-        if ( d->material.m_aspectRatio != aspectRatio )
-        {
-            d->material.m_aspectRatio = aspectRatio;
-            markDirty( QSGNode::DirtyMaterial );
-        }
+            vertex.aspectRatio[1] = rect.height() / rect.width();
     }
 
     {
-        const float t = std::min( d->rect.width(), d->rect.height() );
-
-        const float r1 = shape.radius( Qt::BottomRightCorner ).width();
-        const float r2 = shape.radius( Qt::TopRightCorner ).width();
-        const float r3 = shape.radius( Qt::BottomLeftCorner ).width();
-        const float r4 = shape.radius( Qt::TopLeftCorner ).width();
+        const float t = std::min( rect.width(), rect.height() );
 
-        const auto uniformRadius = QVector4D(
-            std::min( r1 / t, 1.0f ), std::min( r2 / t, 1.0f ),
-            std::min( r3 / t, 1.0f ), std::min( r4 / t, 1.0f ) );
+        const Qt::Corner corners[] =
+            { Qt::BottomRightCorner, Qt::TopRightCorner, Qt::BottomLeftCorner, Qt::TopLeftCorner };
 
-        if ( d->material.m_radius != uniformRadius )
+        for ( int i = 0; i < 4; i++ )
         {
-            d->material.m_radius = uniformRadius;
-            markDirty( QSGNode::DirtyMaterial );
+            const float r = shape.radius( corners[i] ).width();
+            vertex.radius[i] = std::min( r / t, 1.0f );
         }
     }
 
     {
-        if ( blurRadius <= 0.0 )
-            blurRadius = 0.0;
+        const float t = 0.5 * std::min( rect.width(), rect.height() );
+        vertex.blurExtent = blurRadius / t;
+    }
 
-        const float t = 0.5 * std::min( d->rect.width(), d->rect.height() );
-        const float uniformExtent = blurRadius / t;
+    vertex.color = color;
 
-        if ( !qFuzzyCompare( d->material.m_blurExtent, uniformExtent ) )
-        {
-            d->material.m_blurExtent = uniformExtent;
-            markDirty( QSGNode::DirtyMaterial );
-        }
-    }
+    const QPointF points[] =
+    {
+        rect.topLeft(), rect.topRight(), rect.bottomLeft(),
+        rect.topRight(), rect.bottomRight(), rect.bottomLeft()
+    };
 
+    auto vertices = static_cast< Vertex* >( d->geometry.vertexData() );
+
+    for ( int i = 0; i < 6; i++ )
     {
-        const auto a = color.alphaF();
+        const auto& pos = points[i];
 
-        const QVector4D c( color.redF() * a, color.greenF() * a, color.blueF() * a, a );
+        vertex.x = pos.x();
+        vertex.y = pos.y();
 
-        if ( d->material.m_color != c )
-        {
-            d->material.m_color = c;
-            markDirty( QSGNode::DirtyMaterial );
-        }
+        // texture coordinates: [ -0.5, 0.5 ]
+        vertex.u = ( pos.x() == rect.left() ) ? -0.5f : 0.5f;
+        vertex.v = ( pos.y() == rect.top() ) ? -0.5f : 0.5f;
+
+        vertices[i] = vertex;
     }
+
+    d->geometry.markVertexDataDirty();
+    markDirty( QSGNode::DirtyGeometry );
 }
@@ -12,31 +12,99 @@ QSK_QT_PRIVATE_BEGIN
 QSK_QT_PRIVATE_END
 
 #include <qcoreapplication.h>
+#include <qhash.h>
+#include <qmutex.h>
+
+static constexpr int qskRowsPerPage = 32;
+
+/*
+    Ramps, that are not referenced by any material, are kept for being
+    reused, as long as their total cost does not exceed qskMaximumRampCount.
+    The cost is counted in units of 256 colors, what limits the memory
+    of the unreferenced ramps to 512KB ( 4 bytes per color ) for all
+    atlases together.
+
+    The rows of referenced ramps come on top, as well as the unused rows
+    of pages, that are not completely empty. Empty pages are deleted.
+ */
+static constexpr int qskMaximumRampCount = 512;
+
+static inline int qskRampWidth( const QskGradientStops& stops )
+{
+    /*
+        Qt creates tables of 1024 colors, while Chrome, Firefox, and Android
+        seem to use 256 colors only ( according to maybe outdated sources
+        from the internet ). We use 256 colors and increase it for
+        gradients with many stops.
+
+        To have pages with rows of the same width the widths are
+        rounded to 256, 512 or 1024.
+     */
+    const int count = 2 * stops.count();
+
+    int width = 256;
+    while ( width < count && width < 1024 )
+        width *= 2;
+
+    return width;
+}
+
+static inline int qskRampCost( int width )
+{
+    return width / 256;
+}
 
 namespace
 {
-    class Texture : public QSGPlainTexture
+    class Page : public QSGPlainTexture
     {
       public:
-        Texture( const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+        Page( int width, QskGradient::SpreadMode spreadMode )
+            : m_image( width, qskRowsPerPage, QImage::Format_RGBA8888_Premultiplied )
         {
-            /*
-                Qt creates tables of 1024 colors, while Chrome, Firefox, and Android
-                seem to use 256 colors only ( according to maybe outdated sources
-                from the internet ),
-             */
+            m_image.fill( Qt::transparent );
 
-            const int size = qBound( 256, 2 * stops.count(), 1024 );
-            setImage( QskRgb::colorTable( size, stops ) );
+            for ( int row = qskRowsPerPage - 1; row >= 0; row-- )
+                m_freeRows += row;
 
-            const auto wrapMode = this->wrapMode( spreadMode );
+            setImage( m_image );
 
-            setHorizontalWrapMode( wrapMode );
-            setVerticalWrapMode( wrapMode );
+            setHorizontalWrapMode( wrapMode( spreadMode ) );
+            setVerticalWrapMode( QSGTexture::ClampToEdge );
 
             setFiltering( QSGTexture::Linear );
         }
 
+        bool hasFreeRow() const
+        {
+            return !m_freeRows.isEmpty();
+        }
+
+        bool isEmpty() const
+        {
+            return m_freeRows.count() == qskRowsPerPage;
+        }
+
+        int allocateRow( const QskGradientStops& stops )
+        {
+            const int row = m_freeRows.takeLast();
+
+            const int width = m_image.width();
+
+            const auto table = QskRgb::colorTable( width, stops );
+            memcpy( m_image.scanLine( row ), table.constBits(), width * 4 );
+
+            // uploading the complete page, but it is small
+            setImage( m_image );
+
+            return row;
+        }
+
+        void releaseRow( int row )
+        {
+            m_freeRows += row;
+        }
+
       private:
         static inline QSGTexture::WrapMode wrapMode( QskGradient::SpreadMode spreadMode )
         {
@@ -52,6 +120,9 @@ namespace
                     return QSGTexture::ClampToEdge;
             }
         }
+
+        QImage m_image;
+        QVector< int > m_freeRows;
     };
 
     class HashKey
@@ -63,60 +134,226 @@ namespace
         }
 
         const void* rhi;
-        const QskGradientStops stops;
-        const QskGradient::SpreadMode spreadMode;
+        QskGradientStops stops;
+        QskGradient::SpreadMode spreadMode;
     };
 
-    inline size_t qHash( const HashKey& key, size_t seed = 0 )
+    inline QskHashValue qHash( const HashKey& key, QskHashValue seed = 0 )
     {
-        size_t values = seed + key.spreadMode;
+        auto hash = ::qHash( key.rhi, seed );
+        hash = ::qHash( static_cast< int >( key.spreadMode ), hash );
 
         for ( const auto& stop : key.stops )
-            values += stop.rgb();
+            hash = stop.hash( hash );
+
+        return hash;
+    }
+}
 
-        return values;
+class QskColorRamp::Ramp
+{
+  public:
+    Ramp( const HashKey& key, int cost )
+        : key( key )
+        , cost( cost )
+    {
     }
 
-    class Cache
+    const HashKey key;
+    const int cost;
+
+    Page* page = nullptr; // nullptr, when the RHI has been destroyed
+    int row = -1;
+
+    int refCount = 0;
+
+    // unreferenced ramps, the most recently released one first
+    Ramp* prev = nullptr;
+    Ramp* next = nullptr;
+};
+
+using Ramp = QskColorRamp::Ramp;
+
+namespace
+{
+    class Atlas
     {
       public:
-        ~Cache() { qDeleteAll( m_hashTable ); }
+        const void* rhi;
+        QskGradient::SpreadMode spreadMode;
+        int width;
 
-        void cleanupRhi( const QRhi* );
+        QVector< Page* > pages;
+    };
+
+    class Cache
+    {
+      public:
+        ~Cache();
 
-        Texture* texture( const void* rhi,
+        Ramp* acquire( const void* rhi,
             const QskGradientStops&, QskGradient::SpreadMode );
 
+        void release( Ramp* );
+
+        void cleanupRhi( const QRhi* );
+
       private:
-        QHash< HashKey, Texture* > m_hashTable;
+        Page* page( const void* rhi, QskGradient::SpreadMode, int width );
+        void releaseRow( Page*, int row );
+
+        void link( Ramp* );
+        void unlink( Ramp* );
+
+        QHash< HashKey, Ramp* > m_ramps;
+        QVector< Atlas > m_atlases;
+
+        Ramp* m_first = nullptr;
+        Ramp* m_last = nullptr;
+        int m_unreferencedCost = 0;
+
         QVector< const QRhi* > m_rhiTable; // no QSet: we usually have only one entry
     };
 
+    /*
+        The cache is shared between the render threads of all windows.
+        Each ramp and page belongs to the RHI of one thread, but the
+        hash table, the LRU list and the atlases are common and
+        have to be protected by s_mutex.
+     */
     static Cache* s_cache;
+    static QMutex s_mutex;
 }
 
 static void qskCleanupCache()
 {
+    QMutexLocker locker( &s_mutex );
+
     delete s_cache;
     s_cache = nullptr;
 }
 
 static void qskCleanupRhi( const QRhi* rhi )
 {
+    QMutexLocker locker( &s_mutex );
+
     if ( s_cache )
         s_cache->cleanupRhi( rhi );
 }
 
-Texture* Cache::texture( const void* rhi,
+Cache::~Cache()
+{
+    /*
+        Ramps, that are still referenced, are left behind. But
+        all materials should have been destroyed before.
+     */
+    qDeleteAll( m_ramps );
+
+    for ( const auto& atlas : std::as_const( m_atlases ) )
+        qDeleteAll( atlas.pages );
+}
+
+Page* Cache::page( const void* rhi,
+    QskGradient::SpreadMode spreadMode, int width )
+{
+    Atlas* atlas = nullptr;
+
+    for ( auto& a : m_atlases )
+    {
+        if ( a.rhi == rhi && a.spreadMode == spreadMode && a.width == width )
+        {
+            atlas = &a;
+            break;
+        }
+    }
+
+    if ( atlas == nullptr )
+    {
+        m_atlases += Atlas { rhi, spreadMode, width, {} };
+        atlas = &m_atlases.last();
+    }
+
+    for ( auto page : std::as_const( atlas->pages ) )
+    {
+        if ( page->hasFreeRow() )
+            return page;
+    }
+
+    auto page = new Page( width, spreadMode );
+    atlas->pages += page;
+
+    return page;
+}
+
+void Cache::releaseRow( Page* page, int row )
+{
+    page->releaseRow( row );
+
+    if ( !page->isEmpty() )
+        return;
+
+    for ( int i = 0; i < m_atlases.count(); i++ )
+    {
+        auto& pages = m_atlases[i].pages;
+
+        if ( pages.removeOne( page ) )
+        {
+            if ( pages.isEmpty() )
+                m_atlases.remove( i );
+
+            break;
+        }
+    }
+
+    delete page;
+}
+
+void Cache::link( Ramp* ramp )
+{
+    ramp->prev = nullptr;
+    ramp->next = m_first;
+
+    if ( m_first )
+        m_first->prev = ramp;
+    else
+        m_last = ramp;
+
+    m_first = ramp;
+    m_unreferencedCost += ramp->cost;
+}
+
+void Cache::unlink( Ramp* ramp )
+{
+    if ( ramp->prev )
+        ramp->prev->next = ramp->next;
+    else
+        m_first = ramp->next;
+
+    if ( ramp->next )
+        ramp->next->prev = ramp->prev;
+    else
+        m_last = ramp->prev;
+
+    ramp->prev = ramp->next = nullptr;
+    m_unreferencedCost -= ramp->cost;
+}
+
+Ramp* Cache::acquire( const void* rhi,
     const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
 {
     const HashKey key { rhi, stops, spreadMode };
 
-    auto texture = m_hashTable[key];
-    if ( texture == nullptr )
+    auto ramp = m_ramps.value( key );
+
+    if ( ramp == nullptr )
     {
-        texture = new Texture( stops, spreadMode );
-        m_hashTable[ key ] = texture;
+        const auto width = qskRampWidth( stops );
+
+        ramp = new Ramp( key, qskRampCost( width ) );
+        ramp->page = page( rhi, spreadMode, width );
+        ramp->row = ramp->page->allocateRow( stops );
+
+        m_ramps.insert( key, ramp );
 
         if ( rhi != nullptr )
         {
@@ -129,18 +366,64 @@ Texture* Cache::texture( const void* rhi,
             }
         }
     }
+    else if ( ramp->refCount == 0 )
+    {
+        unlink( ramp );
+    }
+
+    ramp->refCount++;
+    return ramp;
+}
+
+void Cache::release( Ramp* ramp )
+{
+    if ( --ramp->refCount > 0 )
+        return;
+
+    if ( ramp->page == nullptr )
+    {
+        // the RHI has already gone
+        delete ramp;
+        return;
+    }
+
+    link( ramp );
+
+    while ( m_unreferencedCost > qskMaximumRampCount )
+    {
+        // recycling the rows of the least recently released ramps
+
+        auto lru = m_last;
+        unlink( lru );
+
+        m_ramps.remove( lru->key );
+        releaseRow( lru->page, lru->row );
 
-    return texture;
+        delete lru;
+    }
 }
 
 void Cache::cleanupRhi( const QRhi* rhi )
 {
-    for ( auto it = m_hashTable.begin(); it != m_hashTable.end(); )
+    for ( auto it = m_ramps.begin(); it != m_ramps.end(); )
     {
-        if ( it.key().rhi == rhi )
+        auto ramp = it.value();
+
+        if ( ramp->key.rhi == rhi )
         {
-            delete it.value();
-            it = m_hashTable.erase( it );
+            it = m_ramps.erase( it );
+
+            if ( ramp->refCount == 0 )
+            {
+                unlink( ramp );
+                delete ramp;
+            }
+            else
+            {
+                // deleted, when being released
+                ramp->page = nullptr;
+                ramp->row = -1;
+            }
         }
         else
         {
@@ -148,12 +431,23 @@ void Cache::cleanupRhi( const QRhi* rhi )
         }
     }
 
+    for ( int i = m_atlases.count() - 1; i >= 0; i-- )
+    {
+        if ( m_atlases[i].rhi == rhi )
+        {
+            qDeleteAll( m_atlases[i].pages );
+            m_atlases.remove( i );
+        }
+    }
+
     m_rhiTable.removeAll( rhi );
 }
 
-QSGTexture* QskColorRamp::texture( const void* rhi,
+Ramp* QskColorRamp::acquire( const void* rhi,
     const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
 {
+    QMutexLocker locker( &s_mutex );
+
     if ( s_cache == nullptr )
     {
         s_cache = new Cache();
@@ -167,5 +461,42 @@ QSGTexture* QskColorRamp::texture( const void* rhi,
         qAddPostRoutine( qskCleanupCache );
     }
 
-    return s_cache->texture( rhi, stops, spreadMode );
+    return s_cache->acquire( rhi, stops, spreadMode );
+}
+
+void QskColorRamp::release( Ramp* ramp )
+{
+    if ( ramp == nullptr )
+        return;
+
+    QMutexLocker locker( &s_mutex );
+
+    if ( s_cache )
+        s_cache->release( ramp );
+}
+
+Ramp* QskColorRamp::update( Ramp* ramp, const void* rhi,
+    const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+{
+    if ( ramp && ramp->page && ramp->key.rhi == rhi
+        && ramp->key.spreadMode == spreadMode && ramp->key.stops == stops )
+    {
+        return ramp;
+    }
+
+    // acquiring first, so that a shared row does not get recycled
+    auto newRamp = acquire( rhi, stops, spreadMode );
+    release( ramp );
+
+    return newRamp;
+}
+
+QSGTexture* QskColorRamp::texture( const Ramp* ramp )
+{
+    return ramp->page;
+}
+
+float QskColorRamp::rowCoordinate( const Ramp* ramp )
+{
+    return ( ramp->row + 0.5f ) / qskRowsPerPage;
 }
@@ -11,10 +11,39 @@
 
 class QSGTexture;
 
+/*
+    Color ramps are stored as rows of atlas textures, that are shared
+    between all gradients with the same spread mode and a similar
+    number of stops ( rows of 256, 512 or 1024 colors ).
+
+    A ramp keeps its row as long as it is referenced by a material. Ramps
+    without references are kept for being reused, until exceeding the
+    limit of the cache. Then the rows of the least recently released
+    ramps are recycled.
+
+    The functions can be called from the render threads of different
+    windows, but a ramp must only be used by the thread that acquired it.
+ */
 namespace QskColorRamp
 {
-    QSGTexture* texture( const void* rhi,
+    class Ramp;
+
+    Ramp* acquire( const void* rhi,
+        const QskGradientStops&, QskGradient::SpreadMode );
+
+    void release( Ramp* );
+
+    /*
+        Returns ramp, when it matches the parameters. Otherwise
+        a matching ramp is acquired and ramp gets released.
+     */
+    Ramp* update( Ramp* ramp, const void* rhi,
         const QskGradientStops&, QskGradient::SpreadMode );
+
+    QSGTexture* texture( const Ramp* );
+
+    // vertical texture coordinate of the row
+    float rowCoordinate( const Ramp* );
 }
 
 #endif
@@ -12,6 +12,7 @@
 #include <qsgtexture.h>
 
 #include <cmath>
+#include <cstring>
 
 // RHI shaders are supported by Qt 5.15 and Qt 6.x
 #define SHADER_RHI
@@ -43,6 +44,19 @@ namespace
 #endif
         }
 
+        ~GradientMaterial() override
+        {
+            QskColorRamp::release( m_colorRamp );
+        }
+
+        QskColorRamp::Ramp* colorRamp( const void* rhi )
+        {
+            m_colorRamp = QskColorRamp::update(
+                m_colorRamp, rhi, stops(), spreadMode() );
+
+            return m_colorRamp;
+        }
+
         int compare( const QSGMaterial* other ) const override
         {
             const auto mat = static_cast< const GradientMaterial* >( other );
@@ -66,6 +80,10 @@ namespace
 #endif
 
         virtual bool setGradient( const QskGradient& ) = 0;
+
+      private:
+        // keeps the row of the ramp, as long as the material is alive
+        QskColorRamp::Ramp* m_colorRamp = nullptr;
     };
 
 #ifdef SHADER_GL
@@ -85,6 +103,7 @@ namespace
         {
             m_opacityId = program()->uniformLocation( "opacity" );
             m_matrixId = program()->uniformLocation( "matrix" );
+            m_rowCoordinateId = program()->uniformLocation( "rampCoordinate" );
         }
 
         void updateState( const RenderState& state,
@@ -101,9 +120,12 @@ namespace
 
             updateUniformValues( material );
 
-            auto texture = QskColorRamp::texture(
-                nullptr, material->stops(), material->spreadMode() );
-            texture->bind();
+            const auto ramp = material->colorRamp( nullptr );
+
+            p->setUniformValue( m_rowCoordinateId,
+                QskColorRamp::rowCoordinate( ramp ) );
+
+            QskColorRamp::texture( ramp )->bind();
         }
 
         char const* const* attributeNames() const override final
@@ -117,6 +139,7 @@ namespace
       protected:
         int m_opacityId = -1;
         int m_matrixId = -1;
+        int m_rowCoordinateId = -1;
     };
 #endif
 
@@ -132,16 +155,33 @@ namespace
             setShaderFileName( FragmentStage, root + name + ".frag.qsb" );
         }
 
+        bool updateRowCoordinate( RenderState& state,
+            GradientMaterial* newMaterial,
+            const GradientMaterial* oldMaterial, int offset )
+        {
+            const auto coordinate = QskColorRamp::rowCoordinate(
+                newMaterial->colorRamp( state.rhi() ) );
+
+            auto data = state.uniformData()->data() + offset;
+
+            if ( oldMaterial == nullptr || memcmp( data, &coordinate, 4 ) != 0 )
+            {
+                memcpy( data, &coordinate, 4 );
+                return true;
+            }
+
+            return false;
+        }
+
         void updateSampledImage( RenderState& state, int binding,
             QSGTexture* textures[], QSGMaterial* newMaterial, QSGMaterial* ) override final
         {
             if ( binding != 1 )
                 return;
 
-            auto material = static_cast< const GradientMaterial* >( newMaterial );
+            auto material = static_cast< GradientMaterial* >( newMaterial );
 
-            auto texture = QskColorRamp::texture(
-                state.rhi(), material->stops(), material->spreadMode() );
+            auto texture = QskColorRamp::texture( material->colorRamp( state.rhi() ) );
 
 #if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
             texture->updateRhiTexture( state.rhi(), state.resourceUpdateBatch() );
@@ -267,7 +307,7 @@ namespace
             auto matNew = static_cast< LinearMaterial* >( newMaterial );
             auto matOld = static_cast< LinearMaterial* >( oldMaterial );
 
-            Q_ASSERT( state.uniformData()->size() >= 84 );
+            Q_ASSERT( state.uniformData()->size() >= 88 );
 
             auto data = state.uniformData()->data();
             bool changed = false;
@@ -280,6 +320,8 @@ namespace
                 changed = true;
             }
 
+            changed |= updateRowCoordinate( state, matNew, matOld, 84 );
+
             if ( matOld == nullptr || matNew->m_gradientVector != matOld->m_gradientVector )
             {
                 memcpy( data + 64, &matNew->m_gradientVector, 16 );
@@ -427,7 +469,7 @@ namespace
             auto matNew = static_cast< RadialMaterial* >( newMaterial );
             auto matOld = static_cast< RadialMaterial* >( oldMaterial );
 
-            Q_ASSERT( state.uniformData()->size() >= 84 );
+            Q_ASSERT( state.uniformData()->size() >= 88 );
 
             auto data = state.uniformData()->data();
             bool changed = false;
@@ -440,6 +482,8 @@ namespace
                 changed = true;
             }
 
+            changed |= updateRowCoordinate( state, matNew, matOld, 84 );
+
             if ( matOld == nullptr || matNew->m_center != matOld->m_center )
             {
                 memcpy( data + 64, &matNew->m_center, 8 );
@@ -635,7 +679,7 @@ namespace
             auto matNew = static_cast< ConicMaterial* >( newMaterial );
             auto matOld = static_cast< ConicMaterial* >( oldMaterial );
 
-            Q_ASSERT( state.uniformData()->size() >= 88 );
+            Q_ASSERT( state.uniformData()->size() >= 92 );
 
             auto data = state.uniformData()->data();
             bool changed = false;
@@ -648,6 +692,8 @@ namespace
                 changed = true;
             }
 
+            changed |= updateRowCoordinate( state, matNew, matOld, 88 );
+
             if ( matOld == nullptr || matNew->m_center != matOld->m_center )
             {
                 memcpy( data + 64, &matNew->m_center, 8 );
@@ -20,6 +20,8 @@ namespace
 
 QskGraphicNode::QskGraphicNode()
 {
+    // graphics are often displayed many times: f.e icons of a list view
+    setTextureShared( true );
 }
 
 QskGraphicNode::~QskGraphicNode()
@@ -73,3 +75,18 @@ QskHashValue QskGraphicNode::hash( const void* nodeData ) const
 
     return graphic.hash( hash );
 }
+
+QVariant QskGraphicNode::content( const void* nodeData ) const
+{
+    const auto graphicData = reinterpret_cast< const GraphicData* >( nodeData );
+
+    /*
+        Comparing graphics is cheap, when they share their data,
+        what is the case for the icons we want to share textures for.
+     */
+    const QVariantList content = {
+        QVariant::fromValue( graphicData->graphic ),
+        QVariant::fromValue( graphicData->colorFilter ) };
+
+    return content;
+}
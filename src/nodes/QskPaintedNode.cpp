@@ -5,6 +5,7 @@
 
 #include "QskPaintedNode.h"
 #include "QskSGNode.h"
+#include "QskTextureCache.h"
 #include "QskTextureRenderer.h"
 
 #include <qsgimagenode.h>
@@ -49,6 +50,7 @@ QskPaintedNode::QskPaintedNode()
 
 QskPaintedNode::~QskPaintedNode()
 {
+    releaseSharedTexture();
 }
 
 void QskPaintedNode::setRenderHint( RenderHint renderHint )
@@ -80,6 +82,16 @@ Qt::Orientations QskPaintedNode::mirrored() const
     return m_mirrored;
 }
 
+void QskPaintedNode::setTextureShared( bool on )
+{
+    m_textureShared = on;
+}
+
+bool QskPaintedNode::isTextureShared() const
+{
+    return m_textureShared;
+}
+
 QSize QskPaintedNode::textureSize() const
 {
     if ( const auto imageNode = findImageNode( this ) )
@@ -110,9 +122,32 @@ void QskPaintedNode::update( QQuickWindow* window,
             delete imageNode;
         }
 
+        releaseSharedTexture();
+
         return;
     }
 
+    const auto newHash = hash( nodeData );
+
+    QVariant newContent;
+    if ( m_textureShared && ( newHash != 0 ) )
+        newContent = content( nodeData );
+
+    const bool isShared = newContent.isValid();
+
+    if ( imageNode && m_textureCacheId && !isShared )
+    {
+        /*
+            The image node refers to a texture of the cache, that must
+            not be modified. So we start over with a new node.
+         */
+        removeChildNode( imageNode );
+        delete imageNode;
+
+        imageNode = nullptr;
+        releaseSharedTexture();
+    }
+
     if ( imageNode == nullptr )
     {
         imageNode = window->createImageNode();
@@ -132,22 +167,46 @@ void QskPaintedNode::update( QQuickWindow* window,
         imageSize = scaledSize.toSize();
     }
 
-    bool isTextureDirty = false;
-
-    const auto newHash = hash( nodeData );
-    if ( ( newHash == 0 ) || ( newHash != m_hash ) )
+    if ( isShared )
     {
+        bool isTextureDirty = ( m_textureCacheId == 0 ) || ( newHash != m_hash )
+            || ( imageSize != m_sharedTextureSize ) || ( newContent != m_sharedContent );
+
+        if ( !isTextureDirty
+            && ( m_textureCacheGeneration != QskTextureCache::generation() ) )
+        {
+            /*
+                The cache of the window might have been replaced, when
+                the scene graph had been invalidated in the meantime.
+                Looking it up needs a lock, so we do it only after
+                some cache has been destroyed.
+             */
+            m_textureCacheGeneration = QskTextureCache::generation();
+            isTextureDirty = ( QskTextureCache::find( m_textureCacheId ) == nullptr );
+        }
+
+        if ( isTextureDirty )
+            updateSharedTexture( window, newHash, newContent, imageSize, nodeData );
+
         m_hash = newHash;
-        isTextureDirty = true;
     }
     else
     {
-        isTextureDirty = ( imageSize != textureSize() );
-    }
+        bool isTextureDirty = false;
 
+        if ( ( newHash == 0 ) || ( newHash != m_hash ) )
+        {
+            m_hash = newHash;
+            isTextureDirty = true;
+        }
+        else
+        {
+            isTextureDirty = ( imageSize != textureSize() );
+        }
 
-    if ( isTextureDirty )
-        updateTexture( window, imageSize, nodeData );
+        if ( isTextureDirty )
+            updateTexture( window, imageSize, nodeData );
+    }
 
     imageNode->setRect( rect );
     imageNode->setTextureCoordinatesTransform(
@@ -159,6 +218,13 @@ void QskPaintedNode::updateTexture( QQuickWindow* window,
 {
     auto imageNode = findImageNode( this );
 
+    if ( QskTextureRenderer::isAtlasCandidate( size ) )
+    {
+        // a new sub texture of the atlas, the previous one gets deleted
+        imageNode->setTexture( createTexture( window, size, nodeData ) );
+        return;
+    }
+
     if ( ( m_renderHint == OpenGL ) && QskTextureRenderer::isOpenGLWindow( window ) )
     {
         const auto textureId = createTextureGL( window, size, nodeData );
@@ -186,6 +252,83 @@ void QskPaintedNode::updateTexture( QQuickWindow* window,
     }
 }
 
+void QskPaintedNode::updateSharedTexture( QQuickWindow* window, QskHashValue hash,
+    const QVariant& content, const QSize& size, const void* nodeData )
+{
+    auto cache = QskTextureCache::instance( window );
+
+    auto texture = cache->acquireTexture( hash, size, content );
+    if ( texture == nullptr )
+    {
+        texture = createTexture( window, size, nodeData );
+        cache->insertTexture( hash, size, content, texture );
+    }
+
+    auto imageNode = findImageNode( this );
+
+    /*
+        Replacing the texture deletes a texture, that had been
+        owned by the node. Textures of the cache are released after
+        the node does not refer to them anymore.
+     */
+    imageNode->setTexture( texture );
+    imageNode->setOwnsTexture( false );
+
+    releaseSharedTexture();
+
+    m_textureCacheId = cache->id();
+    m_textureCacheGeneration = QskTextureCache::generation();
+    m_sharedTextureSize = size;
+    m_sharedContent = content;
+}
+
+void QskPaintedNode::releaseSharedTexture()
+{
+    if ( m_textureCacheId )
+    {
+        // a cache, that has been destroyed, has deleted its textures already
+
+        if ( auto cache = QskTextureCache::find( m_textureCacheId ) )
+            cache->releaseTexture( m_hash, m_sharedTextureSize, m_sharedContent );
+
+        m_textureCacheId = 0;
+        m_sharedTextureSize = QSize();
+        m_sharedContent = QVariant();
+    }
+}
+
+QVariant QskPaintedNode::content( const void* nodeData ) const
+{
+    Q_UNUSED( nodeData );
+    return QVariant();
+}
+
+QSGTexture* QskPaintedNode::createTexture(
+    QQuickWindow* window, const QSize& size, const void* nodeData )
+{
+    if ( QskTextureRenderer::isAtlasCandidate( size ) )
+    {
+        const auto image = createImage( window, size, nodeData );
+        return QskTextureRenderer::createAtlasTexture( window, image );
+    }
+
+    if ( ( m_renderHint == OpenGL ) && QskTextureRenderer::isOpenGLWindow( window ) )
+    {
+        const auto textureId = createTextureGL( window, size, nodeData );
+
+        auto texture = new QSGPlainTexture;
+        texture->setHasAlphaChannel( true );
+        texture->setOwnsTexture( true );
+
+        QskTextureRenderer::setTextureId( window, textureId, size, texture );
+
+        return texture;
+    }
+
+    const auto image = createImage( window, size, nodeData );
+    return window->createTextureFromImage( image );
+}
+
 QImage QskPaintedNode::createImage( QQuickWindow* window,
     const QSize& size, const void* nodeData )
 {
@@ -8,10 +8,12 @@
 
 #include "QskGlobal.h"
 #include <qsgnode.h>
+#include <qvariant.h>
 
 class QQuickWindow;
 class QPainter;
 class QImage;
+class QSGTexture;
 
 class QSK_EXPORT QskPaintedNode : public QSGNode
 {
@@ -25,7 +27,8 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
         with good quality and hardware accelerated performance. TODO ...
 
         OpenGL might be ignored depending on the backend used by the
-        application.
+        application. It is also ignored for small textures, that are
+        rasterized into the texture atlas of the scene graph.
      */
     enum RenderHint
     {
@@ -42,6 +45,15 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
     void setMirrored( Qt::Orientations );
     Qt::Orientations mirrored() const;
 
+    /*
+        When enabled, nodes with the same content and texture size
+        share their texture using the QskTextureCache of the window.
+        Sharing is never done for a hash value of '0' or when
+        content() returns an invalid QVariant.
+     */
+    void setTextureShared( bool );
+    bool isTextureShared() const;
+
     QRectF rect() const;
     QSize textureSize() const;
 
@@ -53,8 +65,20 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
     // a hash value of '0' always results in repainting
     virtual QskHashValue hash( const void* nodeData ) const = 0;
 
+    /*
+        An identity of the content, that can be compared to find out
+        if a shared texture has been created for the same content or
+        only for content with the same hash value.
+     */
+    virtual QVariant content( const void* nodeData ) const;
+
   private:
     void updateTexture( QQuickWindow*, const QSize&, const void* nodeData );
+    void updateSharedTexture( QQuickWindow*, QskHashValue,
+        const QVariant& content, const QSize&, const void* nodeData );
+    void releaseSharedTexture();
+
+    QSGTexture* createTexture( QQuickWindow*, const QSize&, const void* nodeData );
 
     QImage createImage( QQuickWindow*, const QSize&, const void* nodeData );
     quint32 createTextureGL( QQuickWindow*, const QSize&, const void* nodeData );
@@ -62,6 +86,12 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
     RenderHint m_renderHint = OpenGL;
     Qt::Orientations m_mirrored;
     QskHashValue m_hash = 0;
+
+    bool m_textureShared = false;
+    quint64 m_textureCacheId = 0; // != 0 for shared textures
+    quint64 m_textureCacheGeneration = 0;
+    QSize m_sharedTextureSize;
+    QVariant m_sharedContent;
 };
 
 #endif
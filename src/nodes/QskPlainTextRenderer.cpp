@@ -7,9 +7,15 @@
 #include "QskTextColors.h"
 #include "QskTextOptions.h"
 
+#include <qcache.h>
+#include <qcoreapplication.h>
 #include <qfontmetrics.h>
+#include <qglyphrun.h>
 #include <qmath.h>
+#include <qmutex.h>
 #include <qsgnode.h>
+#include <qthread.h>
+#include <qthreadstorage.h>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
@@ -17,6 +23,131 @@ QSK_QT_PRIVATE_END
 
 #define GlyphFlag static_cast< QSGNode::Flag >( 0x800 )
 
+namespace
+{
+    /*
+        Shaping text is expensive and labels are often updated with
+        the same text or share it with other labels ( f.e. in list views ).
+        So we keep the results of the most recent calculations, both
+        for the size hints ( GUI thread ) and for the glyph runs of the
+        nodes ( render thread ).
+
+        A QGlyphRun holds a QRawFont, that is bound to the thread,
+        where it has been created. So the glyph runs can't be shared
+        with the GUI thread or between the render threads of different
+        windows and are cached for each thread.
+     */
+    class TextKey
+    {
+      public:
+        inline bool operator==( const TextKey& other ) const
+        {
+            return ( text == other.text ) && ( font == other.font )
+                && ( options == other.options ) && ( alignment == other.alignment )
+                && ( size == other.size );
+        }
+
+        QString text;
+        QFont font;
+        QskTextOptions options;
+        int alignment;
+        QSizeF size;
+    };
+
+    inline QskHashValue qHash( const TextKey& key, QskHashValue seed = 0 )
+    {
+        auto hash = ::qHash( key.text, seed );
+        hash = ::qHash( key.font, hash );
+        hash = key.options.hash( hash );
+        hash = ::qHash( key.alignment, hash );
+        hash = ::qHash( key.size.width(), hash );
+        return ::qHash( key.size.height(), hash );
+    }
+
+    class TextLayout
+    {
+      public:
+        QList< QGlyphRun > glyphRuns;
+        qreal textHeight = 0.0;
+        qreal boundingHeight = 0.0;
+    };
+
+    class TextRectCache
+    {
+      public:
+        TextRectCache()
+        {
+            m_cache.setMaxCost( 500 );
+        }
+
+        bool find( const TextKey& key, QRectF& rect )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            if ( auto cachedRect = m_cache.object( key ) )
+            {
+                rect = *cachedRect;
+                return true;
+            }
+
+            return false;
+        }
+
+        void insert( const TextKey& key, const QRectF& rect )
+        {
+            QMutexLocker locker( &m_mutex );
+            m_cache.insert( key, new QRectF( rect ) );
+        }
+
+      private:
+        QMutex m_mutex;
+        QCache< TextKey, QRectF > m_cache;
+    };
+
+    class TextLayoutCache : public QCache< TextKey, TextLayout >
+    {
+      public:
+        TextLayoutCache()
+        {
+            setMaxCost( 200 );
+        }
+    };
+
+    using TextLayoutStorage = QThreadStorage< TextLayoutCache* >;
+}
+
+Q_GLOBAL_STATIC( TextRectCache, qskTextRectCache )
+Q_GLOBAL_STATIC( TextLayoutStorage, qskTextLayoutStorage )
+
+static void qskCleanupTextLayoutCache()
+{
+    /*
+        The caches of other threads are deleted, when the thread
+        terminates. The one of the GUI thread ( non threaded render loops )
+        has to be deleted, before the fonts are gone.
+     */
+    if ( qskTextLayoutStorage.exists() && qskTextLayoutStorage->hasLocalData() )
+        qskTextLayoutStorage->setLocalData( nullptr );
+}
+
+static TextLayoutCache* qskTextLayoutCache()
+{
+    auto storage = qskTextLayoutStorage();
+
+    if ( !storage->hasLocalData() )
+    {
+        if ( QCoreApplication::instance()
+            && QThread::currentThread() == QCoreApplication::instance()->thread() )
+        {
+            qAddPostRoutine( qskCleanupTextLayoutCache );
+        }
+
+        storage->setLocalData( new TextLayoutCache() );
+    }
+
+    return storage->localData();
+}
+
 QSizeF QskPlainTextRenderer::textSize(
     const QString& text, const QFont& font, const QskTextOptions& options )
 {
@@ -28,10 +159,20 @@ QRectF QskPlainTextRenderer::textRect(
     const QString& text, const QFont& font, const QskTextOptions& options,
     const QSizeF& size )
 {
-    const QFontMetricsF fm( font );
-    const QRectF r( 0, 0, size.width(), size.height() );
+    const TextKey key { text, font, options, 0, size };
+
+    QRectF rect;
 
-    return fm.boundingRect( r, options.textFlags(), text );
+    if ( !qskTextRectCache->find( key, rect ) )
+    {
+        const QFontMetricsF fm( font );
+        const QRectF r( 0, 0, size.width(), size.height() );
+
+        rect = fm.boundingRect( r, options.textFlags(), text );
+        qskTextRectCache->insert( key, rect );
+    }
+
+    return rect;
 }
 
 static qreal qskLayoutText( QTextLayout* layout,
@@ -95,7 +236,7 @@ static qreal qskLayoutText( QTextLayout* layout,
 }
 
 static void qskRenderText(
-    QQuickItem* item, QSGNode* parentNode, const QTextLayout& layout, qreal baseLine,
+    QQuickItem* item, QSGNode* parentNode, const QList< QGlyphRun >& glyphRuns, qreal baseLine,
     const QColor& color, QQuickText::TextStyle style, const QColor& styleColor )
 {
     auto renderContext = QQuickItemPrivate::get(item)->sceneGraphRenderContext();
@@ -118,49 +259,44 @@ static void qskRenderText(
 
     const QPointF position( 0, baseLine );
 
-    for ( int i = 0; i < layout.lineCount(); ++i )
+    for ( const auto& glyphRun : glyphRuns )
     {
-        const auto glyphRuns = layout.lineAt( i ).glyphRuns();
-
-        for ( const auto& glyphRun : glyphRuns )
+        if ( glyphNode == nullptr )
         {
-            if ( glyphNode == nullptr )
-            {
-                const bool preferNativeGlyphNode = false; // QskTextOptions?
-                constexpr int renderQuality = -1; // QQuickText::DefaultRenderTypeQuality
+            const bool preferNativeGlyphNode = false; // QskTextOptions?
+            constexpr int renderQuality = -1; // QQuickText::DefaultRenderTypeQuality
 
 #if QT_VERSION >= QT_VERSION_CHECK( 6, 7, 0 )
-                const auto renderType = preferNativeGlyphNode
-                    ? QSGTextNode::QtRendering : QSGTextNode::NativeRendering;
-                glyphNode = sgContext->createGlyphNode(
-                    renderContext, renderType, renderQuality );
+            const auto renderType = preferNativeGlyphNode
+                ? QSGTextNode::QtRendering : QSGTextNode::NativeRendering;
+            glyphNode = sgContext->createGlyphNode(
+                renderContext, renderType, renderQuality );
 #elif QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
-                glyphNode = sgContext->createGlyphNode(
-                    renderContext, preferNativeGlyphNode, renderQuality );
+            glyphNode = sgContext->createGlyphNode(
+                renderContext, preferNativeGlyphNode, renderQuality );
 #else
-                Q_UNUSED( renderQuality );
-                glyphNode = sgContext->createGlyphNode(
-                    renderContext, preferNativeGlyphNode );
+            Q_UNUSED( renderQuality );
+            glyphNode = sgContext->createGlyphNode(
+                renderContext, preferNativeGlyphNode );
 #endif
 
 #if QT_VERSION < QT_VERSION_CHECK( 6, 7, 0 )
-                glyphNode->setOwnerElement( item );
+            glyphNode->setOwnerElement( item );
 #endif
 
-                glyphNode->setFlags( QSGNode::OwnedByParent | GlyphFlag );
-            }
+            glyphNode->setFlags( QSGNode::OwnedByParent | GlyphFlag );
+        }
 
-            glyphNode->setStyle( style );
-            glyphNode->setColor( color );
-            glyphNode->setStyleColor( styleColor );
-            glyphNode->setGlyphs( position, glyphRun );
-            glyphNode->update();
+        glyphNode->setStyle( style );
+        glyphNode->setColor( color );
+        glyphNode->setStyleColor( styleColor );
+        glyphNode->setGlyphs( position, glyphRun );
+        glyphNode->update();
 
-            if ( glyphNode->parent() != parentNode )
-                parentNode->appendChildNode( glyphNode );
+        if ( glyphNode->parent() != parentNode )
+            parentNode->appendChildNode( glyphNode );
 
-            glyphNode = static_cast< QSGGlyphNode* >( glyphNode->nextSibling() );
-        }
+        glyphNode = static_cast< QSGGlyphNode* >( glyphNode->nextSibling() );
     }
 
     // Remove leftover glyphs
@@ -176,11 +312,8 @@ static void qskRenderText(
     }
 }
 
-void QskPlainTextRenderer::updateNode( const QString& text,
-    const QFont& font, const QskTextOptions& options,
-    Qsk::TextStyle style, const QskTextColors& colors,
-    Qt::Alignment alignment, const QRectF& rect,
-    const QQuickItem* item, QSGTransformNode* node )
+static TextLayout qskTextLayout( const QString& text, const QFont& font,
+    const QskTextOptions& options, Qt::Alignment alignment, qreal lineWidth )
 {
     QTextOption textOption( alignment );
     textOption.setWrapMode( static_cast< QTextOption::WrapMode >( options.wrapMode() ) );
@@ -209,10 +342,44 @@ void QskPlainTextRenderer::updateNode( const QString& text,
     layout.setTextOption( textOption );
     layout.setText( tmp );
 
+    TextLayout textLayout;
+
     layout.beginLayout();
-    const qreal textHeight = qskLayoutText( &layout, rect.width(), options );
+    textLayout.textHeight = qskLayoutText( &layout, lineWidth, options );
     layout.endLayout();
 
+    textLayout.boundingHeight = layout.boundingRect().height();
+
+    for ( int i = 0; i < layout.lineCount(); ++i )
+        textLayout.glyphRuns += layout.lineAt( i ).glyphRuns();
+
+    return textLayout;
+}
+
+void QskPlainTextRenderer::updateNode( const QString& text,
+    const QFont& font, const QskTextOptions& options,
+    Qsk::TextStyle style, const QskTextColors& colors,
+    Qt::Alignment alignment, const QRectF& rect,
+    const QQuickItem* item, QSGTransformNode* node )
+{
+    // the layout does not depend on the height of rect
+    const TextKey key { text, font, options,
+        static_cast< int >( alignment ), QSizeF( rect.width(), 0.0 ) };
+
+    auto cache = qskTextLayoutCache();
+
+    auto layout = cache->object( key );
+    if ( layout == nullptr )
+    {
+        layout = new TextLayout(
+            qskTextLayout( text, font, options, alignment, rect.width() ) );
+
+        // with a cost of 1 the layout is never rejected
+        cache->insert( key, layout );
+    }
+
+    const qreal textHeight = layout->textHeight;
+
     const qreal y0 = QFontMetricsF( font ).ascent();
 
     qreal yBaseline = y0;
@@ -234,12 +401,12 @@ void QskPlainTextRenderer::updateNode( const QString& text,
             between margins/paddings.
          */
 
-        const int bh = int( layout.boundingRect().height() );
+        const int bh = int( layout->boundingHeight );
         yBaseline = ( bh % 2 ) ? qFloor( yBaseline ) : qCeil( yBaseline );
     }
 
     qskRenderText(
-        const_cast< QQuickItem* >( item ), node, layout, yBaseline,
+        const_cast< QQuickItem* >( item ), node, layout->glyphRuns, yBaseline,
         colors.textColor, static_cast< QQuickText::TextStyle >( style ),
         colors.styleColor );
 }
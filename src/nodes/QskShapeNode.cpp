@@ -7,52 +7,40 @@
 #include "QskGradient.h"
 #include "QskGradientDirection.h"
 #include "QskFillNodePrivate.h"
+#include "QskTessellationCache.h"
 
-QSK_QT_PRIVATE_BEGIN
-#include <private/qvectorpath_p.h>
-#include <private/qtriangulator_p.h>
-QSK_QT_PRIVATE_END
+#include <qpainterpath.h>
+#include <qtransform.h>
 
 static void qskUpdateGeometry( const QPainterPath& path,
     const QTransform& transform, QSGGeometry& geometry )
 {
-    const auto ts = qTriangulate( path, transform, 1, false );
-
-#if 1
-    geometry.allocate( ts.vertices.size(), ts.indices.size() );
-
-    auto vertexData = reinterpret_cast< float* >( geometry.vertexData() );
-    const auto points = ts.vertices.constData();
-
-    for ( int i = 0; i < ts.vertices.count(); i++ )
-        vertexData[i] = points[i];
-
-    memcpy( geometry.indexData(), ts.indices.data(),
-        ts.indices.size() * sizeof( quint16 ) );
-#else
     /*
-        As we have to iterate over the vertex buffer to copy qreal to float
-        anyway we could reorder according to the index buffer and drop
-        the index buffer then ???
+        Identical shapes are often displayed in several items, or the
+        same shape is set again. So we try to find the triangles in
+        the cache, before running the triangulator.
+     */
+    const auto triangles = QskTessellationCache::fillTriangles( path, transform );
 
-        QTriangleSet:
+    const auto& vertices = triangles.vertices;
+    const auto& indices = triangles.indices;
 
-        vertices: (x[i[n]], y[i[n]]), (x[j[n]], y[j[n]]), (x[k[n]], y[k[n]]), n = 0, 1, ...
-        QVector<qreal> vertices; // [x[0], y[0], x[1], y[1], x[2], ...]
-        QVector<quint16> indices; // [i[0], j[0], k[0], i[1], j[1], k[1], i[2], ...]
-     */
-    const auto points = ts.vertices.constData();
-    const auto indices = reinterpret_cast< const quint16* >( ts.indices.data() );
+    geometry.allocate( vertices.size() / 2, indices.size() );
 
-    geometry.allocate( ts.indices.size() );
+    const auto dx = static_cast< float >( transform.dx() );
+    const auto dy = static_cast< float >( transform.dy() );
 
-    auto vertexData = geometry.vertexDataAsPoint2D();
-    for ( int i = 0; i < ts.indices.size(); i++ )
+    auto vertexData = reinterpret_cast< float* >( geometry.vertexData() );
+    const auto points = vertices.constData();
+
+    for ( int i = 0; i < vertices.count(); i += 2 )
     {
-        const int j = 2 * indices[i];
-        vertexData[i].set( points[j], points[j + 1] );
+        vertexData[i] = points[i] + dx;
+        vertexData[i + 1] = points[i + 1] + dy;
     }
-#endif
+
+    memcpy( geometry.indexData(), indices.constData(),
+        indices.size() * sizeof( quint16 ) );
 }
 
 class QskShapeNodePrivate final : public QskFillNodePrivate
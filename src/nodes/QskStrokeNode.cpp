@@ -6,12 +6,10 @@
 #include "QskStrokeNode.h"
 #include "QskVertex.h"
 #include "QskGradient.h"
+#include "QskTessellationCache.h"
 
 #include <qpainterpath.h>
-
-QSK_QT_PRIVATE_BEGIN
-#include <private/qtriangulatingstroker_p.h>
-QSK_QT_PRIVATE_END
+#include <qpen.h>
 
 static inline bool qskIsPenVisible( const QPen& pen )
 {
@@ -65,68 +63,42 @@ void QskStrokeNode::updateNode(
 
     if ( true ) // For the moment we always update the geometry. TODO ...
     {
-        /*
-            Unfortunately QTriangulatingStroker does not offer on the fly
-            transformations - like with qTriangulate. TODO ...
-         */
-        const auto scaledPath = transform.map( path );
-
-        auto effectivePen = pen;
-
-        if ( !effectivePen.isCosmetic() )
-        {
-            const auto scaleFactor = qMin( transform.m11(), transform.m22() );
-            if ( scaleFactor != 1.0 )
-            {
-                effectivePen.setWidth( effectivePen.widthF() * scaleFactor );
-                effectivePen.setCosmetic( false );
-            }
-        }
-
-        QTriangulatingStroker stroker;
-
-        if ( pen.style() == Qt::SolidLine )
-        {
-            // clipRect, renderHint are ignored in QTriangulatingStroker::process
-            stroker.process( qtVectorPathForPath( scaledPath ), effectivePen, {}, {} );
-        }
-        else
-        {
-            constexpr QRectF clipRect; // empty rect: no clipping
-
-            QDashedStrokeProcessor dashStroker;
-            dashStroker.process( qtVectorPathForPath( scaledPath ),
-                effectivePen, clipRect, {} );
+        // stroking identical paths again is avoided by the cache
+        const auto vertices =
+            QskTessellationCache::strokeTriangleStrip( path, transform, pen );
 
-            const QVectorPath dashedVectorPath( dashStroker.points(),
-                dashStroker.elementCount(), dashStroker.elementTypes(), 0 );
-
-            stroker.process( dashedVectorPath, effectivePen, {}, {} );
-        }
+        const auto dx = static_cast< float >( transform.dx() );
+        const auto dy = static_cast< float >( transform.dy() );
 
         auto& geometry = *this->geometry();
 
         // 2 vertices for each point
         geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
-        geometry.allocate( stroker.vertexCount() / 2 );
+        geometry.allocate( vertices.count() / 2 );
+
+        const auto v = vertices.constData();
 
         if ( isGeometryColored() )
         {
             const QskVertex::Color c( pen.color() );
 
-            const auto v = stroker.vertices();
             auto points = geometry.vertexDataAsColoredPoint2D();
 
             for ( int i = 0; i < geometry.vertexCount(); i++ )
             {
                 const auto j = 2 * i;
-                points[i].set( v[j], v[j + 1], c.r, c.g, c.b, c.a );
+                points[i].set( v[j] + dx, v[j + 1] + dy, c.r, c.g, c.b, c.a );
             }
         }
         else
         {
-            memcpy( geometry.vertexData(), stroker.vertices(),
-                stroker.vertexCount() * sizeof( float ) );
+            auto points = geometry.vertexDataAsPoint2D();
+
+            for ( int i = 0; i < geometry.vertexCount(); i++ )
+            {
+                const auto j = 2 * i;
+                points[i].set( v[j] + dx, v[j + 1] + dy );
+            }
         }
 
         geometry.markVertexDataDirty();
@@ -0,0 +1,289 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskTessellationCache.h"
+
+#include <qcache.h>
+#include <qmutex.h>
+#include <qpainterpath.h>
+#include <qpen.h>
+#include <qtransform.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qvectorpath_p.h>
+#include <private/qtriangulator_p.h>
+#include <private/qtriangulatingstroker_p.h>
+QSK_QT_PRIVATE_END
+
+static int qskMaximumCost = 4 * 1024 * 1024;
+
+static inline QTransform qskUntranslated( const QTransform& transform )
+{
+    // p -> transform( p ) - ( dx, dy ), what is also correct for projections
+    return transform * QTransform::fromTranslate( -transform.dx(), -transform.dy() );
+}
+
+static inline QPen qskGeometryPen( const QPen& pen )
+{
+    // the color of the pen has no effect on the geometry
+    QPen geometryPen = pen;
+    geometryPen.setBrush( Qt::black );
+
+    return geometryPen;
+}
+
+static QskHashValue qskPathHash( const QPainterPath& path, QskHashValue seed )
+{
+    auto hash = qHash( static_cast< int >( path.fillRule() ), seed );
+
+    for ( int i = 0; i < path.elementCount(); i++ )
+    {
+        const auto element = path.elementAt( i );
+
+        hash = qHash( static_cast< int >( element.type ), hash );
+        hash = qHash( element.x, hash );
+        hash = qHash( element.y, hash );
+    }
+
+    return hash;
+}
+
+static QskHashValue qskTransformHash( const QTransform& transform, QskHashValue seed )
+{
+    auto hash = qHash( transform.m11(), seed );
+    hash = qHash( transform.m12(), hash );
+    hash = qHash( transform.m13(), hash );
+    hash = qHash( transform.m21(), hash );
+    hash = qHash( transform.m22(), hash );
+    hash = qHash( transform.m23(), hash );
+    hash = qHash( transform.m31(), hash );
+    hash = qHash( transform.m32(), hash );
+
+    return qHash( transform.m33(), hash );
+}
+
+static QskHashValue qskPenHash( const QPen& pen, QskHashValue seed )
+{
+    auto hash = qHash( pen.widthF(), seed );
+    hash = qHash( static_cast< int >( pen.style() ), hash );
+    hash = qHash( static_cast< int >( pen.capStyle() ), hash );
+    hash = qHash( static_cast< int >( pen.joinStyle() ), hash );
+    hash = qHash( pen.miterLimit(), hash );
+    hash = qHash( pen.isCosmetic(), hash );
+
+    if ( pen.style() != Qt::SolidLine )
+    {
+        hash = qHash( pen.dashOffset(), hash );
+        hash = qHash( pen.dashPattern(), hash );
+    }
+
+    return hash;
+}
+
+namespace
+{
+    class Key
+    {
+      public:
+        Key( const QPainterPath& path, const QTransform& transform )
+            : path( path )
+            , transform( transform )
+        {
+            hash = qskPathHash( path, 0 );
+            hash = qskTransformHash( transform, hash );
+        }
+
+        Key( const QPainterPath& path, const QTransform& transform, const QPen& pen )
+            : Key( path, transform )
+        {
+            isStroke = true;
+
+            this->pen = pen;
+            hash = qskPenHash( pen, hash );
+        }
+
+        inline bool operator==( const Key& other ) const
+        {
+            return ( hash == other.hash ) && ( isStroke == other.isStroke )
+                && ( transform == other.transform ) && ( pen == other.pen )
+                && ( path == other.path );
+        }
+
+        QPainterPath path;
+        QTransform transform;
+        QPen pen;
+
+        bool isStroke = false;
+        QskHashValue hash;
+    };
+
+    inline QskHashValue qHash( const Key& key, QskHashValue seed = 0 )
+    {
+        return key.hash ^ seed;
+    }
+
+    class Cache
+    {
+      public:
+        Cache()
+        {
+            m_cache.setMaxCost( qskMaximumCost );
+        }
+
+        bool find( const Key& key, QskTessellationCache::Triangles& triangles )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            if ( auto cachedTriangles = m_cache.object( key ) )
+            {
+                triangles = *cachedTriangles;
+                return true;
+            }
+
+            return false;
+        }
+
+        void insert( const Key& key, const QskTessellationCache::Triangles& triangles )
+        {
+            const int cost = triangles.vertices.size() * sizeof( float )
+                + triangles.indices.size() * sizeof( quint16 );
+
+            QMutexLocker locker( &m_mutex );
+            m_cache.insert( key, new QskTessellationCache::Triangles( triangles ), cost );
+        }
+
+        void setMaxCost( int cost )
+        {
+            QMutexLocker locker( &m_mutex );
+            m_cache.setMaxCost( cost );
+        }
+
+      private:
+        QMutex m_mutex;
+        QCache< Key, QskTessellationCache::Triangles > m_cache;
+    };
+}
+
+Q_GLOBAL_STATIC( Cache, qskTessellationCache )
+
+static QskTessellationCache::Triangles qskTriangulate(
+    const QPainterPath& path, const QTransform& transform )
+{
+    const auto ts = qTriangulate( path, transform, 1, false );
+
+    QskTessellationCache::Triangles triangles;
+
+    triangles.vertices.resize( ts.vertices.size() );
+
+    auto vertexData = triangles.vertices.data();
+    const auto points = ts.vertices.constData();
+
+    for ( int i = 0; i < ts.vertices.count(); i++ )
+        vertexData[i] = points[i];
+
+    triangles.indices.resize( ts.indices.size() );
+
+    memcpy( triangles.indices.data(), ts.indices.data(),
+        ts.indices.size() * sizeof( quint16 ) );
+
+    return triangles;
+}
+
+static QVector< float > qskStroke( const QPainterPath& path,
+    const QTransform& transform, const QPen& pen )
+{
+    /*
+        Unfortunately QTriangulatingStroker does not offer on the fly
+        transformations - like with qTriangulate. TODO ...
+     */
+    const auto scaledPath = transform.map( path );
+
+    auto effectivePen = pen;
+
+    if ( !effectivePen.isCosmetic() )
+    {
+        const auto scaleFactor = qMin( transform.m11(), transform.m22() );
+        if ( scaleFactor != 1.0 )
+        {
+            effectivePen.setWidth( effectivePen.widthF() * scaleFactor );
+            effectivePen.setCosmetic( false );
+        }
+    }
+
+    QTriangulatingStroker stroker;
+
+    if ( pen.style() == Qt::SolidLine )
+    {
+        // clipRect, renderHint are ignored in QTriangulatingStroker::process
+        stroker.process( qtVectorPathForPath( scaledPath ), effectivePen, {}, {} );
+    }
+    else
+    {
+        constexpr QRectF clipRect; // empty rect: no clipping
+
+        QDashedStrokeProcessor dashStroker;
+        dashStroker.process( qtVectorPathForPath( scaledPath ),
+            effectivePen, clipRect, {} );
+
+        const QVectorPath dashedVectorPath( dashStroker.points(),
+            dashStroker.elementCount(), dashStroker.elementTypes(), 0 );
+
+        stroker.process( dashedVectorPath, effectivePen, {}, {} );
+    }
+
+    QVector< float > vertices( stroker.vertexCount() );
+    memcpy( vertices.data(), stroker.vertices(), stroker.vertexCount() * sizeof( float ) );
+
+    return vertices;
+}
+
+QskTessellationCache::Triangles QskTessellationCache::fillTriangles(
+    const QPainterPath& path, const QTransform& transform )
+{
+    const auto t = qskUntranslated( transform );
+    const Key key( path, t );
+
+    Triangles triangles;
+
+    if ( !qskTessellationCache->find( key, triangles ) )
+    {
+        triangles = qskTriangulate( path, t );
+        qskTessellationCache->insert( key, triangles );
+    }
+
+    return triangles;
+}
+
+QVector< float > QskTessellationCache::strokeTriangleStrip(
+    const QPainterPath& path, const QTransform& transform, const QPen& pen )
+{
+    const auto t = qskUntranslated( transform );
+    const auto geometryPen = qskGeometryPen( pen );
+
+    const Key key( path, t, geometryPen );
+
+    Triangles triangles;
+
+    if ( !qskTessellationCache->find( key, triangles ) )
+    {
+        triangles.vertices = qskStroke( path, t, geometryPen );
+        qskTessellationCache->insert( key, triangles );
+    }
+
+    return triangles.vertices;
+}
+
+void QskTessellationCache::setMaximumCost( int cost )
+{
+    qskMaximumCost = qMax( cost, 0 );
+
+    if ( qskTessellationCache.exists() )
+        qskTessellationCache->setMaxCost( qskMaximumCost );
+}
+
+int QskTessellationCache::maximumCost()
+{
+    return qskMaximumCost;
+}
@@ -0,0 +1,49 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_TESSELLATION_CACHE_H
+#define QSK_TESSELLATION_CACHE_H
+
+#include "QskGlobal.h"
+#include <qvector.h>
+
+class QPainterPath;
+class QTransform;
+class QPen;
+
+/*
+    A process wide cache for the results of triangulating/stroking
+    paths, so that identical shapes - f.e. markers, thumbnails or icons
+    in many items - are tessellated only once.
+
+    The translation of the transformation has no effect on the
+    tessellation. So the results are calculated without it and
+    the caller has to translate the vertices when copying them
+    into the geometry.
+
+    The cache is thread safe and limited by the memory being
+    occupied by the vertices/indices.
+ */
+namespace QskTessellationCache
+{
+    class Triangles
+    {
+      public:
+        QVector< float > vertices; // x/y pairs
+        QVector< quint16 > indices; // triangles
+    };
+
+    QSK_EXPORT Triangles fillTriangles( const QPainterPath&, const QTransform& );
+
+    // x/y pairs for QSGGeometry::DrawTriangleStrip
+    QSK_EXPORT QVector< float > strokeTriangleStrip(
+        const QPainterPath&, const QTransform&, const QPen& );
+
+    // bytes
+    QSK_EXPORT void setMaximumCost( int );
+    QSK_EXPORT int maximumCost();
+}
+
+#endif
@@ -0,0 +1,294 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskTextureCache.h"
+
+#include <qcache.h>
+#include <qhash.h>
+#include <qmutex.h>
+#include <qquickwindow.h>
+#include <qsgtexture.h>
+#include <qvariant.h>
+
+#include <atomic>
+#include <limits>
+
+// written from the GUI thread, read from the render threads
+static std::atomic< qint64 > qskMaximumCost { 16 * 1024 * 1024 };
+
+// checked by the nodes without locking the table of the caches
+static std::atomic< quint64 > qskGeneration { 0 };
+
+namespace
+{
+    class Key
+    {
+      public:
+        inline bool operator==( const Key& other ) const
+        {
+            // comparing the content is usually cheap for shared data
+            return ( hash == other.hash ) && ( size == other.size )
+                && ( content == other.content );
+        }
+
+        QskHashValue hash;
+        QSize size;
+        QVariant content;
+    };
+
+    inline QskHashValue qHash( const Key& key, QskHashValue seed = 0 )
+    {
+        seed = ::qHash( key.hash, seed );
+        seed = ::qHash( key.size.width(), seed );
+        return ::qHash( key.size.height(), seed );
+    }
+
+    class Entry
+    {
+      public:
+        QSGTexture* texture = nullptr;
+        int refCount = 0;
+    };
+
+    class UnusedTexture
+    {
+      public:
+        UnusedTexture( QSGTexture* texture )
+            : texture( texture )
+        {
+        }
+
+        ~UnusedTexture()
+        {
+            delete texture;
+        }
+
+        QSGTexture* texture;
+    };
+
+    inline int qskCost( const QSize& size )
+    {
+        const qint64 cost = qint64( size.width() ) * size.height() * 4;
+        return static_cast< int >( qMin( cost, qint64( std::numeric_limits< int >::max() ) ) );
+    }
+
+    inline int qskMaxCost()
+    {
+        const qint64 maxCost = qskMaximumCost.load( std::memory_order_relaxed );
+
+        return static_cast< int >(
+            qBound( qint64( 0 ), maxCost, qint64( std::numeric_limits< int >::max() ) ) );
+    }
+
+    class CacheTable
+    {
+      public:
+        QMutex mutex;
+
+        QHash< const QQuickWindow*, QskTextureCache* > caches;
+        QHash< quint64, QskTextureCache* > ids;
+
+        quint64 lastId = 0;
+    };
+}
+
+Q_GLOBAL_STATIC( CacheTable, qskCacheTable )
+
+class QskTextureCache::PrivateData
+{
+  public:
+    QHash< Key, Entry > usedTextures;
+    QCache< Key, UnusedTexture > unusedTextures;
+
+    quint64 id = 0;
+
+    QMetaObject::Connection invalidatedConnection;
+    QMetaObject::Connection destroyedConnection;
+};
+
+QskTextureCache::QskTextureCache( QQuickWindow* window )
+    : m_data( new PrivateData() )
+{
+    m_data->unusedTextures.setMaxCost( qskMaxCost() );
+
+    /*
+        The scene graph nodes have been destroyed before, so there
+        are no more references to the textures.
+     */
+    m_data->invalidatedConnection = QObject::connect(
+        window, &QQuickWindow::sceneGraphInvalidated,
+        window, [ window ] { cleanup( window ); }, Qt::DirectConnection );
+
+    /*
+        A window created later might have the same address,
+        so we must not keep the entry beyond the lifetime of the window
+     */
+    m_data->destroyedConnection = QObject::connect(
+        window, &QObject::destroyed,
+        window, [ window ] { cleanup( window ); }, Qt::DirectConnection );
+}
+
+QskTextureCache::~QskTextureCache()
+{
+    QObject::disconnect( m_data->invalidatedConnection );
+    QObject::disconnect( m_data->destroyedConnection );
+
+    for ( const auto& entry : std::as_const( m_data->usedTextures ) )
+        delete entry.texture;
+}
+
+QskTextureCache* QskTextureCache::instance( QQuickWindow* window )
+{
+    if ( window == nullptr )
+        return nullptr;
+
+    auto table = qskCacheTable;
+
+    QMutexLocker locker( &table->mutex );
+
+    auto& cache = table->caches[ window ];
+    if ( cache == nullptr )
+    {
+        cache = new QskTextureCache( window );
+        cache->m_data->id = ++table->lastId;
+
+        table->ids.insert( cache->m_data->id, cache );
+    }
+
+    return cache;
+}
+
+QskTextureCache* QskTextureCache::find( quint64 id )
+{
+    if ( id == 0 )
+        return nullptr;
+
+    auto table = qskCacheTable;
+
+    QMutexLocker locker( &table->mutex );
+    return table->ids.value( id, nullptr );
+}
+
+quint64 QskTextureCache::id() const
+{
+    return m_data->id;
+}
+
+quint64 QskTextureCache::generation()
+{
+    return qskGeneration.load( std::memory_order_acquire );
+}
+
+void QskTextureCache::cleanup( QQuickWindow* window )
+{
+    QskTextureCache* cache;
+
+    {
+        auto table = qskCacheTable;
+
+        QMutexLocker locker( &table->mutex );
+
+        cache = table->caches.take( window );
+        if ( cache )
+        {
+            table->ids.remove( cache->m_data->id );
+            qskGeneration.fetch_add( 1, std::memory_order_release );
+        }
+    }
+
+    delete cache;
+}
+
+QSGTexture* QskTextureCache::acquireTexture(
+    QskHashValue hash, const QSize& size, const QVariant& content )
+{
+    const Key key { hash, size, content };
+
+    auto it = m_data->usedTextures.find( key );
+    if ( it != m_data->usedTextures.end() )
+    {
+        it->refCount++;
+        return it->texture;
+    }
+
+    if ( auto unused = m_data->unusedTextures.take( key ) )
+    {
+        Entry entry;
+        entry.texture = unused->texture;
+        entry.refCount = 1;
+
+        unused->texture = nullptr;
+        delete unused;
+
+        m_data->usedTextures.insert( key, entry );
+
+        return entry.texture;
+    }
+
+    return nullptr;
+}
+
+void QskTextureCache::insertTexture( QskHashValue hash,
+    const QSize& size, const QVariant& content, QSGTexture* texture )
+{
+    if ( texture == nullptr )
+        return;
+
+    const Key key { hash, size, content };
+
+    Q_ASSERT( !m_data->usedTextures.contains( key ) );
+
+    m_data->unusedTextures.remove( key );
+
+    Entry entry;
+    entry.texture = texture;
+    entry.refCount = 1;
+
+    m_data->usedTextures.insert( key, entry );
+}
+
+void QskTextureCache::releaseTexture(
+    QskHashValue hash, const QSize& size, const QVariant& content )
+{
+    const Key key { hash, size, content };
+
+    auto it = m_data->usedTextures.find( key );
+    if ( it == m_data->usedTextures.end() )
+        return;
+
+    if ( --it->refCount > 0 )
+        return;
+
+    auto texture = it->texture;
+    m_data->usedTextures.erase( it );
+
+    auto& unusedTextures = m_data->unusedTextures;
+
+    if ( unusedTextures.maxCost() != qskMaxCost() )
+        unusedTextures.setMaxCost( qskMaxCost() );
+
+    // when exceeding the limits QCache deletes the texture immediately
+    unusedTextures.insert( key, new UnusedTexture( texture ), qskCost( size ) );
+}
+
+int QskTextureCache::textureCount() const
+{
+    return m_data->usedTextures.size() + m_data->unusedTextures.size();
+}
+
+qint64 QskTextureCache::unusedCost() const
+{
+    return m_data->unusedTextures.totalCost();
+}
+
+void QskTextureCache::setMaximumCost( qint64 cost )
+{
+    qskMaximumCost.store( qMax( cost, qint64( 0 ) ), std::memory_order_relaxed );
+}
+
+qint64 QskTextureCache::maximumCost()
+{
+    return qskMaximumCost.load( std::memory_order_relaxed );
+}
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_TEXTURE_CACHE_H
+#define QSK_TEXTURE_CACHE_H
+
+#include "QskGlobal.h"
+
+#include <qsize.h>
+#include <memory>
+
+class QQuickWindow;
+class QSGTexture;
+class QVariant;
+
+/*
+    A window specific cache of textures, that are shared between nodes
+    having the same content: f.e icons in a list view.
+
+    The textures are identified by a hash value for the content and
+    the size of the texture in pixels. As hash values might collide,
+    an identity of the content is stored in the key and compared
+    for textures with the same hash value. Textures are reference counted
+    and can't be evicted, as long as they are in use. Unused textures
+    are kept in a LRU list until the memory limit is exceeded.
+
+    The cache has to be used from the render thread of the window only.
+    It is destroyed, when the scene graph of the window gets invalidated.
+    So nodes must not store a pointer to the cache, but its id, that
+    is never reused for another cache. As long as generation() did not
+    change, no cache has been destroyed and the id can be assumed
+    to be valid without having to call find().
+ */
+class QSK_EXPORT QskTextureCache
+{
+  public:
+    static QskTextureCache* instance( QQuickWindow* );
+
+    // nullptr, when the cache has been destroyed in the meantime
+    static QskTextureCache* find( quint64 id );
+
+    quint64 id() const;
+
+    // incremented, whenever a cache gets destroyed
+    static quint64 generation();
+
+    // increments the reference counter, nullptr for a cache miss
+    QSGTexture* acquireTexture( QskHashValue,
+        const QSize&, const QVariant& content );
+
+    // ownership is transferred to the cache, reference counter is 1
+    void insertTexture( QskHashValue, const QSize&,
+        const QVariant& content, QSGTexture* );
+
+    void releaseTexture( QskHashValue, const QSize&, const QVariant& content );
+
+    int textureCount() const;
+    qint64 unusedCost() const;
+
+    // bytes, that can be occupied by unused textures of a window
+    static void setMaximumCost( qint64 );
+    static qint64 maximumCost();
+
+  private:
+    QskTextureCache( QQuickWindow* );
+    ~QskTextureCache();
+
+    static void cleanup( QQuickWindow* );
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -193,6 +193,29 @@ quint32 QskTextureRenderer::createPaintedTextureGL(
     return qskTakeTexture( fbo );
 }
 
+bool QskTextureRenderer::isAtlasCandidate( const QSize& size )
+{
+    /*
+        The atlas of the scene graph accepts images being smaller
+        than a limit, that depends on the size of its pages
+        ( QSG_ATLAS_SIZE_LIMIT ). Beyond 128 pixels the benefit of
+        batching is not worth the fragmentation of the pages.
+     */
+    const int maxExtent = 128;
+
+    return !size.isEmpty()
+        && ( size.width() <= maxExtent ) && ( size.height() <= maxExtent );
+}
+
+QSGTexture* QskTextureRenderer::createAtlasTexture(
+    QQuickWindow* window, const QImage& image )
+{
+    const QQuickWindow::CreateTextureOptions options(
+        QQuickWindow::TextureHasAlphaChannel | QQuickWindow::TextureCanUseAtlas );
+
+    return window->createTextureFromImage( image, options );
+}
+
 static QSGTexture* qskCreateTextureRaster( QQuickWindow* window,
     const QSize& size, QskTextureRenderer::PaintHelper* helper )
 {
@@ -213,13 +236,18 @@ static QSGTexture* qskCreateTextureRaster( QQuickWindow* window,
         helper->paint( &painter, size );
     }
 
+    if ( QskTextureRenderer::isAtlasCandidate( image.size() ) )
+        return QskTextureRenderer::createAtlasTexture( window, image );
+
     return window->createTextureFromImage( image, QQuickWindow::TextureHasAlphaChannel );
 }
 
 QSGTexture* QskTextureRenderer::createPaintedTexture(
     QQuickWindow* window, const QSize& size, PaintHelper* helper )
 {
-    if ( isOpenGLWindow( window ) )
+    const auto ratio = window ? window->effectiveDevicePixelRatio() : 1.0;
+
+    if ( isOpenGLWindow( window ) && !isAtlasCandidate( size * ratio ) )
     {
         const auto textureId = createPaintedTextureGL( window, size, helper );
 
@@ -9,6 +9,7 @@
 #include "QskGlobal.h"
 
 class QSize;
+class QImage;
 class QPainter;
 class QSGTexture;
 class QQuickWindow;
@@ -29,6 +30,15 @@ namespace QskTextureRenderer
 
     bool isOpenGLWindow( const QQuickWindow* );
 
+    /*
+        Small textures are uploaded into the texture atlas of the scene graph,
+        so that the renderer is able to batch nodes with different textures.
+        Those textures are always rasterized, as rendering into a FBO
+        does not make any sense for them.
+     */
+    bool isAtlasCandidate( const QSize& textureSize );
+    QSGTexture* createAtlasTexture( QQuickWindow*, const QImage& );
+
     void setTextureId( QQuickWindow*,
         quint32 textureId, const QSize&, QSGTexture* );
 
@@ -0,0 +1,87 @@
+#version 440
+
+layout( location = 0 ) in vec2 coord;
+layout( location = 0 ) out vec4 fragColor;
+
+layout( std140, binding = 0 ) uniform buf
+{
+    mat4 matrix;
+    vec4 borderColor;
+
+    /*
+        arc.xy: cos/sin of the angle of the midpoint
+        arc.zw: cos/sin of the angle between midpoint/endpoint
+     */
+    vec4 arc;
+
+    vec2 gradientCenter;
+    float gradientAspectRatio;
+    float gradientStart;
+    float gradientSpan;
+
+    float radius;
+    float thickness;
+    float borderWidth;
+
+    float opacity;
+    float rampCoordinate;
+} ubuf;
+
+layout( binding = 1 ) uniform sampler2D colorRamp;
+
+mat2 rotation( vec2 v ) { return mat2( v.x, -v.y, v.y, v.x ); }
+
+float arcDistance( vec2 pos )
+{
+    float dist = abs( length( pos ) - ubuf.radius ) - ubuf.thickness;
+
+    if ( ubuf.arc.z > -0.99999 ) // not a full circle
+    {
+        vec2 v = pos * rotation( ubuf.arc.xy ); // x-axial symmetric
+        v.y = abs( v.y );
+
+        v *= rotation( ubuf.arc.wz ); // end point at 90°
+
+        if ( v.x < 0.0 )
+        {
+            // distance to the flat cap
+            float dy = max( abs( v.y - ubuf.radius ) - ubuf.thickness, 0.0 );
+            dist = length( vec2( v.x, dy ) );
+        }
+        else if ( v.y > 0.0 )
+        {
+            dist = max( dist, -v.x );
+        }
+    }
+
+    return dist;
+}
+
+vec4 fillColor()
+{
+    vec2 pos = coord - ubuf.gradientCenter;
+    pos.y *= ubuf.gradientAspectRatio;
+
+    float v = sign( ubuf.gradientSpan )
+        * ( atan( -pos.y, pos.x ) / 6.2831853 - ubuf.gradientStart );
+
+    float value = ( v - floor( v ) ) / abs( ubuf.gradientSpan );
+    return texture( colorRamp, vec2( value, ubuf.rampCoordinate ) );
+}
+
+void main()
+{
+    float dist = arcDistance( coord );
+    float aa = max( fwidth( length( coord ) ), 0.0001 );
+
+    // the border is centered on the outline
+    float bw2 = 0.5 * ubuf.borderWidth;
+
+    float outer = clamp( 0.5 - ( dist - bw2 ) / aa, 0.0, 1.0 );
+
+    float inner = 1.0;
+    if ( bw2 > 0.0 )
+        inner = clamp( 0.5 - ( dist + bw2 ) / aa, 0.0, 1.0 );
+
+    fragColor = mix( ubuf.borderColor, fillColor(), inner ) * outer * ubuf.opacity;
+}
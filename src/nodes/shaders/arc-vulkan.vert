@@ -0,0 +1,37 @@
+#version 440
+
+layout( location = 0 ) in vec4 in_vertex;
+layout( location = 1 ) in vec2 in_coord;
+layout( location = 0 ) out vec2 coord;
+
+layout( std140, binding = 0 ) uniform buf
+{
+    mat4 matrix;
+    vec4 borderColor;
+
+    /*
+        arc.xy: cos/sin of the angle of the midpoint
+        arc.zw: cos/sin of the angle between midpoint/endpoint
+     */
+    vec4 arc;
+
+    vec2 gradientCenter;
+    float gradientAspectRatio;
+    float gradientStart;
+    float gradientSpan;
+
+    float radius;
+    float thickness;
+    float borderWidth;
+
+    float opacity;
+    float rampCoordinate;
+} ubuf;
+
+out gl_PerVertex { vec4 gl_Position; };
+
+void main()
+{
+    coord = in_coord;
+    gl_Position = ubuf.matrix * in_vertex;
+}
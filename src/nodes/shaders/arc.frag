@@ -0,0 +1,84 @@
+#ifdef GL_ES
+#extension GL_OES_standard_derivatives : enable
+#endif
+
+varying highp vec2 coord;
+
+uniform sampler2D colorRamp;
+uniform highp float rampCoordinate;
+
+uniform lowp vec4 borderColor;
+
+/*
+    arc.xy: cos/sin of the angle of the midpoint
+    arc.zw: cos/sin of the angle between midpoint/endpoint
+ */
+uniform highp vec4 arc;
+
+uniform highp vec2 gradientCenter;
+uniform highp float gradientAspectRatio;
+uniform highp float gradientStart;
+uniform highp float gradientSpan;
+
+uniform highp float radius;
+uniform highp float thickness;
+uniform highp float borderWidth;
+
+uniform lowp float opacity;
+
+highp mat2 rotation( highp vec2 v ) { return mat2( v.x, -v.y, v.y, v.x ); }
+
+highp float arcDistance( highp vec2 pos )
+{
+    highp float dist = abs( length( pos ) - radius ) - thickness;
+
+    if ( arc.z > -0.99999 ) // not a full circle
+    {
+        highp vec2 v = pos * rotation( arc.xy ); // x-axial symmetric
+        v.y = abs( v.y );
+
+        v *= rotation( arc.wz ); // end point at 90°
+
+        if ( v.x < 0.0 )
+        {
+            // distance to the flat cap
+            highp float dy = max( abs( v.y - radius ) - thickness, 0.0 );
+            dist = length( vec2( v.x, dy ) );
+        }
+        else if ( v.y > 0.0 )
+        {
+            dist = max( dist, -v.x );
+        }
+    }
+
+    return dist;
+}
+
+lowp vec4 fillColor()
+{
+    highp vec2 pos = coord - gradientCenter;
+    pos.y *= gradientAspectRatio;
+
+    highp float v = sign( gradientSpan )
+        * ( atan( -pos.y, pos.x ) / 6.2831853 - gradientStart );
+
+    highp float value = ( v - floor( v ) ) / abs( gradientSpan );
+    return texture2D( colorRamp, vec2( value, rampCoordinate ) );
+}
+
+void main()
+{
+    highp float dist = arcDistance( coord );
+    highp float aa = max( fwidth( length( coord ) ), 0.0001 );
+
+    // the border is centered on the outline
+    highp float bw2 = 0.5 * borderWidth;
+
+    lowp float outer = clamp( 0.5 - ( dist - bw2 ) / aa, 0.0, 1.0 );
+
+    lowp float inner = 1.0;
+    if ( bw2 > 0.0 )
+        inner = clamp( 0.5 - ( dist + bw2 ) / aa, 0.0, 1.0 );
+
+    gl_FragColor = mix( borderColor, fillColor(), inner ) * outer * opacity;
+}
@@ -1,22 +1,23 @@
 #version 440
 
-layout( location = 0 ) in vec2 coord; 
+layout( location = 0 ) in vec2 coord;
+
+/*
+    arc.xy: cos/sin of the angle of the midpoint
+    arc.zw: cos/sin of the angle between midpoint/endpoint
+*/
+layout( location = 1 ) in vec4 arc;
+
+// radius.x: spread radius, radius.y: blur radius
+layout( location = 2 ) in vec2 radius;
+
+layout( location = 3 ) in vec4 color;
+
 layout( location = 0 ) out vec4 fragColor;
 
 layout( std140, binding = 0 ) uniform buf
 {
     mat4 matrix;
-    vec4 color;
-
-    /*
-        arc.xy: cos/sin of the angle of the midpoint
-        arc.zw: cos/sin of the angle between midpoint/endpoint
-    */
-    vec4 arc;
-
-    float spreadRadius;
-    float blurRadius;
-
     float opacity;
 } ubuf;
 
@@ -24,23 +25,26 @@ mat2 rotation( vec2 v ) { return mat2( v.x, -v.y, v.y, v.x ); }
 
 void main()
 {        
-    float radius = 0.5 - ubuf.blurRadius - ubuf.spreadRadius;
+    float spreadRadius = radius.x;
+    float blurRadius = radius.y;
+
+    float r = 0.5 - blurRadius - spreadRadius;
 
-    float dist = abs( length( coord ) - radius ) - ubuf.spreadRadius;
+    float dist = abs( length( coord ) - r ) - spreadRadius;
 
-    if ( ( ubuf.arc.z ) < 1.0 && ( dist < 1.0 ) )
+    if ( ( arc.z ) < 1.0 && ( dist < 1.0 ) )
     {
-        vec2 v = coord * rotation( ubuf.arc.xy ); // x-axial symmetric
+        vec2 v = coord * rotation( arc.xy ); // x-axial symmetric
         v.y = abs( v.y );
 
-        v *= rotation ( ubuf.arc.wz ); // end point to 90°
+        v *= rotation ( arc.wz ); // end point to 90°
         if ( v.x < 0.0 )
         {
-            v.y = max( 0.0, abs( v.y - radius ) - ubuf.spreadRadius );
+            v.y = max( 0.0, abs( v.y - r ) - spreadRadius );
             dist = max( dist, length( v ) );
         }
     }
 
-    float a = 1.0 - smoothstep( 0.0, ubuf.blurRadius, dist );
-    fragColor = ubuf.color * a * ubuf.opacity;
+    float a = 1.0 - smoothstep( 0.0, blurRadius, dist );
+    fragColor = color * a * ubuf.opacity;
 }
@@ -2,20 +2,29 @@
 
 layout( location = 0 ) in vec4 in_vertex;
 layout( location = 1 ) in vec2 in_coord;
+layout( location = 2 ) in vec4 in_arc;
+layout( location = 3 ) in vec2 in_radius;
+layout( location = 4 ) in vec4 in_color;
+
 layout( location = 0 ) out vec2 coord;
+layout( location = 1 ) out vec4 arc;
+layout( location = 2 ) out vec2 radius;
+layout( location = 3 ) out vec4 color;
 
 layout( std140, binding = 0 ) uniform buf
 {
     mat4 matrix;
-    vec4 color;         
-    vec4 arc;
-    float spreadRadius; 
-    float blurRadius;
     float opacity;
 } ubuf;
 
+out gl_PerVertex { vec4 gl_Position; };
+
 void main()
 {
     coord = in_coord;
+    arc = in_arc;
+    radius = in_radius;
+    color = in_color;
+
     gl_Position = ubuf.matrix * in_vertex;
 }
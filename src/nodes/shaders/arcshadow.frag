@@ -1,23 +1,28 @@
 varying lowp vec2 coord;
 
-uniform lowp vec4 color;
-uniform lowp float spreadRadius;
-uniform lowp float blurRadius;
-uniform lowp float opacity;
-
 /*
     arc.xy: cos/sin of the angle of the midpoint
     arc.zw: cos/sin of the angle between midpoint/endpoint
  */
-uniform lowp vec4 arc;
+varying lowp vec4 arc;
+
+// radius.x: spread radius, radius.y: blur radius
+varying lowp vec2 radius;
+
+varying lowp vec4 color;
+
+uniform lowp float opacity;
 
 mat2 rotation( vec2 v ) { return mat2( v.x, -v.y, v.y, v.x ); }
 
 void main()
 {
-    float radius = 0.5 - blurRadius - spreadRadius;
+    float spreadRadius = radius.x;
+    float blurRadius = radius.y;
+
+    float r = 0.5 - blurRadius - spreadRadius;
 
-    float dist = abs( length( coord ) - radius ) - spreadRadius;
+    float dist = abs( length( coord ) - r ) - spreadRadius;
 
     if ( ( arc.z < 1.0 ) && ( dist < 1.0 ) ) 
     {
@@ -27,7 +32,7 @@ void main()
         v *= rotation( arc.wz ); // end point at 90°
         if ( v.x < 0.0 )
         {
-            v.y = max( 0.0, abs( v.y - radius ) - spreadRadius );
+            v.y = max( 0.0, abs( v.y - r ) - spreadRadius );
             dist = max( dist, length( v ) );
         }
     }
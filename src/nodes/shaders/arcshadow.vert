@@ -2,11 +2,21 @@ uniform highp mat4 matrix;
 
 attribute highp vec4 in_vertex;
 attribute mediump vec2 in_coord;
+attribute lowp vec4 in_arc;
+attribute lowp vec2 in_radius;
+attribute lowp vec4 in_color;
 
 varying mediump vec2 coord;
+varying lowp vec4 arc;
+varying lowp vec2 radius;
+varying lowp vec4 color;
 
 void main()
 {
     coord = in_coord;
+    arc = in_arc;
+    radius = in_radius;
+    color = in_color;
+
     gl_Position = matrix * in_vertex;
 }
@@ -0,0 +1,63 @@
+#version 440
+
+layout( location = 0 ) in vec4 rect;
+layout( location = 1 ) in vec4 radii;
+layout( location = 2 ) in vec4 borders;
+layout( location = 3 ) in vec4 fillColor1;
+layout( location = 4 ) in vec4 fillColor2;
+layout( location = 5 ) in vec4 borderColor;
+layout( location = 6 ) in float gradientPos;
+
+layout( location = 0 ) out vec4 fragColor;
+
+layout( std140, binding = 0 ) uniform buf
+{
+    mat4 matrix;
+    float opacity;
+} ubuf;
+
+float effectiveRadius( in vec4 radii, in vec2 point )
+{
+    if ( point.x > 0.0 )
+        return ( point.y > 0.0 ) ? radii.x : radii.y;
+    else
+        return ( point.y > 0.0 ) ? radii.z : radii.w;
+}
+
+float boxDistance( in vec2 point, in vec2 halfSize, in vec4 radii )
+{
+    float r = effectiveRadius( radii, point );
+
+    vec2 d = abs( point ) - halfSize + r;
+    return min( max( d.x, d.y ), 0.0 ) + length( max( d, 0.0 ) ) - r;
+}
+
+void main()
+{
+    vec2 pos = rect.xy;
+    vec2 halfSize = rect.zw;
+
+    float outer = boxDistance( pos, halfSize, radii );
+    float aa = max( fwidth( outer ), 0.0001 );
+
+    float outerCoverage = clamp( 0.5 - outer / aa, 0.0, 1.0 );
+    float innerCoverage = 1.0;
+
+    if ( dot( borders, vec4( 1.0 ) ) > 0.0 )
+    {
+        // borders: left, top, right, bottom
+        vec2 offset = 0.5 * vec2( borders.x - borders.z, borders.y - borders.w );
+        vec2 innerSize = max( halfSize - 0.5 * ( borders.xy + borders.zw ), 0.0 );
+
+        // radii: bottomRight, topRight, bottomLeft, topLeft
+        vec4 innerRadii = max( radii - vec4(
+            max( borders.z, borders.w ), max( borders.z, borders.y ),
+            max( borders.x, borders.w ), max( borders.x, borders.y ) ), 0.0 );
+
+        float inner = boxDistance( pos - offset, innerSize, innerRadii );
+        innerCoverage = clamp( 0.5 - inner / aa, 0.0, 1.0 );
+    }
+
+    vec4 fill = mix( fillColor1, fillColor2, clamp( gradientPos, 0.0, 1.0 ) );
+    fragColor = mix( borderColor, fill, innerCoverage ) * outerCoverage * ubuf.opacity;
+}
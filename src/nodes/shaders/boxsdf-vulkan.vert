@@ -0,0 +1,39 @@
+#version 440
+
+layout( location = 0 ) in vec4 in_vertex;
+layout( location = 1 ) in vec4 in_rect;
+layout( location = 2 ) in vec4 in_radii;
+layout( location = 3 ) in vec4 in_borders;
+layout( location = 4 ) in vec4 in_fillColor1;
+layout( location = 5 ) in vec4 in_fillColor2;
+layout( location = 6 ) in vec4 in_borderColor;
+layout( location = 7 ) in float in_gradientPos;
+
+layout( location = 0 ) out vec4 rect;
+layout( location = 1 ) out vec4 radii;
+layout( location = 2 ) out vec4 borders;
+layout( location = 3 ) out vec4 fillColor1;
+layout( location = 4 ) out vec4 fillColor2;
+layout( location = 5 ) out vec4 borderColor;
+layout( location = 6 ) out float gradientPos;
+
+layout( std140, binding = 0 ) uniform buf
+{
+    mat4 matrix;
+    float opacity;
+} ubuf;
+
+out gl_PerVertex { vec4 gl_Position; };
+
+void main()
+{
+    rect = in_rect;
+    radii = in_radii;
+    borders = in_borders;
+    fillColor1 = in_fillColor1;
+    fillColor2 = in_fillColor2;
+    borderColor = in_borderColor;
+    gradientPos = in_gradientPos;
+
+    gl_Position = ubuf.matrix * in_vertex;
+}
@@ -0,0 +1,57 @@
+#ifdef GL_ES
+#extension GL_OES_standard_derivatives : enable
+#endif
+
+uniform lowp float opacity;
+
+varying highp vec4 rect;
+varying highp vec4 radii;
+varying highp vec4 borders;
+varying lowp vec4 fillColor1;
+varying lowp vec4 fillColor2;
+varying lowp vec4 borderColor;
+varying mediump float gradientPos;
+
+highp float effectiveRadius( in highp vec4 radii, in highp vec2 point )
+{
+    if ( point.x > 0.0 )
+        return ( point.y > 0.0 ) ? radii.x : radii.y;
+    else
+        return ( point.y > 0.0 ) ? radii.z : radii.w;
+}
+
+highp float boxDistance( in highp vec2 point, in highp vec2 halfSize, in highp vec4 radii )
+{
+    highp float r = effectiveRadius( radii, point );
+
+    highp vec2 d = abs( point ) - halfSize + r;
+    return min( max( d.x, d.y ), 0.0 ) + length( max( d, 0.0 ) ) - r;
+}
+
+void main()
+{
+    highp vec2 pos = rect.xy;
+    highp vec2 halfSize = rect.zw;
+
+    highp float outer = boxDistance( pos, halfSize, radii );
+    highp float aa = max( fwidth( outer ), 0.0001 );
+
+    lowp float outerCoverage = clamp( 0.5 - outer / aa, 0.0, 1.0 );
+    lowp float innerCoverage = 1.0;
+
+    if ( dot( borders, vec4( 1.0 ) ) > 0.0 )
+    {
+        highp vec2 offset = 0.5 * vec2( borders.x - borders.z, borders.y - borders.w );
+        highp vec2 innerSize = max( halfSize - 0.5 * ( borders.xy + borders.zw ), 0.0 );
+
+        highp vec4 innerRadii = max( radii - vec4(
+            max( borders.z, borders.w ), max( borders.z, borders.y ),
+            max( borders.x, borders.w ), max( borders.x, borders.y ) ), 0.0 );
+
+        highp float inner = boxDistance( pos - offset, innerSize, innerRadii );
+        innerCoverage = clamp( 0.5 - inner / aa, 0.0, 1.0 );
+    }
+
+    lowp vec4 fill = mix( fillColor1, fillColor2, clamp( gradientPos, 0.0, 1.0 ) );
+    gl_FragColor = mix( borderColor, fill, innerCoverage ) * outerCoverage * opacity;
+}
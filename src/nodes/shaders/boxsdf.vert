@@ -0,0 +1,31 @@
+uniform highp mat4 matrix;
+
+attribute highp vec4 in_vertex;
+attribute highp vec4 in_rect;
+attribute highp vec4 in_radii;
+attribute highp vec4 in_borders;
+attribute lowp vec4 in_fillColor1;
+attribute lowp vec4 in_fillColor2;
+attribute lowp vec4 in_borderColor;
+attribute mediump float in_gradientPos;
+
+varying highp vec4 rect;
+varying highp vec4 radii;
+varying highp vec4 borders;
+varying lowp vec4 fillColor1;
+varying lowp vec4 fillColor2;
+varying lowp vec4 borderColor;
+varying mediump float gradientPos;
+
+void main()
+{
+    rect = in_rect;
+    radii = in_radii;
+    borders = in_borders;
+    fillColor1 = in_fillColor1;
+    fillColor2 = in_fillColor2;
+    borderColor = in_borderColor;
+    gradientPos = in_gradientPos;
+
+    gl_Position = matrix * in_vertex;
+}
@@ -2,16 +2,20 @@
 
 layout( location = 0 ) in vec4 in_vertex;
 layout( location = 1 ) in vec2 in_coord;
+layout( location = 2 ) in vec4 in_radius;
+layout( location = 3 ) in vec2 in_aspectRatio;
+layout( location = 4 ) in float in_blurExtent;
+layout( location = 5 ) in vec4 in_color;
 
 layout( location = 0 ) out vec2 coord;
+layout( location = 1 ) out vec4 radius;
+layout( location = 2 ) out vec2 aspectRatio;
+layout( location = 3 ) out float blurExtent;
+layout( location = 4 ) out vec4 color;
 
 layout( std140, binding = 0 ) uniform buf
 {
     mat4 matrix;
-    vec4 color;
-    vec4 radius;
-    vec2 aspectRatio;
-    float blurExtent;
     float opacity;
 } ubuf;
 
@@ -20,5 +24,10 @@ out gl_PerVertex { vec4 gl_Position; };
 void main()
 {
     coord = in_coord;
+    radius = in_radius;
+    aspectRatio = in_aspectRatio;
+    blurExtent = in_blurExtent;
+    color = in_color;
+
     gl_Position = ubuf.matrix * in_vertex;
 }
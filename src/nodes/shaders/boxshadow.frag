@@ -1,10 +1,10 @@
 uniform lowp float opacity;
-uniform lowp float blurExtent;
-uniform lowp vec4 radius;
-uniform lowp vec4 color;
-uniform lowp vec2 aspectRatio;
 
 varying lowp vec2 coord;
+varying lowp vec4 radius;
+varying lowp vec2 aspectRatio;
+varying lowp float blurExtent;
+varying lowp vec4 color;
 
 lowp float effectiveRadius( in lowp vec4 radii, in lowp vec2 point )
 {
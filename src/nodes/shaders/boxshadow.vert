@@ -1,13 +1,25 @@
 uniform highp mat4 matrix;
-uniform lowp vec2 aspect;
 
 attribute highp vec4 in_vertex;
 attribute mediump vec2 in_coord;
+attribute lowp vec4 in_radius;
+attribute lowp vec2 in_aspectRatio;
+attribute lowp float in_blurExtent;
+attribute lowp vec4 in_color;
 
 varying mediump vec2 coord;
+varying lowp vec4 radius;
+varying lowp vec2 aspectRatio;
+varying lowp float blurExtent;
+varying lowp vec4 color;
 
 void main()
 {
     coord = in_coord;
+    radius = in_radius;
+    aspectRatio = in_aspectRatio;
+    blurExtent = in_blurExtent;
+    color = in_color;
+
     gl_Position = matrix * in_vertex;
 }
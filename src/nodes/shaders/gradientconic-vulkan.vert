@@ -11,6 +11,7 @@ layout( std140, binding = 0 ) uniform buf
     float start;
     float span;
     float opacity;
+    float rampCoordinate;
 } ubuf;
 
 out gl_PerVertex { vec4 gl_Position; };
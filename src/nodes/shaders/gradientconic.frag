@@ -1,4 +1,5 @@
 uniform sampler2D colorRamp;
+uniform highp float rampCoordinate;
 uniform lowp float opacity;
 
 uniform highp float start;
@@ -8,7 +9,7 @@ varying highp vec2 coord;
 
 lowp vec4 colorAt( highp float value )
 {
-    return texture2D( colorRamp, vec2( value, 0.0 ) );
+    return texture2D( colorRamp, vec2( value, rampCoordinate ) );
 }
 
 void main()
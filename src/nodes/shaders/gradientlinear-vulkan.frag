@@ -8,13 +8,14 @@ layout( std140, binding = 0 ) uniform buf
     mat4 matrix;
     vec4 vector;
     float opacity;
+    float rampCoordinate;
 } ubuf;
 
 layout( binding = 1 ) uniform sampler2D colorRamp;
 
 vec4 colorAt( float value )
 {
-    return texture( colorRamp, vec2( value, 0.0 ) );
+    return texture( colorRamp, vec2( value, ubuf.rampCoordinate ) );
 }
 
 void main()
@@ -1,11 +1,12 @@
 uniform sampler2D colorRamp;
+uniform highp float rampCoordinate;
 uniform highp float opacity;
 
 varying highp float colorIndex;
 
 lowp vec4 colorAt( float value )
 {
-    return texture2D( colorRamp, vec2( value, 0.0 ) );
+    return texture2D( colorRamp, vec2( value, rampCoordinate ) );
 }
 
 void main()
@@ -9,13 +9,14 @@ layout( std140, binding = 0 ) uniform buf
     vec2 centerCoord;
     vec2 radius;
     float opacity;
+    float rampCoordinate;
 } ubuf;
 
 layout( binding = 1 ) uniform sampler2D colorRamp;
 
 vec4 colorAt( float value )
 {
-    return texture( colorRamp, vec2( value, 0.0 ) );
+    return texture( colorRamp, vec2( value, ubuf.rampCoordinate ) );
 }
 
 void main()
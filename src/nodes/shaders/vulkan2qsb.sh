@@ -6,12 +6,18 @@ function qsbcompile {
     # qsb --qt6 -b -o ${qsbfile}.qsb $1
 } 
 
+qsbcompile arc-vulkan.vert
+qsbcompile arc-vulkan.frag
+
 qsbcompile arcshadow-vulkan.vert
 qsbcompile arcshadow-vulkan.frag
 
 qsbcompile boxshadow-vulkan.vert
 qsbcompile boxshadow-vulkan.frag
 
+qsbcompile boxsdf-vulkan.vert
+qsbcompile boxsdf-vulkan.frag
+
 qsbcompile gradientconic-vulkan.vert
 qsbcompile gradientconic-vulkan.frag
 
@@ -0,0 +1,155 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include <QskColorRamp.h>
+#include <QskGradient.h>
+#include <QskGradientStop.h>
+
+#include <qset.h>
+#include <qsgtexture.h>
+#include <qtest.h>
+
+static QskGradientStops qskStops( int count, int id )
+{
+    // stops, that are different for each id
+
+    QskGradientStops stops;
+    stops.reserve( count );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const auto pos = ( count > 1 ) ? qreal( i ) / ( count - 1 ) : 0.0;
+        stops += QskGradientStop( pos, QColor::fromRgb( QRgb( 0xff000000 | ( id + i ) ) ) );
+    }
+
+    return stops;
+}
+
+static inline QPair< QSGTexture*, float > qskLocation( const QskColorRamp::Ramp* ramp )
+{
+    return { QskColorRamp::texture( ramp ), QskColorRamp::rowCoordinate( ramp ) };
+}
+
+class ColorRampTest : public QObject
+{
+    Q_OBJECT
+
+  private Q_SLOTS:
+    void sharing();
+    void width();
+    void update();
+    void referenced();
+    void manyReferenced();
+};
+
+void ColorRampTest::sharing()
+{
+    using namespace QskColorRamp;
+
+    const auto stops = qskStops( 2, 1 );
+
+    auto ramp1 = acquire( nullptr, stops, QskGradient::PadSpread );
+    auto ramp2 = acquire( nullptr, stops, QskGradient::PadSpread );
+
+    QVERIFY( ramp1 != nullptr );
+    QCOMPARE( ramp2, ramp1 );
+
+    // the wrap mode is a property of the texture
+    auto ramp3 = acquire( nullptr, stops, QskGradient::RepeatSpread );
+    QVERIFY( texture( ramp3 ) != texture( ramp1 ) );
+
+    release( ramp1 );
+    release( ramp2 );
+    release( ramp3 );
+}
+
+void ColorRampTest::width()
+{
+    using namespace QskColorRamp;
+
+    const auto spread = QskGradient::PadSpread;
+
+    const int counts[] = { 2, 200, 600 };
+    const int widths[] = { 256, 512, 1024 };
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        auto ramp = acquire( nullptr, qskStops( counts[i], 10 ), spread );
+        QCOMPARE( texture( ramp )->textureSize().width(), widths[i] );
+
+        release( ramp );
+    }
+}
+
+void ColorRampTest::update()
+{
+    using namespace QskColorRamp;
+
+    const auto spread = QskGradient::PadSpread;
+    const auto stops = qskStops( 2, 20 );
+
+    auto ramp = QskColorRamp::update( nullptr, nullptr, stops, spread );
+    QVERIFY( ramp != nullptr );
+
+    QCOMPARE( QskColorRamp::update( ramp, nullptr, stops, spread ), ramp );
+
+    auto otherRamp = QskColorRamp::update( ramp, nullptr, qskStops( 2, 21 ), spread );
+    QVERIFY( otherRamp != ramp );
+
+    release( otherRamp );
+}
+
+void ColorRampTest::referenced()
+{
+    /*
+        The rows of ramps without references get recycled, but
+        a ramp, that is in use, must not be moved.
+     */
+    using namespace QskColorRamp;
+
+    const auto spread = QskGradient::RepeatSpread;
+
+    auto ramp = acquire( nullptr, qskStops( 2, 5 ), spread );
+    const auto location = qskLocation( ramp );
+
+    for ( int i = 0; i < 10000; i++ )
+    {
+        release( acquire( nullptr, qskStops( 2, 10000 + i ), spread ) );
+        QVERIFY( qskLocation( ramp ) == location );
+    }
+
+    release( ramp );
+}
+
+void ColorRampTest::manyReferenced()
+{
+    /*
+        There is no limit for the number of ramps, that are in use
+        at the same time: each of them needs to have its own row.
+     */
+    using namespace QskColorRamp;
+
+    const auto spread = QskGradient::ReflectSpread;
+
+    QVector< Ramp* > ramps;
+    QSet< QPair< QSGTexture*, float > > locations;
+
+    for ( int i = 0; i < 4096; i++ )
+    {
+        auto ramp = acquire( nullptr, qskStops( 2, 100000 + i ), spread );
+
+        ramps += ramp;
+        locations += qskLocation( ramp );
+    }
+
+    QCOMPARE( locations.count(), ramps.count() );
+
+    for ( auto ramp : std::as_const( ramps ) )
+        release( ramp );
+}
+
+QTEST_MAIN( ColorRampTest )
+
+#include "ColorRampTest.moc"
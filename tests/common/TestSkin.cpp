@@ -0,0 +1,25 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "TestSkin.h"
+#include <QskSkinManager.h>
+
+TestSkin::TestSkin( QObject* parent )
+    : QskSkin( parent )
+{
+}
+
+TestSkin::~TestSkin()
+{
+}
+
+void TestSkin::install()
+{
+    qskSkinManager->setSkin( new TestSkin() );
+}
+
+void TestSkin::initHints()
+{
+}
@@ -0,0 +1,28 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef TEST_SKIN_H
+#define TEST_SKIN_H
+
+#include <QskSkin.h>
+
+/*
+    A skin without any hints, so that the tests do not depend
+    on the metrics of a design system
+ */
+class TestSkin : public QskSkin
+{
+  public:
+    TestSkin( QObject* parent = nullptr );
+    ~TestSkin() override;
+
+    // creates a TestSkin and sets it as current skin
+    static void install();
+
+  protected:
+    void initHints() override;
+};
+
+#endif
@@ -0,0 +1,20 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "WarningsBlocker.h"
+
+static void qskBlockMessage( QtMsgType, const QMessageLogContext&, const QString& )
+{
+}
+
+WarningsBlocker::WarningsBlocker()
+    : m_handler( qInstallMessageHandler( qskBlockMessage ) )
+{
+}
+
+WarningsBlocker::~WarningsBlocker()
+{
+    qInstallMessageHandler( m_handler );
+}
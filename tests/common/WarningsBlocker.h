@@ -0,0 +1,28 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef WARNINGS_BLOCKER_H
+#define WARNINGS_BLOCKER_H
+
+#include <qglobal.h>
+#include <qlogging.h>
+
+/*
+    Suppresses all messages during its lifetime. Tests for
+    corrupted data would flood the output with warnings otherwise.
+ */
+class WarningsBlocker
+{
+  public:
+    WarningsBlocker();
+    ~WarningsBlocker();
+
+  private:
+    Q_DISABLE_COPY( WarningsBlocker )
+
+    const QtMessageHandler m_handler;
+};
+
+#endif
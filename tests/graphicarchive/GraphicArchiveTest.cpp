@@ -0,0 +1,210 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include <QskGraphic.h>
+#include <QskGraphicArchive.h>
+#include <QskGraphicIO.h>
+
+#include <qfile.h>
+#include <qimage.h>
+#include <qpainter.h>
+#include <qtemporarydir.h>
+#include <qtest.h>
+
+#include <WarningsBlocker.h>
+
+static QskGraphic qskGraphic( int id )
+{
+    QskGraphic graphic;
+
+    QPainter painter( &graphic );
+    painter.setPen( QPen( QColor::fromRgb( QRgb( 0xff000000 | id ) ), 2.0 ) );
+    painter.setBrush( Qt::blue );
+    painter.drawEllipse( QRectF( id, id, 50, 30 ) );
+
+    QImage image( 3, 3, QImage::Format_ARGB32 );
+    image.fill( QColor::fromRgb( QRgb( 0xff000000 | id ) ) );
+    painter.drawImage( QPointF( 10, 10 ), image );
+
+    painter.end();
+
+    return graphic;
+}
+
+static QByteArray qskData( const QskGraphic& graphic, QskGraphicIO::Version version )
+{
+    QByteArray data;
+    QskGraphicIO::write( graphic, data, version );
+
+    return data;
+}
+
+class GraphicArchiveTest : public QObject
+{
+    Q_OBJECT
+
+  private Q_SLOTS:
+    void initTestCase();
+
+    void roundTrip();
+    void empty();
+    void truncated();
+    void misalignedEntry();
+
+  private:
+    QString fileName( const QString& name ) const;
+
+    QTemporaryDir m_dir;
+    QMap< QString, QskGraphic > m_graphics;
+    QString m_archive;
+};
+
+void GraphicArchiveTest::initTestCase()
+{
+    QVERIFY( m_dir.isValid() );
+
+    /*
+        The index is sorted by the UTF-8 encoded names, what
+        is different from the order of QString for "ä" and "\U0001F600"
+     */
+    const QStringList names = { QStringLiteral( "a" ), QStringLiteral( "b/icon" ),
+        QStringLiteral( "ä" ), QStringLiteral( "\U0001F600" ),
+        QStringLiteral( "B" ), QStringLiteral( "ab" ) };
+
+    QMap< QString, QByteArray > data;
+
+    for ( int i = 0; i < names.count(); i++ )
+    {
+        const auto graphic = qskGraphic( i + 1 );
+        m_graphics.insert( names[ i ], graphic );
+
+        // both versions can be stored in an archive
+        const auto version = ( i % 2 ) ? QskGraphicIO::Version1 : QskGraphicIO::Version2;
+        data.insert( names[ i ], qskData( graphic, version ) );
+    }
+
+    m_archive = fileName( QStringLiteral( "test.qsa" ) );
+    QVERIFY( QskGraphicArchive::write( data, m_archive ) );
+}
+
+QString GraphicArchiveTest::fileName( const QString& name ) const
+{
+    return m_dir.filePath( name );
+}
+
+void GraphicArchiveTest::roundTrip()
+{
+    QskGraphicArchive archive( m_archive );
+
+    QVERIFY( archive.isOpen() );
+    QCOMPARE( archive.count(), m_graphics.count() );
+
+    auto names = archive.names();
+    names.sort();
+    QCOMPARE( names, m_graphics.keys() );
+
+    for ( auto it = m_graphics.constBegin(); it != m_graphics.constEnd(); ++it )
+    {
+        QVERIFY2( archive.contains( it.key() ), qPrintable( it.key() ) );
+        QVERIFY2( archive.graphic( it.key() ) == it.value(), qPrintable( it.key() ) );
+    }
+
+    QVERIFY( !archive.contains( QStringLiteral( "b" ) ) );
+    QVERIFY( !archive.contains( QStringLiteral( "b/icon2" ) ) );
+    QVERIFY( archive.graphic( QStringLiteral( "c" ) ).isNull() );
+
+    // graphics keep the mapped data alive
+
+    const auto graphic = archive.graphic( QStringLiteral( "a" ) );
+    archive.close();
+
+    QVERIFY( !archive.isOpen() );
+    QCOMPARE( archive.count(), 0 );
+    QVERIFY( graphic == m_graphics[ QStringLiteral( "a" ) ] );
+}
+
+void GraphicArchiveTest::empty()
+{
+    const auto name = fileName( QStringLiteral( "empty.qsa" ) );
+    QVERIFY( QskGraphicArchive::write( QMap< QString, QByteArray >(), name ) );
+
+    QskGraphicArchive archive( name );
+
+    QVERIFY( archive.isOpen() );
+    QCOMPARE( archive.count(), 0 );
+    QVERIFY( !archive.contains( QStringLiteral( "a" ) ) );
+}
+
+void GraphicArchiveTest::truncated()
+{
+    // the data of the last graphic ends with the file
+
+    const WarningsBlocker blocker;
+
+    QFile file( m_archive );
+    QVERIFY( file.open( QIODevice::ReadOnly ) );
+
+    const auto data = file.readAll();
+    const auto name = fileName( QStringLiteral( "truncated.qsa" ) );
+
+    for ( int size = 0; size < data.size(); size++ )
+    {
+        QFile truncatedFile( name );
+        QVERIFY( truncatedFile.open( QIODevice::WriteOnly | QIODevice::Truncate ) );
+        QCOMPARE( truncatedFile.write( data.constData(), size ), qint64( size ) );
+        truncatedFile.close();
+
+        QskGraphicArchive archive;
+        QVERIFY2( !archive.open( name ), qPrintable( QString::number( size ) ) );
+        QVERIFY( !archive.isOpen() );
+    }
+}
+
+void GraphicArchiveTest::misalignedEntry()
+{
+    /*
+        An entry, that refers to data at an odd position, is read
+        from a copy and has to be rejected as it does not start
+        with a valid header.
+     */
+    const WarningsBlocker blocker;
+
+    QFile file( m_archive );
+    QVERIFY( file.open( QIODevice::ReadOnly ) );
+
+    auto data = file.readAll();
+
+    // header: 16 bytes, entries: 32 bytes with the data offset at 8
+
+    quint64 dataOffset, dataSize;
+    memcpy( &dataOffset, data.constData() + 16 + 8, 8 );
+    memcpy( &dataSize, data.constData() + 16 + 16, 8 );
+
+    dataOffset += 1;
+    dataSize -= 1;
+
+    memcpy( data.data() + 16 + 8, &dataOffset, 8 );
+    memcpy( data.data() + 16 + 16, &dataSize, 8 );
+
+    const auto name = fileName( QStringLiteral( "misaligned.qsa" ) );
+
+    QFile misalignedFile( name );
+    QVERIFY( misalignedFile.open( QIODevice::WriteOnly | QIODevice::Truncate ) );
+    QCOMPARE( misalignedFile.write( data ), qint64( data.size() ) );
+    misalignedFile.close();
+
+    QskGraphicArchive archive( name );
+    QVERIFY( archive.isOpen() );
+
+    const auto names = archive.names();
+    QVERIFY( archive.graphic( names.first() ).isNull() );
+
+    for ( int i = 1; i < names.count(); i++ )
+        QVERIFY( archive.graphic( names[ i ] ) == m_graphics[ names[ i ] ] );
+}
+
+QTEST_MAIN( GraphicArchiveTest )
+
+#include "GraphicArchiveTest.moc"
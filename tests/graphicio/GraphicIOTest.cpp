@@ -0,0 +1,297 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include <QskGraphic.h>
+#include <QskGraphicIO.h>
+#include <QskPainterCommand.h>
+
+#include <qfile.h>
+#include <qimage.h>
+#include <qpainter.h>
+#include <qpainterpath.h>
+#include <qpixmap.h>
+#include <qtemporarydir.h>
+#include <qtest.h>
+
+#include <WarningsBlocker.h>
+
+Q_DECLARE_METATYPE( QskGraphicIO::Version )
+
+static QImage qskImage( QImage::Format format )
+{
+    QImage image( 7, 5, format ); // odd width: padded scanlines
+
+    for ( int y = 0; y < image.height(); y++ )
+    {
+        for ( int x = 0; x < image.width(); x++ )
+            image.setPixelColor( x, y, QColor( 30 * x, 50 * y, 100, 200 ) );
+    }
+
+    return image;
+}
+
+static QskGraphic qskGraphic()
+{
+    QskGraphic graphic;
+
+    QPainter painter( &graphic );
+    painter.setRenderHint( QPainter::Antialiasing, true );
+
+    painter.setPen( QPen( Qt::red, 2.0 ) );
+    painter.setBrush( Qt::blue );
+    painter.drawRect( QRectF( 10, 10, 50, 30 ) );
+
+    QPainterPath path;
+    path.moveTo( 0, 0 );
+    path.cubicTo( 20, 80, 50, -20, 100, 40 );
+    path.closeSubpath();
+    path.addEllipse( QRectF( 60, 60, 20, 10 ) );
+    path.setFillRule( Qt::WindingFill );
+
+    // stored in the extension
+    QPen pen( Qt::darkGreen, 3.0, Qt::DashDotLine, Qt::RoundCap, Qt::BevelJoin );
+    pen.setDashOffset( 2.0 );
+    painter.setPen( pen );
+
+    QLinearGradient gradient( 0, 0, 100, 0 );
+    gradient.setColorAt( 0.0, Qt::yellow );
+    gradient.setColorAt( 1.0, Qt::magenta );
+    painter.setBrush( gradient );
+
+    painter.setTransform( QTransform::fromTranslate( 5, 7 ).rotate( 10 ) );
+    painter.setClipRect( QRectF( 0, 0, 90, 90 ) );
+    painter.setOpacity( 0.7 );
+
+    painter.drawPath( path );
+
+    painter.setClipping( false );
+    painter.resetTransform();
+
+    painter.drawImage( QRectF( 20, 20, 14, 10 ), qskImage( QImage::Format_ARGB32 ) );
+    painter.drawImage( QPointF( 40, 40 ), qskImage( QImage::Format_RGB888 ) );
+
+    painter.end();
+
+    graphic.setViewBox( QRectF( -5, -5, 110, 110 ) );
+
+    return graphic;
+}
+
+static QByteArray qskWrite( const QskGraphic& graphic, QskGraphicIO::Version version )
+{
+    QByteArray data;
+    QskGraphicIO::write( graphic, data, version );
+
+    return data;
+}
+
+class GraphicIOTest : public QObject
+{
+    Q_OBJECT
+
+  private Q_SLOTS:
+    void roundTrip_data();
+    void roundTrip();
+
+    void roundTripFile_data();
+    void roundTripFile();
+
+    void defaultVersion();
+    void rasterFile();
+
+    void pixmap_data();
+    void pixmap();
+
+    void misaligned();
+    void truncated();
+    void corruptedHeader();
+};
+
+void GraphicIOTest::roundTrip_data()
+{
+    QTest::addColumn< QskGraphicIO::Version >( "version" );
+
+    QTest::newRow( "v1" ) << QskGraphicIO::Version1;
+    QTest::newRow( "v2" ) << QskGraphicIO::Version2;
+}
+
+void GraphicIOTest::roundTrip()
+{
+    QFETCH( QskGraphicIO::Version, version );
+
+    const auto graphic = qskGraphic();
+    const auto data = qskWrite( graphic, version );
+
+    QVERIFY( !data.isEmpty() );
+
+    const auto graphic2 = QskGraphicIO::read( data );
+
+    QVERIFY( !graphic2.isNull() );
+    QCOMPARE( graphic2.commands().count(), graphic.commands().count() );
+    QVERIFY( graphic2 == graphic );
+}
+
+void GraphicIOTest::roundTripFile_data()
+{
+    roundTrip_data();
+}
+
+void GraphicIOTest::roundTripFile()
+{
+    QFETCH( QskGraphicIO::Version, version );
+
+    QTemporaryDir dir;
+    QVERIFY( dir.isValid() );
+
+    const auto fileName = dir.filePath( QStringLiteral( "test.qvg" ) );
+
+    const auto graphic = qskGraphic();
+    QVERIFY( QskGraphicIO::write( graphic, fileName, version ) );
+
+    const auto graphic2 = QskGraphicIO::read( fileName );
+    QVERIFY( graphic2 == graphic );
+}
+
+void GraphicIOTest::defaultVersion()
+{
+    // Version2 is opt-in
+
+    QByteArray data;
+    QVERIFY( QskGraphicIO::write( qskGraphic(), data ) );
+
+    QVERIFY( data.startsWith( "QSKG" ) );
+    QVERIFY( qskWrite( qskGraphic(), QskGraphicIO::Version2 ).startsWith( "QSK2" ) );
+}
+
+void GraphicIOTest::rasterFile()
+{
+    /*
+        v2 files are memory mapped, but graphics with raster data
+        must not depend on the file, after it has been read.
+     */
+    QTemporaryDir dir;
+    QVERIFY( dir.isValid() );
+
+    const auto fileName = dir.filePath( QStringLiteral( "raster.qvg" ) );
+
+    const auto graphic = qskGraphic();
+    QVERIFY( QskGraphicIO::write( graphic, fileName, QskGraphicIO::Version2 ) );
+
+    const auto graphic2 = QskGraphicIO::read( fileName );
+
+    {
+        QFile file( fileName );
+        QVERIFY( file.open( QIODevice::WriteOnly | QIODevice::Truncate ) );
+    }
+
+    QVERIFY( QFile::remove( fileName ) );
+    QVERIFY( graphic2 == graphic );
+}
+
+void GraphicIOTest::pixmap_data()
+{
+    roundTrip_data();
+}
+
+void GraphicIOTest::pixmap()
+{
+    // QPixmap::operator== compares the cache keys only
+
+    QFETCH( QskGraphicIO::Version, version );
+
+    const auto image = qskImage( QImage::Format_ARGB32_Premultiplied );
+
+    const auto graphic = QskGraphic::fromPixmap( QPixmap::fromImage( image ) );
+    const auto graphic2 = QskGraphicIO::read( qskWrite( graphic, version ) );
+
+    const auto& commands = graphic2.commands();
+
+    QCOMPARE( commands.count(), 1 );
+    QCOMPARE( commands[ 0 ].type(), QskPainterCommand::Pixmap );
+    QCOMPARE( commands[ 0 ].pixmapData()->pixmap.toImage(),
+        graphic.commands()[ 0 ].pixmapData()->pixmap.toImage() );
+}
+
+void GraphicIOTest::misaligned()
+{
+    const auto graphic = qskGraphic();
+    const auto data = qskWrite( graphic, QskGraphicIO::Version2 );
+
+    // a buffer with a known alignment of 8 bytes
+    QVector< quint64 > buffer( data.size() / 8 + 2 );
+
+    for ( int offset = 0; offset < 8; offset++ )
+    {
+        auto bytes = reinterpret_cast< char* >( buffer.data() ) + offset;
+        memcpy( bytes, data.constData(), data.size() );
+
+        const auto graphic2 = QskGraphicIO::read(
+            reinterpret_cast< const uchar* >( bytes ), data.size(), nullptr );
+
+        QVERIFY2( graphic2 == graphic, qPrintable( QString::number( offset ) ) );
+
+        const auto graphic3 = QskGraphicIO::read(
+            QByteArray::fromRawData( bytes, data.size() ) );
+
+        QVERIFY2( graphic3 == graphic, qPrintable( QString::number( offset ) ) );
+    }
+}
+
+void GraphicIOTest::truncated()
+{
+    /*
+        Truncated data has to be rejected, unless only
+        trailing padding has been removed
+     */
+
+    const WarningsBlocker blocker;
+
+    const auto graphic = qskGraphic();
+    const auto data = qskWrite( graphic, QskGraphicIO::Version2 );
+
+    QVector< quint64 > buffer( data.size() / 8 + 1 );
+    memcpy( buffer.data(), data.constData(), data.size() );
+
+    const auto bytes = reinterpret_cast< const uchar* >( buffer.constData() );
+
+    for ( int size = 0; size < data.size(); size++ )
+    {
+        const auto graphic2 = QskGraphicIO::read( bytes, size, nullptr );
+        QVERIFY2( graphic2.isNull() || graphic2 == graphic,
+            qPrintable( QString::number( size ) ) );
+
+        const auto graphic3 = QskGraphicIO::read( data.left( size ) );
+        QVERIFY2( graphic3.isNull() || graphic3 == graphic,
+            qPrintable( QString::number( size ) ) );
+    }
+}
+
+void GraphicIOTest::corruptedHeader()
+{
+    // sections, counts and offsets pointing outside of the data
+
+    const WarningsBlocker blocker;
+
+    const auto data = qskWrite( qskGraphic(), QskGraphicIO::Version2 );
+
+    const int headerSize = 144;
+    QVERIFY( data.size() > headerSize );
+
+    for ( int i = 4; i < headerSize; i++ )
+    {
+        for ( const char mask : { '\x01', '\x80', '\xff' } )
+        {
+            auto corrupted = data;
+            corrupted[ i ] = corrupted[ i ] ^ mask;
+
+            // anything but crashing
+            ( void ) QskGraphicIO::read( corrupted );
+        }
+    }
+}
+
+QTEST_MAIN( GraphicIOTest )
+
+#include "GraphicIOTest.moc"
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include <QskControl.h>
+#include <QskGridBox.h>
+
+#include <TestSkin.h>
+
+#include <qtest.h>
+
+class GridBoxTest : public QObject
+{
+    Q_OBJECT
+
+  private Q_SLOTS:
+    void initTestCase();
+
+    void sizeHintChange();
+    void ignoredElement();
+};
+
+void GridBoxTest::initTestCase()
+{
+    TestSkin::install();
+}
+
+void GridBoxTest::sizeHintChange()
+{
+    // the chains are updated incrementally
+
+    QskGridBox box;
+    box.setSpacing( 0.0 );
+
+    auto control1 = new QskControl();
+    control1->setPreferredSize( 50.0, 30.0 );
+
+    auto control2 = new QskControl();
+    control2->setPreferredSize( 40.0, 20.0 );
+
+    box.addItem( control1, 0, 0 );
+    box.addItem( control2, 1, 0 );
+
+    QCOMPARE( box.sizeHint(), QSizeF( 50.0, 50.0 ) );
+
+    control2->setPreferredSize( 60.0, 20.0 );
+    QCOMPARE( box.sizeHint(), QSizeF( 60.0, 50.0 ) );
+
+    control1->setPreferredSize( 50.0, 10.0 );
+    QCOMPARE( box.sizeHint(), QSizeF( 60.0, 30.0 ) );
+}
+
+void GridBoxTest::ignoredElement()
+{
+    // an element, that is ignored, must not reserve its row/column anymore
+
+    QskGridBox box;
+    box.setSpacing( 0.0 );
+
+    auto control1 = new QskControl();
+    control1->setPreferredSize( 50.0, 30.0 );
+
+    auto control2 = new QskControl();
+    control2->setPreferredSize( 40.0, 20.0 );
+
+    box.addItem( control1, 0, 0 );
+    box.addItem( control2, 1, 1 );
+
+    QCOMPARE( box.sizeHint(), QSizeF( 90.0, 50.0 ) );
+
+    control2->setPlacementPolicy(
+        QskPlacementPolicy::Ignore, QskPlacementPolicy::Ignore );
+
+    QCOMPARE( box.sizeHint(), QSizeF( 50.0, 30.0 ) );
+
+    control2->resetPlacementPolicy();
+    QCOMPARE( box.sizeHint(), QSizeF( 90.0, 50.0 ) );
+}
+
+QTEST_MAIN( GridBoxTest )
+
+#include "GridBoxTest.moc"
@@ -0,0 +1,440 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include <QskSkinHintTable.h>
+#include <QskSkinHintTableIO.h>
+#include <QskPushButton.h>
+#include <QskControl.h>
+#include <QskBoxShapeMetrics.h>
+#include <QskMargins.h>
+#include <QskPlatform.h>
+
+#include <qbuffer.h>
+#include <qcolor.h>
+#include <qsize.h>
+#include <qtest.h>
+
+namespace
+{
+    constexpr int hintCount = 1000;
+
+    /*
+        Aspects with small subcontrol and primitive values, like in a real
+        skin. With a load factor below 0.5 many of them collide.
+     */
+    QskAspect testAspect( int i )
+    {
+        const auto subControl = static_cast< QskAspect::Subcontrol >( i % 50 + 1 );
+        const auto primitive = static_cast< QskAspect::Primitive >( i / 50 + 1 );
+
+        return QskAspect( subControl ) | QskAspect::Metric | primitive;
+    }
+
+    // values of all types of slots
+    QVariant testValue( int i )
+    {
+        switch ( i % 5 )
+        {
+            case 0:
+                return QVariant::fromValue( qreal( i ) );
+
+            case 1:
+                return QVariant::fromValue( QColor( QRgb( 0xff000000 | i ) ) );
+
+            case 2:
+                return QVariant::fromValue( QSizeF( i, 2 * i ) );
+
+            case 3:
+                return QVariant::fromValue( QskMargins( i ) );
+
+            default:
+                return QVariant::fromValue( i ); // a QVariant slot
+        }
+    }
+
+    QskSkinHintTable testTable( int count )
+    {
+        QskSkinHintTable table;
+
+        for ( int i = 0; i < count; i++ )
+            table.setHint( testAspect( i ), testValue( i ) );
+
+        return table;
+    }
+
+    QskAspect metricAspect( QskAspect::Subcontrol subControl )
+    {
+        return subControl | QskAspect::Metric | QskAspect::Size;
+    }
+}
+
+class HintTableTest : public QObject
+{
+    Q_OBJECT
+
+  private Q_SLOTS:
+    void insertModifyRemove();
+    void removeAndReinsert();
+    void typedValues();
+    void resolveStates();
+    void resolveVariation();
+    void resolveSection();
+    void resolutionAfterModification();
+    void references();
+    void copyAndDetach();
+    void writeRead();
+    void convertedUnits();
+};
+
+void HintTableTest::insertModifyRemove()
+{
+    QskSkinHintTable table;
+    QVERIFY( !table.hasHints() );
+
+    const auto aspect = metricAspect( QskControl::Background );
+
+    QVERIFY( table.setHint( aspect, 10.0 ) );
+    QVERIFY( table.hasHint( aspect ) );
+    QCOMPARE( table.hint< qreal >( aspect ), 10.0 );
+
+    // setting the same value again is no modification
+    QVERIFY( !table.setHint( aspect, 10.0 ) );
+
+    QVERIFY( table.setHint( aspect, 20.0 ) );
+    QCOMPARE( table.hint< qreal >( aspect ), 20.0 );
+    QCOMPARE( table.hints().size(), 1 );
+
+    QCOMPARE( table.takeHint( aspect ).value< qreal >(), 20.0 );
+    QVERIFY( !table.hasHint( aspect ) );
+    QVERIFY( !table.hasHints() );
+
+    QVERIFY( !table.removeHint( aspect ) );
+}
+
+void HintTableTest::removeAndReinsert()
+{
+    auto table = testTable( hintCount );
+    QCOMPARE( table.hints().size(), hintCount );
+
+    // removing entries in the middle of the probe sequences
+
+    for ( int i = 0; i < hintCount; i += 3 )
+        QVERIFY( table.removeHint( testAspect( i ) ) );
+
+    for ( int i = 0; i < hintCount; i++ )
+    {
+        const auto aspect = testAspect( i );
+
+        if ( i % 3 == 0 )
+        {
+            QVERIFY( !table.hasHint( aspect ) );
+        }
+        else
+        {
+            QVERIFY( table.hasHint( aspect ) );
+            QCOMPARE( table.hint< QVariant >( aspect ), testValue( i ) );
+        }
+    }
+
+    for ( int i = 0; i < hintCount; i += 3 )
+        QVERIFY( table.setHint( testAspect( i ), testValue( i ) ) );
+
+    QCOMPARE( table.hints().size(), hintCount );
+
+    for ( int i = 0; i < hintCount; i++ )
+        QCOMPARE( table.hint< QVariant >( testAspect( i ) ), testValue( i ) );
+}
+
+void HintTableTest::typedValues()
+{
+    auto table = testTable( 10 );
+
+    // changing the type of a hint moves it to another array
+    QVERIFY( table.setHint( testAspect( 0 ), QColor( Qt::red ) ) );
+    QVERIFY( table.setHint( testAspect( 1 ), QSizeF( 1.0, 2.0 ) ) );
+
+    // a color, that can't be stored as QRgb
+    const auto hsv = QColor::fromHsvF( 0.5, 0.25, 0.75 );
+    QVERIFY( table.setHint( testAspect( 2 ), hsv ) );
+
+    QCOMPARE( table.hint< QColor >( testAspect( 0 ) ), QColor( Qt::red ) );
+    QCOMPARE( table.hint< QSizeF >( testAspect( 1 ) ), QSizeF( 1.0, 2.0 ) );
+    QCOMPARE( table.hint< QColor >( testAspect( 2 ) ).spec(), QColor::Hsv );
+    QCOMPARE( table.hint< QColor >( testAspect( 2 ) ), hsv );
+
+    // the last values of the arrays are moved into the gaps
+    QVERIFY( table.removeHint( testAspect( 5 ) ) );
+    QVERIFY( table.removeHint( testAspect( 8 ) ) );
+
+    for ( int i = 3; i < 10; i++ )
+    {
+        if ( i != 5 && i != 8 )
+            QCOMPARE( table.hint< QVariant >( testAspect( i ) ), testValue( i ) );
+    }
+}
+
+void HintTableTest::resolveStates()
+{
+    QskSkinHintTable table;
+
+    const auto aspect = metricAspect( QskControl::Background );
+
+    table.setHint( aspect, 1.0 );
+    table.setHint( aspect | QskAbstractButton::Pressed, 2.0 );
+
+    QskAspect resolved;
+
+    QCOMPARE( table.resolvedValue( aspect, &resolved ).value< qreal >(), 1.0 );
+    QCOMPARE( resolved, aspect );
+
+    // states are dropped one by one, starting with the top state
+
+    const auto hoveredPressed = aspect | QskControl::Hovered | QskAbstractButton::Pressed;
+
+    QCOMPARE( table.resolvedValue( hoveredPressed, &resolved ).value< qreal >(), 2.0 );
+    QCOMPARE( resolved, aspect | QskAbstractButton::Pressed );
+
+    QCOMPARE( table.resolvedHint( aspect | QskControl::Hovered )->value< qreal >(), 1.0 );
+    QCOMPARE( table.resolvedAspect( aspect | QskControl::Hovered ), aspect );
+
+    bool ok = true;
+    table.resolvedValue( metricAspect( QskPushButton::Panel ), nullptr, &ok );
+    QVERIFY( !ok );
+    QVERIFY( table.resolvedHint( metricAspect( QskPushButton::Panel ) ) == nullptr );
+}
+
+void HintTableTest::resolveVariation()
+{
+    QskSkinHintTable table;
+
+    const auto aspect = metricAspect( QskControl::Background );
+
+    table.setHint( aspect, 1.0 );
+    table.setHint( aspect | QskAspect::Large | QskControl::Hovered, 2.0 );
+
+    QCOMPARE( table.resolvedValue( aspect | QskAspect::Large | QskControl::Hovered ).value< qreal >(), 2.0 );
+
+    // the states are dropped first, then the variation
+    QCOMPARE( table.resolvedValue( aspect | QskAspect::Large ).value< qreal >(), 1.0 );
+    QCOMPARE( table.resolvedValue( aspect | QskAspect::Small | QskControl::Hovered ).value< qreal >(), 1.0 );
+}
+
+void HintTableTest::resolveSection()
+{
+    QskSkinHintTable table;
+
+    const auto aspect = metricAspect( QskControl::Background );
+
+    table.setHint( aspect, 1.0 );
+    table.setHint( aspect | QskAspect::Large, 2.0 );
+    table.setHint( aspect | QskAspect::Header, 3.0 );
+
+    QCOMPARE( table.resolvedValue( aspect | QskAspect::Header ).value< qreal >(), 3.0 );
+
+    // falling back to the body, keeping the variation
+    QskAspect resolved;
+    QCOMPARE( table.resolvedValue( aspect | QskAspect::Footer | QskAspect::Large,
+        &resolved ).value< qreal >(), 2.0 );
+    QCOMPARE( resolved, aspect | QskAspect::Large );
+
+    QCOMPARE( table.resolvedValue( aspect | QskAspect::Footer ).value< qreal >(), 1.0 );
+}
+
+void HintTableTest::resolutionAfterModification()
+{
+    // large enough for having a resolution cache
+    auto table = testTable( 100 );
+
+    const auto aspect = metricAspect( QskControl::Background );
+    const auto hovered = aspect | QskControl::Hovered;
+
+    table.setHint( aspect, 1.0 );
+
+    // the state has to be known to the table
+    table.setHint( metricAspect( QskPushButton::Panel ) | QskControl::Hovered, 0.0 );
+
+    QCOMPARE( table.resolvedValue( hovered ).value< qreal >(), 1.0 );
+
+    table.setHint( aspect, 2.0 );
+    QCOMPARE( table.resolvedValue( hovered ).value< qreal >(), 2.0 );
+
+    table.setHint( hovered, 3.0 );
+    QCOMPARE( table.resolvedValue( hovered ).value< qreal >(), 3.0 );
+    QCOMPARE( table.resolvedAspect( hovered ), hovered );
+
+    // inserting other hints moves nothing
+    for ( int i = 100; i < 200; i++ )
+        table.setHint( testAspect( i ), testValue( i ) );
+
+    QCOMPARE( table.resolvedValue( hovered ).value< qreal >(), 3.0 );
+
+    table.removeHint( hovered );
+    QCOMPARE( table.resolvedValue( hovered ).value< qreal >(), 2.0 );
+    QCOMPARE( table.resolvedAspect( hovered ), aspect );
+
+    // the removed entry has been replaced by the last one
+    table.removeHint( testAspect( 0 ) );
+    QCOMPARE( table.resolvedValue( testAspect( 199 ) ), testValue( 199 ) );
+
+    table.removeHint( aspect );
+    QVERIFY( table.resolvedHint( hovered ) == nullptr );
+}
+
+void HintTableTest::references()
+{
+    auto table = testTable( 100 );
+
+    const auto aspect = testAspect( 50 );
+
+    const auto& value = table.hint( aspect );
+    const auto& hints = table.hints();
+
+    QCOMPARE( value, testValue( 50 ) );
+
+    // unrelated modifications
+
+    for ( int i = 100; i < 1000; i++ )
+        table.setHint( testAspect( i ), testValue( i ) );
+
+    table.removeHint( testAspect( 10 ) );
+
+    QCOMPARE( value, testValue( 50 ) );
+    QCOMPARE( hints.size(), 999 );
+
+    // modifying the hint itself updates the referenced value
+
+    table.setHint( aspect, 77.0 );
+
+    QCOMPARE( value.value< qreal >(), 77.0 );
+    QCOMPARE( hints.value( aspect ).value< qreal >(), 77.0 );
+
+    QCOMPARE( table.resolvedHint( aspect ), &value );
+}
+
+void HintTableTest::copyAndDetach()
+{
+    const auto table1 = testTable( 100 );
+    auto table2 = table1;
+
+    QVERIFY( table2.isSharedWith( table1 ) );
+
+    // setting the same value does not detach
+    QVERIFY( !table2.setHint( testAspect( 5 ), testValue( 5 ) ) );
+    QVERIFY( table2.isSharedWith( table1 ) );
+
+    QVERIFY( table2.setHint( testAspect( 5 ), 42.0 ) );
+    QVERIFY( !table2.isSharedWith( table1 ) );
+
+    QCOMPARE( table1.hint< QVariant >( testAspect( 5 ) ), testValue( 5 ) );
+    QCOMPARE( table2.hint< qreal >( testAspect( 5 ) ), 42.0 );
+
+    auto table3 = table1;
+    QVERIFY( table3.removeHint( testAspect( 7 ) ) );
+
+    QVERIFY( table1.hasHint( testAspect( 7 ) ) );
+    QVERIFY( !table3.hasHint( testAspect( 7 ) ) );
+
+    QCOMPARE( table1.hints().size(), 100 );
+    QCOMPARE( table3.hints().size(), 99 );
+
+    for ( int i = 0; i < 100; i++ )
+    {
+        if ( i != 7 )
+            QCOMPARE( table3.hint< QVariant >( testAspect( i ) ), testValue( i ) );
+    }
+
+    table3.clear();
+    QVERIFY( !table3.hasHints() );
+    QVERIFY( table1.hasHint( testAspect( 7 ) ) );
+}
+
+void HintTableTest::writeRead()
+{
+    const auto panel = QskPushButton::Panel;
+    const auto text = QskPushButton::Text;
+
+    const auto alignmentAspect = text | QskAspect::Flag | QskAspect::Alignment;
+
+    QskSkinHintTable table;
+    table.setHint( metricAspect( panel ), 10.0 );
+    table.setHint( metricAspect( text ) | QskPushButton::Pressed, QSizeF( 20, 30 ) );
+    table.setHint( panel | QskAspect::Metric | QskAspect::Padding,
+        QskMargins( 1, 2, 3, 4 ) );
+    table.setHint( panel | QskAspect::Metric | QskAspect::Shape,
+        QskBoxShapeMetrics( 5, 6, 7, 8 ) );
+    table.setHint( panel | QskAspect::Color, QColor( Qt::red ) );
+
+    // like QskSkinHintTableEditor::setAlignment
+    table.setHint( alignmentAspect, static_cast< int >( Qt::AlignRight ) );
+
+    QByteArray data;
+    QVERIFY( QskSkinHintTableIO::write( table, data ) );
+
+    QskSkinHintTable table2;
+    QVERIFY( QskSkinHintTableIO::read( data, table2 ) );
+
+    QCOMPARE( table2.hints().size(), table.hints().size() );
+
+    const auto& hints = table.hints();
+    for ( auto it = hints.constBegin(); it != hints.constEnd(); ++it )
+        QCOMPARE( table2.hint< QVariant >( it.key() ), it.value() );
+
+    QCOMPARE( table2.hint< int >( alignmentAspect ),
+        static_cast< int >( Qt::AlignRight ) );
+}
+
+void HintTableTest::convertedUnits()
+{
+    /*
+        table has been created with dp/px factors of 1.0, probeTable with
+        ProbeDpFactor/ProbePxFactor: all lengths, that differ by
+        one of the factors, are converted when being read.
+     */
+    const auto dp = QskSkinHintTableIO::ProbeDpFactor;
+    const auto px = QskSkinHintTableIO::ProbePxFactor;
+
+    const auto panel = QskPushButton::Panel;
+
+    const auto sizeAspect = metricAspect( panel );
+    const auto paddingAspect = panel | QskAspect::Metric | QskAspect::Padding;
+    const auto spacingAspect = panel | QskAspect::Metric | QskAspect::Spacing;
+    const auto colorAspect = panel | QskAspect::Color;
+
+    QskSkinHintTable table;
+    table.setHint( sizeAspect, QSizeF( 10, 20 ) );
+    table.setHint( paddingAspect, QskMargins( 1, 2, 3, 4 ) );
+    table.setHint( spacingAspect, 5.0 );
+    table.setHint( colorAspect, QColor( Qt::blue ) );
+
+    QskSkinHintTable probeTable;
+    probeTable.setHint( sizeAspect, QSizeF( 10 * dp, 20 ) ); // dp, absolute
+    probeTable.setHint( paddingAspect, QskMargins( 1 * px, 2 * px, 3 * dp, 4 ) );
+    probeTable.setHint( spacingAspect, 5.0 * dp );
+    probeTable.setHint( colorAspect, QColor( Qt::blue ) );
+
+    QByteArray data;
+
+    {
+        QBuffer buffer( &data );
+        QVERIFY( buffer.open( QIODevice::WriteOnly ) );
+        QVERIFY( QskSkinHintTableIO::write( table, probeTable, &buffer ) );
+    }
+
+    QskSkinHintTable table2;
+    QVERIFY( QskSkinHintTableIO::read( data, table2 ) );
+
+    const auto dpFactor = qskDpToPixelsFactor();
+    const auto pxFactor = qskPxToPixelsFactor();
+
+    QCOMPARE( table2.hint< QSizeF >( sizeAspect ), QSizeF( 10 * dpFactor, 20 ) );
+    QCOMPARE( table2.hint< QskMargins >( paddingAspect ),
+        QskMargins( 1 * pxFactor, 2 * pxFactor, 3 * dpFactor, 4 ) );
+    QCOMPARE( table2.hint< qreal >( spacingAspect ), 5.0 * dpFactor );
+    QCOMPARE( table2.hint< QColor >( colorAspect ), QColor( Qt::blue ) );
+}
+
+QTEST_MAIN( HintTableTest )
+
+#include "HintTableTest.moc"
@@ -0,0 +1,164 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include <QskItemView.h>
+
+#include <TestSkin.h>
+
+#include <qmath.h>
+#include <qquickitem.h>
+#include <qtest.h>
+
+namespace
+{
+    class ItemView : public QskItemView
+    {
+      public:
+        ItemView()
+        {
+            setSize( QSizeF( 100.0, 200.0 ) );
+        }
+
+        void setRowCount( int count )
+        {
+            m_rowCount = count;
+            reset();
+        }
+
+        void layout()
+        {
+            // no window, no polishing
+            updateLayout();
+        }
+
+        int maximumDelegateCount() const
+        {
+            // rows intersecting the viewport at any scroll position + overscan
+            const auto rows = qCeil( viewContentsRect().height() / rowHeight() ) + 1;
+            return rows + 2 * overscan();
+        }
+
+        int rowCount() const override { return m_rowCount; }
+        qreal rowHeight() const override { return 20.0; }
+
+        int boundRow( const QQuickItem* delegate ) const
+        {
+            return delegate->property( "row" ).toInt();
+        }
+
+      protected:
+        QQuickItem* createDelegate() override
+        {
+            return new QQuickItem();
+        }
+
+        void bindDelegate( QQuickItem* delegate, int row ) override
+        {
+            delegate->setProperty( "row", row );
+        }
+
+      private:
+        int m_rowCount = 0;
+    };
+}
+
+static void qskVerifyDelegates( const ItemView& view )
+{
+    QVERIFY( view.delegateCount() > 0 );
+    QVERIFY( view.delegateCount() <= view.maximumDelegateCount() );
+
+    const auto viewHeight = view.viewContentsRect().height();
+
+    const int from = int( view.scrollPos().y() / view.rowHeight() );
+    const int to = qMin( int( ( view.scrollPos().y() + viewHeight ) / view.rowHeight() ),
+        view.rowCount() - 1 );
+
+    for ( int row = from; row <= to; row++ )
+    {
+        const auto delegate = view.delegateAt( row );
+
+        QVERIFY( delegate != nullptr );
+        QVERIFY( delegate->isVisible() );
+
+        QCOMPARE( view.rowOf( delegate ), row );
+        QCOMPARE( view.boundRow( delegate ), row );
+    }
+}
+
+class ItemViewTest : public QObject
+{
+    Q_OBJECT
+
+  private Q_SLOTS:
+    void initTestCase();
+
+    void scrolling();
+    void reset();
+};
+
+void ItemViewTest::initTestCase()
+{
+    TestSkin::install();
+}
+
+void ItemViewTest::scrolling()
+{
+    ItemView view;
+    view.setRowCount( 1000 );
+    view.layout();
+
+    qskVerifyDelegates( view );
+
+    const auto maxY = view.scrollableSize().height() - view.viewContentsRect().height();
+    QVERIFY( maxY > 0.0 );
+
+    for ( qreal y = 0.0; y <= maxY; y += 7.0 )
+    {
+        view.setScrollPos( QPointF( 0.0, y ) );
+        qskVerifyDelegates( view );
+    }
+
+    // jumping back
+    view.setScrollPos( QPointF() );
+    qskVerifyDelegates( view );
+
+    QCOMPARE( view.rowOf( nullptr ), -1 );
+    QVERIFY( view.delegateAt( view.rowCount() - 1 ) == nullptr );
+}
+
+void ItemViewTest::reset()
+{
+    ItemView view;
+    view.setRowCount( 1000 );
+    view.layout();
+
+    view.setScrollPos( QPointF( 0.0, 5000.0 ) );
+    qskVerifyDelegates( view );
+
+    const auto count = view.delegateCount();
+
+    // fewer rows: the delegates are kept in the pool
+
+    view.setRowCount( 3 );
+    view.layout();
+
+    QCOMPARE( view.scrollPos(), QPointF() );
+    QCOMPARE( view.delegateCount(), count );
+
+    qskVerifyDelegates( view );
+    QVERIFY( view.delegateAt( 3 ) == nullptr );
+
+    // more rows again: the delegates of the pool are reused
+
+    view.setRowCount( 1000 );
+    view.layout();
+
+    qskVerifyDelegates( view );
+    QCOMPARE( view.delegateCount(), count );
+}
+
+QTEST_MAIN( ItemViewTest )
+
+#include "ItemViewTest.moc"
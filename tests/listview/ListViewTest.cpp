@@ -0,0 +1,198 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include <QskListView.h>
+
+#include <TestSkin.h>
+
+#include <qrandom.h>
+#include <qtest.h>
+
+namespace
+{
+    class ListView : public QskListView
+    {
+      public:
+        ListView()
+        {
+            setVariableRowHeights( true );
+        }
+
+        void setHeights( const QVector< qreal >& heights )
+        {
+            m_heights = heights;
+            updateScrollableSize();
+        }
+
+        void setHeightAt( int row, qreal height )
+        {
+            m_heights[ row ] = height;
+            updateRowHeights( row, row );
+        }
+
+        void appendHeight( qreal height )
+        {
+            m_heights += height;
+            updateRowHeights( m_heights.count() - 1, m_heights.count() - 1 );
+        }
+
+        int rowCount() const override { return m_heights.count(); }
+        int columnCount() const override { return 1; }
+
+        qreal columnWidth( int ) const override { return 100.0; }
+        qreal rowHeight() const override { return 20.0; }
+
+        qreal rowHeightAt( int row ) const override { return m_heights[ row ]; }
+
+        QVariant valueAt( int, int ) const override { return QVariant(); }
+
+      private:
+        QVector< qreal > m_heights;
+    };
+}
+
+static QVector< qreal > qskHeights( int count, quint32 seed, bool withHidden )
+{
+    /*
+        Integral values, so that the positions are exact and do not
+        depend on the order of the additions in the tree
+     */
+    QRandomGenerator generator( seed );
+
+    QVector< qreal > heights;
+    heights.reserve( count );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        if ( withHidden && ( i % 3 == 1 ) )
+            heights += 0.0;
+        else
+            heights += generator.bounded( 10, 50 );
+    }
+
+    return heights;
+}
+
+static void qskVerifyRows( const ListView& listView, const QVector< qreal >& heights )
+{
+    QCOMPARE( listView.rowCount(), heights.count() );
+
+    qreal pos = 0.0;
+
+    for ( int row = 0; row < heights.count(); row++ )
+    {
+        const auto h = heights[ row ];
+
+        QCOMPARE( listView.rowPosition( row ), pos );
+        QCOMPARE( listView.effectiveRowHeight( row ), h );
+
+        if ( h > 0.0 )
+        {
+            QCOMPARE( listView.rowAtPosition( pos ), row );
+            QCOMPARE( listView.rowAtPosition( pos + 0.5 * h ), row );
+            QCOMPARE( listView.rowAtPosition( pos + h - 0.5 ), row );
+        }
+
+        pos += h;
+    }
+
+    QCOMPARE( listView.rowPosition( heights.count() ), pos );
+    QCOMPARE( listView.scrollableSize().height(), pos );
+
+    QCOMPARE( listView.rowAtPosition( -1.0 ), -1 );
+    QCOMPARE( listView.rowAtPosition( pos ), -1 );
+    QCOMPARE( listView.rowAtPosition( pos + 100.0 ), -1 );
+}
+
+class ListViewTest : public QObject
+{
+    Q_OBJECT
+
+  private Q_SLOTS:
+    void initTestCase();
+
+    void roundTrip_data();
+    void roundTrip();
+
+    void hiddenRows();
+    void updateRows();
+    void fixedHeights();
+};
+
+void ListViewTest::initTestCase()
+{
+    TestSkin::install();
+}
+
+void ListViewTest::roundTrip_data()
+{
+    QTest::addColumn< int >( "count" );
+
+    // covering trees of different depths and incomplete last levels
+    for ( const int count : { 0, 1, 2, 3, 7, 8, 9, 31, 32, 33, 1000 } )
+        QTest::addRow( "%d", count ) << count;
+}
+
+void ListViewTest::roundTrip()
+{
+    QFETCH( int, count );
+
+    const auto heights = qskHeights( count, count, false );
+
+    ListView listView;
+    listView.setHeights( heights );
+
+    qskVerifyRows( listView, heights );
+}
+
+void ListViewTest::hiddenRows()
+{
+    // rows with a height of 0 are never found by position
+
+    const auto heights = qskHeights( 100, 1, true );
+
+    ListView listView;
+    listView.setHeights( heights );
+
+    qskVerifyRows( listView, heights );
+}
+
+void ListViewTest::updateRows()
+{
+    auto heights = qskHeights( 100, 2, false );
+
+    ListView listView;
+    listView.setHeights( heights );
+
+    for ( const int row : { 0, 1, 50, 63, 64, 99 } )
+    {
+        heights[ row ] += 7.0;
+        listView.setHeightAt( row, heights[ row ] );
+
+        qskVerifyRows( listView, heights );
+    }
+
+    // appending rows rebuilds the tree
+    heights += 33.0;
+    listView.appendHeight( 33.0 );
+
+    qskVerifyRows( listView, heights );
+}
+
+void ListViewTest::fixedHeights()
+{
+    ListView listView;
+    listView.setHeights( qskHeights( 10, 3, false ) );
+    listView.setVariableRowHeights( false );
+
+    QCOMPARE( listView.rowPosition( 5 ), 5 * listView.rowHeight() );
+    QCOMPARE( listView.effectiveRowHeight( 5 ), listView.rowHeight() );
+    QCOMPARE( listView.rowAtPosition( 5.5 * listView.rowHeight() ), 5 );
+    QCOMPARE( listView.rowAtPosition( 10 * listView.rowHeight() ), -1 );
+}
+
+QTEST_MAIN( ListViewTest )
+
+#include "ListViewTest.moc"
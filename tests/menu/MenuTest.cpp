@@ -0,0 +1,151 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include <QskLabelData.h>
+#include <QskMenu.h>
+#include <QskSkinlet.h>
+
+#include <TestSkin.h>
+
+#include <qtest.h>
+
+/*
+    'o' for an option, '-' for a separator
+ */
+static void qskSetOptions( QskMenu& menu, const QString& pattern )
+{
+    QVector< QskLabelData > options;
+
+    for ( const auto c : pattern )
+    {
+        if ( c == QLatin1Char( '-' ) )
+            options += QskLabelData();
+        else
+            options += QskLabelData( QStringLiteral( "Option %1" ).arg( options.count() ) );
+    }
+
+    menu.setOptions( options );
+
+    // different heights for segments and separators
+    menu.setStrutSizeHint( QskMenu::Segment, -1.0, 30.0 );
+    menu.setMetric( QskMenu::Separator | QskAspect::Size, 3.0 );
+    menu.setMarginHint( QskMenu::Separator, 2.0 );
+}
+
+static void qskVerifySamples( const QskMenu& menu )
+{
+    using Q = QskMenu;
+
+    const auto skinlet = menu.effectiveSkinlet();
+    const auto contentsRect = menu.contentsRect();
+    const auto panelRect = menu.subControlContentsRect( Q::Panel );
+
+    const auto indexAt = [ & ]( qreal y )
+    {
+        const QPointF pos( panelRect.center().x(), y );
+        return skinlet->sampleIndexAt( &menu, contentsRect, Q::Segment, pos );
+    };
+
+    const auto actions = menu.actions();
+
+    for ( int i = 0; i < actions.count(); i++ )
+    {
+        const auto rect = skinlet->sampleRect( &menu, contentsRect, Q::Segment, i );
+        QVERIFY( rect.height() > 0.0 );
+
+        for ( const auto y : { rect.top(), rect.center().y(), rect.bottom() - 0.5 } )
+        {
+            const auto expected = panelRect.contains( panelRect.center().x(), y ) ? i : -1;
+            QCOMPARE( indexAt( y ), expected );
+        }
+    }
+
+    const auto separators = menu.separators();
+
+    for ( int i = 0; i < separators.count(); i++ )
+    {
+        const auto rect = skinlet->sampleRect( &menu, contentsRect, Q::Separator, i );
+        QVERIFY( rect.height() > 0.0 );
+
+        QCOMPARE( indexAt( rect.center().y() ), -1 );
+    }
+
+    QCOMPARE( indexAt( panelRect.top() - 1.0 ), -1 );
+    QCOMPARE( indexAt( panelRect.bottom() + 1.0 ), -1 );
+}
+
+class MenuTest : public QObject
+{
+    Q_OBJECT
+
+  private Q_SLOTS:
+    void initTestCase();
+
+    void sampleAt_data();
+    void sampleAt();
+
+    void sampleAtScrolled_data();
+    void sampleAtScrolled();
+};
+
+void MenuTest::initTestCase()
+{
+    TestSkin::install();
+}
+
+void MenuTest::sampleAt_data()
+{
+    QTest::addColumn< QString >( "pattern" );
+
+    QTest::newRow( "empty" ) << QString();
+    QTest::newRow( "separators" ) << QStringLiteral( "---" );
+    QTest::newRow( "single" ) << QStringLiteral( "o" );
+    QTest::newRow( "options" ) << QStringLiteral( "ooooooo" );
+    QTest::newRow( "leading" ) << QStringLiteral( "--ooo" );
+    QTest::newRow( "trailing" ) << QStringLiteral( "ooo--" );
+    QTest::newRow( "mixed" ) << QStringLiteral( "o-oo--ooo---o-o" );
+    QTest::newRow( "many" ) << QStringLiteral( "ooo-" ).repeated( 100 );
+}
+
+void MenuTest::sampleAt()
+{
+    QFETCH( QString, pattern );
+
+    QskMenu menu;
+    qskSetOptions( menu, pattern );
+
+    menu.setSize( QSizeF( 200.0, 100000.0 ) );
+
+    qskVerifySamples( menu );
+}
+
+void MenuTest::sampleAtScrolled_data()
+{
+    QTest::addColumn< qreal >( "scrollPosition" );
+
+    QTest::newRow( "top" ) << 0.0;
+    QTest::newRow( "segment" ) << 66.0;
+    QTest::newRow( "separator" ) << 121.0;
+    QTest::newRow( "bottom" ) << 100000.0;
+}
+
+void MenuTest::sampleAtScrolled()
+{
+    // samples, that have been scrolled out, are not found
+
+    QFETCH( qreal, scrollPosition );
+
+    QskMenu menu;
+    qskSetOptions( menu, QStringLiteral( "oo-o--oooo-o" ).repeated( 10 ) );
+
+    menu.setSize( QSizeF( 200.0, 200.0 ) );
+    menu.setScrollPosition( scrollPosition );
+
+    qskVerifySamples( menu );
+}
+
+QTEST_MAIN( MenuTest )
+
+#include "MenuTest.moc"
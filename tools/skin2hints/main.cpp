@@ -0,0 +1,142 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include <QskSkin.h>
+#include <QskSkinManager.h>
+#include <QskSkinHintTable.h>
+#include <QskSkinHintTableIO.h>
+
+#include <QGuiApplication>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QDebug>
+
+static void usage( const char* appName )
+{
+    qWarning() << "usage: " << appName << "[-probe] skinName light|dark hintsfile";
+}
+
+static bool createProbeTable( const QStringList& args, QskSkinHintTable& table )
+{
+    /*
+        The dp/px factors are cached, when being used for the first time.
+        So we need another process to create the skin with different
+        factors.
+     */
+
+    QTemporaryDir dir;
+    if ( !dir.isValid() )
+        return false;
+
+    const auto fileName = dir.filePath( QStringLiteral( "probe.hints" ) );
+
+    auto env = QProcessEnvironment::systemEnvironment();
+    env.insert( QStringLiteral( "QSK_DP_FACTOR" ),
+        QString::number( QskSkinHintTableIO::ProbeDpFactor ) );
+    env.insert( QStringLiteral( "QSK_PX_FACTOR" ),
+        QString::number( QskSkinHintTableIO::ProbePxFactor ) );
+
+    QProcess process;
+    process.setProcessEnvironment( env );
+    process.setProcessChannelMode( QProcess::ForwardedChannels );
+
+    process.start( QCoreApplication::applicationFilePath(),
+        QStringList { QStringLiteral( "-probe" ) } + args + QStringList { fileName } );
+
+    if ( !process.waitForFinished( -1 )
+        || process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0 )
+    {
+        qWarning() << "Creating the probe table failed";
+        return false;
+    }
+
+    return QskSkinHintTableIO::read( fileName, table );
+}
+
+int main( int argc, char* argv[] )
+{
+    const bool isProbe = ( argc == 5 ) && ( qstrcmp( argv[1], "-probe" ) == 0 );
+
+    if ( argc != ( isProbe ? 5 : 4 ) )
+    {
+        usage( argv[0] );
+        return -1;
+    }
+
+    const int argOffset = isProbe ? 2 : 1;
+
+    if ( !isProbe )
+    {
+        /*
+            Creating the table with dp/px factors of 1.0, so that
+            the dp/px based metrics are stored unconverted.
+         */
+        qputenv( "QSK_DP_FACTOR", "1" );
+        qputenv( "QSK_PX_FACTOR", "1" );
+    }
+
+    /*
+        Skins might depend on fonts and the platform theme,
+        so we need an application object
+     */
+    QGuiApplication app( argc, argv );
+
+    const QString skinName( argv[ argOffset ] );
+
+    QskSkin::ColorScheme colorScheme;
+
+    const QByteArray scheme( argv[ argOffset + 1 ] );
+    if ( scheme == "light" )
+    {
+        colorScheme = QskSkin::LightScheme;
+    }
+    else if ( scheme == "dark" )
+    {
+        colorScheme = QskSkin::DarkScheme;
+    }
+    else
+    {
+        usage( argv[0] );
+        return -1;
+    }
+
+    const auto skinNames = qskSkinManager->skinNames();
+    if ( !skinNames.contains( skinName, Qt::CaseInsensitive ) )
+    {
+        qWarning() << "Unknown skin:" << skinName
+            << ", available skins:" << skinNames;
+        return -2;
+    }
+
+    auto skin = qskSkinManager->createSkin( skinName, colorScheme );
+    if ( skin == nullptr )
+        return -2;
+
+    const QString fileName( argv[ argOffset + 2 ] );
+
+    bool ok;
+
+    if ( isProbe )
+    {
+        ok = QskSkinHintTableIO::write( skin->hintTable(), fileName );
+    }
+    else
+    {
+        /*
+            Subcontrols are looked up by name, when reading the probe table.
+            As the plugin of the skin has been loaded, its subcontrols
+            are known.
+         */
+        QskSkinHintTable probeTable;
+
+        ok = createProbeTable( { skinName, QString::fromUtf8( scheme ) }, probeTable );
+        if ( ok )
+            ok = QskSkinHintTableIO::write( skin->hintTable(), probeTable, fileName );
+    }
+
+    delete skin;
+
+    return ok ? 0 : -3;
+}
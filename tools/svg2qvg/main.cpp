@@ -10,19 +10,34 @@
 #include <QskPainterCommand.cpp>
 #include <QskGraphicPaintEngine.cpp>
 #include <QskGraphicIO.cpp>
+#include <QskGraphicArchive.cpp>
 #else
 #include <QskGraphicIO.h>
+#include <QskGraphicArchive.h>
 #include <QskGraphic.h>
 #endif
 
 #include <QGuiApplication>
 #include <QSvgRenderer>
+#include <QFontDatabase>
 #include <QPainter>
 #include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QAtomicInt>
+#include <QMap>
+#include <QVector>
 
 static void usage( const char* appName )
 {
-    qWarning() << "usage: " << appName << "svgfile qvgfile";
+    qWarning() << "usage: " << appName << "[-v2] svgfile qvgfile";
+    qWarning() << "       " << appName << "[-v2] [-j jobs] -o qvgdir svgdir|manifest";
+    qWarning() << "       " << appName << "[-v2] [-j jobs] -a archive svgdir|manifest";
+    qWarning() << "         -v2: writing QVG v2, that can't be read by older versions";
 }
 
 static QRectF viewBox( QSvgRenderer& renderer )
@@ -41,9 +56,308 @@ static QRectF viewBox( QSvgRenderer& renderer )
     return hasViewBox ? viewBox : QRectF( 0.0, 0.0, -1.0, -1.0 );
 }
 
+static bool convert( const QString& svgFile,
+    const QByteArray& svg, QskGraphic& graphic )
+{
+    QSvgRenderer renderer;
+    if ( !renderer.load( svg ) )
+        return false;
+
+    graphic.setViewBox( ::viewBox( renderer ) );
+
+    QPainter painter( &graphic );
+    renderer.render( &painter );
+    painter.end();
+
+    if ( graphic.commandTypes() & QskGraphic::RasterData )
+        qWarning() << svgFile << "contains non scalable parts.";
+
+    return true;
+}
+
+static bool convert( const QString& svgFile, QskGraphic& graphic )
+{
+    QFile file( svgFile );
+    if ( !file.open( QIODevice::ReadOnly ) )
+        return false;
+
+    return convert( svgFile, file.readAll(), graphic );
+}
+
+static inline bool hasText( const QByteArray& svg )
+{
+    // also matches textPath and textArea
+    return svg.contains( "<text" );
+}
+
+static bool writeQvg( const QskGraphic& graphic, QskGraphicIO::Version version,
+    const QString& qvgFile, QByteArray& qvg )
+{
+    if ( !QskGraphicIO::write( graphic, qvg, version ) )
+        return false;
+
+    if ( qvgFile.isEmpty() )
+        return true;
+
+    if ( !QDir().mkpath( QFileInfo( qvgFile ).absolutePath() ) )
+        return false;
+
+    QFile file( qvgFile );
+    return file.open( QIODevice::WriteOnly | QIODevice::Truncate )
+        && ( file.write( qvg ) == qvg.size() );
+}
+
+namespace
+{
+    struct Job
+    {
+        QString svgFile;
+        QString name; // relative path without suffix
+
+        QByteArray svg; // only for jobs deferred to the main thread
+        QByteArray qvg;
+    };
+
+    /*
+        Parsing and rendering a SVG happens in the worker threads.
+        Only SVGs with text parts need the font engine, what is
+        not safe outside of the GUI thread on all platforms. Those
+        are left to the main thread, that renders them and starts
+        another task with the graphic for serializing and writing.
+     */
+    class Task final : public QRunnable
+    {
+      public:
+        Task( Job* job, QskGraphicIO::Version version,
+                const QString& qvgDirectory, QAtomicInt* errors,
+                QAtomicInt* deferred )
+            : m_job( job )
+            , m_version( version )
+            , m_qvgDirectory( qvgDirectory )
+            , m_errors( errors )
+            , m_deferred( deferred )
+        {
+        }
+
+        Task( Job* job, const QskGraphic& graphic, QskGraphicIO::Version version,
+                const QString& qvgDirectory, QAtomicInt* errors )
+            : m_job( job )
+            , m_graphic( graphic )
+            , m_hasGraphic( true )
+            , m_version( version )
+            , m_qvgDirectory( qvgDirectory )
+            , m_errors( errors )
+            , m_deferred( nullptr )
+        {
+        }
+
+        void run() override
+        {
+            bool ok = m_hasGraphic;
+
+            if ( !m_hasGraphic )
+            {
+                QFile file( m_job->svgFile );
+                ok = file.open( QIODevice::ReadOnly );
+
+                if ( ok )
+                {
+                    const auto svg = file.readAll();
+
+                    if ( hasText( svg )
+                        && !QFontDatabase::supportsThreadedFontRendering() )
+                    {
+                        m_job->svg = svg;
+                        m_deferred->ref();
+
+                        return;
+                    }
+
+                    ok = convert( m_job->svgFile, svg, m_graphic );
+                }
+            }
+
+            if ( ok )
+            {
+                QString qvgFile;
+                if ( !m_qvgDirectory.isEmpty() )
+                    qvgFile = m_qvgDirectory + '/' + m_job->name + ".qvg";
+
+                ok = writeQvg( m_graphic, m_version, qvgFile, m_job->qvg );
+            }
+
+            if ( !ok )
+            {
+                qWarning() << "Can't convert" << m_job->svgFile;
+                m_errors->ref();
+            }
+        }
+
+      private:
+        Job* m_job;
+        QskGraphic m_graphic;
+        const bool m_hasGraphic = false;
+
+        const QskGraphicIO::Version m_version;
+        const QString m_qvgDirectory;
+
+        QAtomicInt* m_errors;
+        QAtomicInt* m_deferred;
+    };
+}
+
+static bool readJobs( const QString& input, QVector< Job >& jobs )
+{
+    const QFileInfo inputInfo( input );
+
+    if ( inputInfo.isDir() )
+    {
+        const QDir dir( input );
+
+        QDirIterator it( input, { QStringLiteral( "*.svg" ) },
+            QDir::Files, QDirIterator::Subdirectories );
+
+        while ( it.hasNext() )
+        {
+            const auto svgFile = it.next();
+
+            auto name = dir.relativeFilePath( svgFile );
+            name.chop( 4 );
+
+            jobs += Job { svgFile, name, QByteArray() };
+        }
+
+        return true;
+    }
+
+    // a manifest with one svg file per line, relative to the manifest
+
+    QFile file( input );
+    if ( !file.open( QIODevice::ReadOnly | QIODevice::Text ) )
+    {
+        qWarning() << "Can't open" << input;
+        return false;
+    }
+
+    const auto dir = inputInfo.absoluteDir();
+
+    while ( !file.atEnd() )
+    {
+        const auto line = QString::fromUtf8( file.readLine() ).trimmed();
+        if ( line.isEmpty() || line.startsWith( '#' ) )
+            continue;
+
+        auto name = line;
+        if ( name.endsWith( QStringLiteral( ".svg" ), Qt::CaseInsensitive ) )
+            name.chop( 4 );
+
+        jobs += Job { dir.absoluteFilePath( line ), name, QByteArray() };
+    }
+
+    return true;
+}
+
+static int runBatch( int jobCount, QskGraphicIO::Version version,
+    const QString& input, const QString& qvgDirectory, const QString& archiveFile )
+{
+    QVector< Job > jobs;
+    if ( !readJobs( input, jobs ) )
+        return -2;
+
+    /*
+        Each task writes to its own job, so we don't need any locking
+     */
+    QAtomicInt errors;
+
+    QThreadPool pool;
+    if ( jobCount > 0 )
+        pool.setMaxThreadCount( jobCount );
+
+    QAtomicInt deferred;
+
+    for ( auto& job : jobs )
+        pool.start( new Task( &job, version, qvgDirectory, &errors, &deferred ) );
+
+    pool.waitForDone();
+
+    if ( deferred.loadRelaxed() > 0 )
+    {
+        for ( auto& job : jobs )
+        {
+            if ( job.svg.isEmpty() )
+                continue;
+
+            QskGraphic graphic;
+
+            if ( convert( job.svgFile, job.svg, graphic ) )
+            {
+                pool.start( new Task( &job, graphic, version, qvgDirectory, &errors ) );
+            }
+            else
+            {
+                qWarning() << "Can't convert" << job.svgFile;
+                errors.ref();
+            }
+
+            job.svg.clear();
+        }
+
+        pool.waitForDone();
+    }
+
+    if ( errors.loadRelaxed() > 0 )
+        return -2;
+
+    if ( !archiveFile.isEmpty() )
+    {
+        QMap< QString, QByteArray > graphics;
+
+        for ( const auto& job : jobs )
+            graphics.insert( job.name, job.qvg );
+
+        if ( !QskGraphicArchive::write( graphics, archiveFile ) )
+            return -3;
+    }
+
+    return 0;
+}
+
 int main( int argc, char* argv[] )
 {
-    if ( argc != 3 )
+    int jobCount = 0;
+    auto version = QskGraphicIO::Version1;
+    QString qvgDirectory;
+    QString archiveFile;
+    QStringList args;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        const QByteArray arg( argv[i] );
+
+        if ( arg == "-v2" )
+        {
+            version = QskGraphicIO::Version2;
+        }
+        else if ( ( arg == "-j" || arg == "-o" || arg == "-a" ) && ( i + 1 < argc ) )
+        {
+            const QString value = QString::fromLocal8Bit( argv[++i] );
+
+            if ( arg == "-j" )
+                jobCount = value.toInt();
+            else if ( arg == "-o" )
+                qvgDirectory = value;
+            else
+                archiveFile = value;
+        }
+        else
+        {
+            args += QString::fromLocal8Bit( arg );
+        }
+    }
+
+    const bool isBatch = !( qvgDirectory.isEmpty() && archiveFile.isEmpty() );
+
+    if ( args.count() != ( isBatch ? 1 : 2 ) )
     {
         usage( argv[0] );
         return -1;
@@ -67,22 +381,14 @@ int main( int argc, char* argv[] )
     QGuiApplication app( argc, argv );
 #endif
 
-    QSvgRenderer renderer;
-    if ( !renderer.load( QString( argv[1] ) ) )
-        return -2;
+    if ( isBatch )
+        return runBatch( jobCount, version, args[0], qvgDirectory, archiveFile );
 
     QskGraphic graphic;
-    graphic.setViewBox( ::viewBox( renderer ) );
-
-    QPainter painter( &graphic );
-    renderer.render( &painter );
-    painter.end();
-
-    if ( graphic.commandTypes() & QskGraphic::RasterData )
-        qWarning() << argv[1] << "contains non scalable parts.";
+    if ( !convert( args[0], graphic ) )
+        return -2;
 
-    QskGraphicIO::write( graphic, argv[2] );
+    QskGraphicIO::write( graphic, args[1], version );
 
     return 0;
 }
-
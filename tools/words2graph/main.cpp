@@ -0,0 +1,45 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include <QskWordGraphTextPredictor.h>
+
+#include <QFile>
+#include <QDebug>
+
+static void usage( const char* appName )
+{
+    qWarning() << "usage: " << appName << "wordlist graphfile";
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( argc != 3 )
+    {
+        usage( argv[0] );
+        return -1;
+    }
+
+    QFile wordList( QString::fromLocal8Bit( argv[1] ) );
+    if ( !wordList.open( QIODevice::ReadOnly | QIODevice::Text ) )
+    {
+        qWarning() << "can't open" << wordList.fileName();
+        return -2;
+    }
+
+    QFile graph( QString::fromLocal8Bit( argv[2] ) );
+    if ( !graph.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+    {
+        qWarning() << "can't write" << graph.fileName();
+        return -2;
+    }
+
+    if ( !QskWordGraphTextPredictor::compile( &wordList, &graph ) )
+    {
+        graph.remove();
+        return -3;
+    }
+
+    return 0;
+}